@@ -0,0 +1,112 @@
+// Compares the iterative IK solvers over chain lengths 2-32.
+// Each chain is straight-ish bones of equal length; targets are spread over the
+// reachable disc with a fixed seed, and every solve starts from the rest pose.
+// Prints mean iterations, mean and worst error, reached share and mean time.
+
+#include "Riggle/IK_Solver.h"
+#include "Riggle/Rig.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Riggle;
+
+namespace {
+
+const float BoneLength = 20.0f;
+const int TargetCount = 200;
+const int MaxIterations = 200;
+const float Tolerance = 0.5f;
+
+std::vector<std::shared_ptr<Bone>> buildChain(Rig& rig, int length) {
+    std::vector<std::shared_ptr<Bone>> chain;
+    chain.push_back(rig.createBone("bone0", BoneLength));
+    for (int i = 1; i < length; ++i) {
+        auto bone = rig.createChildBone(chain.back(), "bone" + std::to_string(i), BoneLength);
+        chain.push_back(bone);
+    }
+
+    // Children start at the parent's tip, slightly bent so no solver starts at a singularity
+    for (size_t i = 0; i < chain.size(); ++i) {
+        Transform local = chain[i]->getLocalTransform();
+        local.position = i == 0 ? Vector2(0.0f, 0.0f) : Vector2(BoneLength, 0.0f);
+        local.rotation = 0.05f;
+        chain[i]->setLocalTransform(local);
+    }
+    return chain;
+}
+
+void runSolver(IKSolverType type, const std::vector<std::shared_ptr<Bone>>& chain, const std::vector<Vector2>& targets) {
+    IKSolveSettings settings;
+    settings.type = type;
+    settings.maxIterations = MaxIterations;
+    settings.tolerance = Tolerance;
+
+    IKSolver solver;
+    IKChainWorkspace workspace;
+    double iterations = 0.0;
+    double error = 0.0;
+    double milliseconds = 0.0;
+    float worstError = 0.0f;
+    int reached = 0;
+    for (const Vector2& target : targets) {
+        workspace.load(chain);
+        solver.solveWorkspace(workspace, target, settings);
+        const IKSolveStats& stats = solver.getLastStats();
+        iterations += stats.iterations;
+        error += stats.error;
+        milliseconds += stats.milliseconds;
+        worstError = std::max(worstError, stats.error);
+        reached += stats.reached ? 1 : 0;
+    }
+
+    const double count = static_cast<double>(targets.size());
+    std::cout << std::setw(6) << chain.size() << std::setw(9) << IKSolver::getSolverName(solver.getLastStats().type)
+              << std::fixed << std::setprecision(1) << std::setw(10) << iterations / count
+              << std::setprecision(3) << std::setw(11) << error / count << std::setw(11) << worstError
+              << std::setprecision(1) << std::setw(9) << 100.0 * reached / count << "%"
+              << std::setw(11) << 1000.0 * milliseconds / count << std::endl;
+}
+
+} // namespace
+
+int main() {
+    const int lengths[] = { 2, 3, 4, 6, 8, 12, 16, 24, 32 };
+    const IKSolverType solvers[] = { IKSolverType::CCD, IKSolverType::FABRIK, IKSolverType::DLS };
+
+    std::cout << "IK solvers: " << TargetCount << " targets per chain, tolerance " << Tolerance
+              << " px, at most " << MaxIterations << " iterations, bones " << BoneLength << " px" << std::endl;
+    std::cout << "Two-bone chains always take the closed-form TwoBone solve, whatever solver is asked for,"
+              << " so length 2 has a single TwoBone row." << std::endl << std::endl;
+    std::cout << " bones   solver iterations  mean err   worst err  reached   time (us)" << std::endl;
+
+    for (int length : lengths) {
+        Rig rig("Benchmark");
+        auto chain = buildChain(rig, length);
+
+        // Uniform over the disc out to 90% of full reach, away from the root
+        std::mt19937 random(1234u + static_cast<unsigned int>(length));
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        const float reach = BoneLength * static_cast<float>(length);
+        std::vector<Vector2> targets;
+        while (static_cast<int>(targets.size()) < TargetCount) {
+            float radius = reach * 0.9f * std::sqrt(unit(random));
+            float angle = unit(random) * 6.28318531f;
+            if (radius < BoneLength * 0.5f) continue;
+            targets.emplace_back(radius * std::cos(angle), radius * std::sin(angle));
+        }
+
+        if (length == 2) {
+            runSolver(IKSolverType::TwoBone, chain, targets);
+            continue;
+        }
+        for (IKSolverType type : solvers) {
+            runSolver(type, chain, targets);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,108 @@
+// Software rasteriser throughput against thread count.
+// Each frame is 1920x1080 with 400 overlapping, rotated 256x256 textured quads
+// (bilinear), the load of a busy character export at full HD. Thread counts run
+// from 1 up to the core count; every run must produce the same image.
+// Prints mean milliseconds per frame and speedup over one thread.
+
+#include "Riggle/SoftwareRasterizer.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace Riggle;
+
+namespace {
+
+const int FrameWidth = 1920;
+const int FrameHeight = 1080;
+const int QuadCount = 400;
+const int TextureSize = 256;
+const int Frames = 10;
+
+struct Quad {
+    Vector2 corners[4];
+};
+
+RasterImage makeTexture() {
+    RasterImage texture;
+    texture.resize(TextureSize, TextureSize);
+    for (int y = 0; y < TextureSize; ++y) {
+        for (int x = 0; x < TextureSize; ++x) {
+            std::uint8_t* p = &texture.pixels[(static_cast<size_t>(y) * TextureSize + x) * 4];
+            p[0] = static_cast<std::uint8_t>(x);
+            p[1] = static_cast<std::uint8_t>(y);
+            p[2] = static_cast<std::uint8_t>((x ^ y) & 0xFF);
+            p[3] = static_cast<std::uint8_t>(((x / 16 + y / 16) % 2) ? 255 : 160);
+        }
+    }
+    return texture;
+}
+
+std::vector<Quad> makeQuads() {
+    std::mt19937 random(42u);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<Quad> quads(QuadCount);
+    for (auto& quad : quads) {
+        const float cx = unit(random) * FrameWidth;
+        const float cy = unit(random) * FrameHeight;
+        const float angle = unit(random) * 6.28318531f;
+        const float half = TextureSize * (0.3f + 0.5f * unit(random));
+        const float c = std::cos(angle) * half;
+        const float s = std::sin(angle) * half;
+        quad.corners[0] = Vector2(cx - c + s, cy - s - c);
+        quad.corners[1] = Vector2(cx + c + s, cy + s - c);
+        quad.corners[2] = Vector2(cx + c - s, cy + s + c);
+        quad.corners[3] = Vector2(cx - c - s, cy - s + c);
+    }
+    return quads;
+}
+
+} // namespace
+
+int main() {
+    const RasterImage texture = makeTexture();
+    const std::vector<Quad> quads = makeQuads();
+    const unsigned int cores = std::max(1u, std::thread::hardware_concurrency());
+
+    std::cout << "Software rasteriser: " << FrameWidth << "x" << FrameHeight << ", " << QuadCount << " quads of "
+              << TextureSize << " px, " << Frames << " frames per run, " << cores << " core(s)" << std::endl;
+    std::cout << " threads  ms/frame  speedup  same image" << std::endl;
+
+    std::vector<std::uint8_t> reference;
+    double singleThread = 0.0;
+    for (unsigned int threads = 1; threads <= cores; threads = threads < cores ? std::min(threads * 2, cores) : threads + 1) {
+        SoftwareRasterizer rasterizer;
+        rasterizer.setThreadCount(threads);
+
+        double milliseconds = 0.0;
+        for (int frame = 0; frame <= Frames; ++frame) {
+            auto start = std::chrono::steady_clock::now();
+            rasterizer.begin(FrameWidth, FrameHeight, 0, 0, 0, 0);
+            for (const Quad& quad : quads) {
+                rasterizer.drawQuad(quad.corners, texture, RasterFilter::Bilinear);
+            }
+            rasterizer.finish();
+            // Frame 0 warms up the helper threads and caches
+            if (frame > 0) {
+                milliseconds += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            }
+        }
+        milliseconds /= Frames;
+
+        const std::vector<std::uint8_t>& pixels = rasterizer.getImage().pixels;
+        if (reference.empty()) {
+            reference = pixels;
+            singleThread = milliseconds;
+        }
+        std::cout << std::setw(8) << threads << std::fixed << std::setprecision(2) << std::setw(10) << milliseconds
+                  << std::setw(8) << singleThread / milliseconds << "x" << std::setw(12)
+                  << (pixels == reference ? "yes" : "NO") << std::endl;
+    }
+    return 0;
+}
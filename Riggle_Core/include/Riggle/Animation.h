@@ -11,6 +11,7 @@ namespace Riggle {
 
 class Bone;
 class Rig;
+class Retargeter;
 
 // Single keyframe for a bone's transform
 struct BoneKeyframe {
@@ -28,6 +29,7 @@ public:
     // Keyframe management
     void addKeyframe(float time, const Transform& transform);
     void removeKeyframe(float time);
+    void removeKeyframesInRange(float startTime, float endTime);
     void clearKeyframes();
     
     // Get interpolated transform at given time
@@ -78,11 +80,25 @@ public:
     // Get all tracks
     const std::map<std::string, std::unique_ptr<BoneTrack>>& getTracks() const { return m_tracks; }
 
+    // Changes whenever a track is created or removed; never repeats across animations,
+    // so cached BoneTrack pointers keyed on it can't outlive their track
+    unsigned int getTrackSetVersion() const { return m_trackSetVersion; }
+
     std::optional<Transform> getLastKeyframeTransform(const std::string& boneName);
 
 private:
     std::string m_name;
     std::map<std::string, std::unique_ptr<BoneTrack>> m_tracks;
+    unsigned int m_trackSetVersion;
+
+    // Tracks of bones evaluated at the rig's active LOD, for applyAtTime
+    struct BoneBinding {
+        const BoneTrack* track;
+        Bone* bone;
+    };
+    mutable std::vector<BoneBinding> m_boneBindings;
+    mutable unsigned int m_boundLayout = 0;
+    mutable unsigned int m_boundTrackSet = 0;
 };
 
 // Animation player for controlling playback
@@ -93,6 +109,10 @@ public:
     // Animation control
     void setAnimation(Animation* animation);
     Animation* getAnimation() const { return m_animation; }
+
+    // Play the animation through a bone map onto a different rig (nullptr = direct)
+    void setRetargeter(Retargeter* retargeter) { m_retargeter = retargeter; }
+    Retargeter* getRetargeter() const { return m_retargeter; }
     
     // Playback control
     void play();
@@ -114,6 +134,7 @@ public:
 
 private:
     Animation* m_animation;
+    Retargeter* m_retargeter;
     float m_currentTime;
     bool m_isPlaying;
     bool m_isLooping;
@@ -10,6 +10,34 @@ namespace Riggle {
 class Character;
 class Sprite;
 
+// Secondary motion settings - enabled bones are simulated by SpringBoneSolver
+struct SpringBoneParams {
+    bool enabled = false;
+    float stiffness = 0.2f;  // Pull back toward the animated pose per substep (0-1)
+    float damping = 0.1f;    // Velocity lost per substep (0-1)
+    float gravity = 0.0f;    // Downward acceleration, pixels/s^2
+};
+
+// Local rotation range (radians) respected by the IK solvers
+struct BoneRotationLimits {
+    bool enabled = false;
+    float minRotation = -3.14159265f;
+    float maxRotation = 3.14159265f;
+
+    // Angles are compared around the circle: a rotation a full turn away from the
+    // range counts as inside, anything else snaps to the nearer limit
+    float clamp(float rotation) const {
+        if (!enabled || (rotation >= minRotation && rotation <= maxRotation)) return rotation;
+
+        const float TWO_PI = 6.28318531f;
+        if (maxRotation - minRotation >= TWO_PI) return rotation;
+        float wrapped = minRotation + std::fmod(rotation - minRotation, TWO_PI);
+        if (wrapped < minRotation) wrapped += TWO_PI;
+        if (wrapped <= maxRotation) return wrapped;
+        return wrapped - maxRotation < minRotation + TWO_PI - wrapped ? maxRotation : minRotation;
+    }
+};
+
 class Bone : public std::enable_shared_from_this<Bone> {
 public:
     Bone(const std::string& name, float length);
@@ -17,7 +45,7 @@ public:
 
     // Basic properties
     const std::string& getName() const { return m_name; }
-    void setName(const std::string& name) { m_name = name; }
+    void setName(const std::string& name) { m_name = name; notifyRigSetupChanged(); } // Bindings are by name
     
     float getLength() const { return m_length; }
     void setLength(float length);
@@ -48,6 +76,22 @@ public:
     bool isRoot() const { return m_parent.expired(); }
     std::vector<std::shared_ptr<Bone>> getAllDescendants() const;
 
+    // Skeleton LOD: a collapsed bone is not evaluated on its own, it follows
+    // its surviving ancestor (proxy) through a pre-composed offset
+    void setLODProxy(std::shared_ptr<Bone> proxy, const Transform& offset);
+    void clearLODProxy();
+    bool isCollapsed() const { return !m_lodProxy.expired(); }
+    std::shared_ptr<Bone> getLODProxy() const { return m_lodProxy.lock(); }
+
+    // Spring bone secondary motion
+    const SpringBoneParams& getSpringParams() const { return m_springParams; }
+    void setSpringParams(const SpringBoneParams& params);
+    bool isSpringBone() const { return m_springParams.enabled; }
+
+    // IK joint limits
+    const BoneRotationLimits& getRotationLimits() const { return m_rotationLimits; }
+    void setRotationLimits(const BoneRotationLimits& limits) { m_rotationLimits = limits; }
+
     // Set the character this bone belongs to (for event notifications)
     void setCharacter(Character* character) { m_character = character; }
 
@@ -68,8 +112,16 @@ private:
     // Cached world transform
     mutable Transform m_worldTransform;
     mutable bool m_worldTransformDirty;
+
+    // Skeleton LOD collapse target
+    std::weak_ptr<Bone> m_lodProxy;
+    Transform m_lodOffset;
+
+    SpringBoneParams m_springParams;
+    BoneRotationLimits m_rotationLimits;
     
     void updateWorldTransform() const;
+    void notifyRigSetupChanged();
     void notifyCharacterOfTransformChange(const Transform& oldTransform, const Transform& newTransform);
 };
 
@@ -3,12 +3,18 @@
 #include "Sprite.h"
 #include "Rig.h"
 #include "IK_Solver.h"
+#include "SpringBoneSolver.h"
+#include "ConstraintSystem.h"
+#include "IKConstraintSystem.h"
+#include "ProceduralChannelSystem.h"
+#include "MotionCapture.h"
 #include "Animation.h"
 #include <vector>
 #include <memory>
 #include <string>
 #include <functional>
 #include <chrono>
+#include <unordered_map>
 
 
 namespace Riggle {
@@ -35,6 +41,11 @@ public:
     void clearTransformEventHandlers() {
         m_transformHandlers.clear();
     }
+    
+    // Transform events are queued (one per bone, keeping the first old transform)
+    // and delivered here - once per frame by the editor and after each IK solve
+    void flushTransformEvents();
+    size_t getPendingTransformEventCount() const { return m_pendingEvents.size(); }
 
     // Basic properties
     const std::string& getName() const { return m_name; }
@@ -58,7 +69,30 @@ public:
     // IK functionality
     IKSolver& getIKSolver() { return m_ikSolver; }
     const IKSolver& getIKSolver() const { return m_ikSolver; }
-    bool solveIK(std::shared_ptr<Bone> endEffector, const Vector2& targetPos, int chainLength);
+    bool solveIK(std::shared_ptr<Bone> endEffector, const Vector2& targetPos, int chainLength,
+                 const IKSolveSettings& settings = IKSolveSettings());
+    bool solveIKChain(const std::vector<std::shared_ptr<Bone>>& chain, const Vector2& targetPos,
+                      const IKSolveSettings& settings, const std::vector<float>* startRotations = nullptr);
+
+    // Procedural channels (added to the sampled pose, before IK and constraints)
+    ProceduralChannelSystem& getProceduralChannelSystem() { return m_proceduralChannels; }
+    const ProceduralChannelSystem& getProceduralChannelSystem() const { return m_proceduralChannels; }
+
+    // Rig IK constraints (run after animation sampling, before transform constraints)
+    IKConstraintSystem& getIKConstraintSystem() { return m_ikConstraintSystem; }
+    const IKConstraintSystem& getIKConstraintSystem() const { return m_ikConstraintSystem; }
+
+    // Transform constraints (run after animation sampling, before spring bones)
+    ConstraintSystem& getConstraintSystem() { return m_constraintSystem; }
+    const ConstraintSystem& getConstraintSystem() const { return m_constraintSystem; }
+
+    // Records manual bone edits against the playback time (performance capture)
+    MotionCapture& getMotionCapture() { return m_motionCapture; }
+    const MotionCapture& getMotionCapture() const { return m_motionCapture; }
+
+    // Spring bone secondary motion (runs after animation sampling)
+    SpringBoneSolver& getSpringBoneSolver() { return m_springSolver; }
+    const SpringBoneSolver& getSpringBoneSolver() const { return m_springSolver; }
 
      // Animation management
     void addAnimation(std::unique_ptr<Animation> animation);
@@ -71,6 +105,11 @@ public:
     AnimationPlayer* getAnimationPlayer() { return &m_animationPlayer; }
     const AnimationPlayer* getAnimationPlayer() const { return &m_animationPlayer; }
     
+    // Skeleton LOD selection (call once per frame with the character's on-screen scale)
+    void setLODLevel(int level);
+    int getLODLevel() const;
+    int updateLODForScreenScale(float screenScale);
+
     // Update system
     void update(float deltaTime);
 
@@ -82,7 +121,7 @@ public:
     void setAutoUpdate(bool autoUpdate) { m_autoUpdate = autoUpdate; }
     bool getAutoUpdate() const { return m_autoUpdate; }
 
-    void setManualBoneEditMode(bool enabled) { m_manualBoneEditMode = enabled; }
+    void setManualBoneEditMode(bool enabled);
     bool isInManualBoneEditMode() const { return m_manualBoneEditMode; }
 
 private:
@@ -91,7 +130,15 @@ private:
     std::unique_ptr<Rig> m_rig;
     std::vector<std::unique_ptr<Animation>> m_animations;
     std::vector<TransformEventHandler> m_transformHandlers;
+    std::vector<TransformEvent> m_pendingEvents;
+    std::unordered_map<std::string, size_t> m_pendingEventIndex; // Bone name -> m_pendingEvents slot
     IKSolver m_ikSolver;
+    ProceduralChannelSystem m_proceduralChannels;
+    float m_proceduralTime = 0.0f;
+    IKConstraintSystem m_ikConstraintSystem;
+    ConstraintSystem m_constraintSystem;
+    SpringBoneSolver m_springSolver;
+    MotionCapture m_motionCapture;
     AnimationPlayer m_animationPlayer;
     bool m_autoUpdate = true; // Auto-update deformations
     bool m_manualBoneEditMode = false;
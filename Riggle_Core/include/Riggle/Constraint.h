@@ -0,0 +1,50 @@
+#pragma once
+
+#include "Math.h"
+#include <string>
+
+namespace Riggle {
+
+enum class ConstraintType {
+    CopyRotation,   // Match the target's world rotation
+    LookAt,         // Aim the bone at the target's head
+    LimitRotation,  // Clamp the local rotation to a range
+    ParentSpace     // Follow the target as if parented to it
+};
+
+// Transform constraint owned by the rig, evaluated after animation sampling.
+// Bones are referenced by name so constraints survive save/load.
+struct BoneConstraint {
+    ConstraintType type = ConstraintType::CopyRotation;
+    std::string boneName;            // Constrained bone
+    std::string targetName;          // Unused by LimitRotation
+    bool enabled = true;
+    float influence = 1.0f;          // 0 = no effect, 1 = full effect
+    float rotationOffset = 0.0f;     // CopyRotation / LookAt, radians
+    float minRotation = -1.5708f;    // LimitRotation, local radians
+    float maxRotation = 1.5708f;
+    Transform targetOffset;          // ParentSpace: bone pose relative to the target
+};
+
+inline const char* constraintTypeToString(ConstraintType type) {
+    switch (type) {
+        case ConstraintType::CopyRotation: return "CopyRotation";
+        case ConstraintType::LookAt: return "LookAt";
+        case ConstraintType::LimitRotation: return "LimitRotation";
+        case ConstraintType::ParentSpace: return "ParentSpace";
+    }
+    return "CopyRotation";
+}
+
+inline bool constraintTypeFromString(const std::string& name, ConstraintType& type) {
+    for (ConstraintType candidate : {ConstraintType::CopyRotation, ConstraintType::LookAt,
+                                     ConstraintType::LimitRotation, ConstraintType::ParentSpace}) {
+        if (name == constraintTypeToString(candidate)) {
+            type = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace Riggle
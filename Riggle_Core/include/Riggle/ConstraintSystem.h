@@ -0,0 +1,108 @@
+#pragma once
+
+#include "Bone.h"
+#include "Constraint.h"
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Riggle {
+
+class Rig;
+
+// Evaluates transform constraints after animation sampling.
+// Bones and constraints form a dependency graph (parent -> child, target -> owner)
+// that is topologically sorted once per setup change into flat arrays. Evaluation
+// is then one linear pass; independent sub-graphs are evaluated in parallel on
+// WorkerPool::shared() when the rig is large enough to pay for the hand-off.
+class ConstraintSystem {
+public:
+    ConstraintSystem();
+
+    // Flat setup - parentIndex refers to an earlier added bone, -1 for a root
+    void clear();
+    int addBone(int parentIndex);
+    void addConstraint(const BoneConstraint& constraint, int boneIndex, int targetIndex);
+    bool finalize(); // False if constraints had to be dropped to break cycles
+
+    // Per-frame input/output in bone index space
+    void setLocalTransform(int index, const Transform& local);
+    const Transform& getLocalTransform(int index) const { return m_inputLocal[index]; }
+    Transform getConstrainedTransform(int index) const;
+    bool isConstrained(int index) const;
+    void evaluate();
+
+    // Convenience path for a live rig: reschedules on setup changes, evaluates, writes back
+    void update(Rig* rig);
+
+    // Local transform the live rig had before constraints were written back
+    bool getAnimatedLocalTransform(const std::string& boneName, Transform& transform) const;
+
+    // Pose of 'bone' relative to 'target', for setting up ParentSpace constraints
+    static Transform captureParentSpaceOffset(const Bone& bone, const Bone& target);
+
+    // Settings and stats
+    void setEnabled(bool enabled) { m_enabled = enabled; }
+    bool isEnabled() const { return m_enabled; }
+    void setParallelThreshold(size_t boneCount) { m_parallelThreshold = boneCount; }
+    size_t getScheduledBoneCount() const { return m_slotBone.size(); }
+    size_t getComponentCount() const { return m_components.size(); }
+    size_t getDroppedConstraintCount() const { return m_droppedConstraints; }
+    const std::string& getLastError() const { return m_lastError; }
+
+private:
+    // Constraint in schedule space
+    struct ConstraintOp {
+        ConstraintType type = ConstraintType::CopyRotation;
+        int targetSlot = -1;
+        float influence = 1.0f;
+        float rotationOffset = 0.0f;
+        float minRotation = 0.0f;
+        float maxRotation = 0.0f;
+        Transform targetOffset;
+        int source = -1;  // Index into the rig's constraint list (live path)
+    };
+
+    struct PendingConstraint {
+        BoneConstraint constraint;
+        int bone = -1;
+        int target = -1;
+        int source = -1;
+    };
+
+    bool m_enabled = true;
+    size_t m_parallelThreshold = 256;
+    size_t m_droppedConstraints = 0;
+    std::string m_lastError;
+
+    // Setup before finalize()
+    std::vector<int> m_boneParent;
+    std::vector<PendingConstraint> m_pending;
+
+    // Bone index space
+    std::vector<Transform> m_inputLocal;
+    std::vector<int> m_slotOf;  // -1 if the bone is not needed by any constraint
+
+    // Schedule space (topological order, grouped by component)
+    std::vector<int> m_slotBone;
+    std::vector<int> m_parentSlot;
+    std::vector<int> m_opBegin;  // Ops of slot i are [m_opBegin[i], m_opBegin[i + 1])
+    std::vector<ConstraintOp> m_ops;
+    std::vector<std::pair<int, int>> m_components;  // Slot ranges
+    std::vector<Transform> m_local;
+    std::vector<Transform> m_world;
+
+    // Live rig binding
+    const Rig* m_rig = nullptr;
+    unsigned int m_rigVersion = 0;
+    std::vector<std::weak_ptr<Bone>> m_bones;
+    std::vector<Transform> m_writtenLocal;  // What we wrote, to detect fresh animation input
+    std::vector<bool> m_hasWritten;
+
+    void rebuildFromRig(Rig* rig);
+    void refreshParams(const Rig& rig);
+    void evaluateRange(int begin, int end);
+};
+
+} // namespace Riggle
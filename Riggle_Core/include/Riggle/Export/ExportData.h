@@ -1,5 +1,10 @@
 #pragma once
 #include "../Math.h"
+#include "../SpriteMesh.h"
+#include "../Bone.h"
+#include "../Constraint.h"
+#include "../IK_Solver.h"
+#include "../ProceduralChannel.h"
 #include <string>
 #include <vector>
 
@@ -13,6 +18,11 @@ struct ExportBone {
     Transform worldTransform;   // World transform
     float length;
     std::vector<std::string> childNames;
+    SpringBoneParams spring;
+    BoneRotationLimits rotationLimits;
+    std::vector<BoneConstraint> constraints;  // Constraints owned by this bone
+    std::vector<IKConstraint> ikConstraints;  // IK constraints ending at this bone
+    std::vector<ProceduralChannel> proceduralChannels;  // Channels driving this bone
     
     ExportBone() : length(0.0f) {}
 };
@@ -26,6 +36,13 @@ struct ExportSprite {
     Vector2 bindOffset;
     float bindRotation;
     
+    // Optional mesh and multi-bone skin (empty if the sprite is a plain quad)
+    SpriteMesh mesh;
+    std::vector<std::string> skinBoneNames;
+    std::vector<Transform> skinBindPoses;
+    std::vector<Vector2> skinBindVertices;
+    std::vector<VertexWeights> skinWeights;
+    
     ExportSprite() : isVisible(true), bindRotation(0.0f) {}
 };
 
@@ -50,11 +67,20 @@ struct ExportAnimation {
     ExportAnimation() : duration(0.0f) {}
 };
 
+struct ExportLODLevel {
+    std::string name;
+    float screenScaleThreshold;
+    std::vector<std::string> collapsedBones;
+    
+    ExportLODLevel() : screenScaleThreshold(0.5f) {}
+};
+
 struct ExportProject {
     std::string name;
     std::vector<ExportBone> bones;
     std::vector<ExportSprite> sprites;
     std::vector<ExportAnimation> animations;
+    std::vector<ExportLODLevel> lodLevels;
     std::string version;
     
     ExportProject() : version("1.0") {}
@@ -14,6 +14,10 @@ public:
     static ExportAnimation extractAnimationData(const Animation& animation);
     static std::vector<ExportBone> extractBoneData(const Rig& rig);
     static std::vector<ExportSprite> extractSpriteData(const std::vector<std::shared_ptr<Sprite>>& sprites);
+    static std::vector<ExportLODLevel> extractLODData(const Rig& rig);
+    
+    // Replace poses written by spring bones and constraints with the authored ones
+    static void restoreAuthoredPose(const Character& character, std::vector<ExportBone>& bones);
 
 private:
     static ExportBone convertBone(std::shared_ptr<Bone> bone);
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "IK_Solver.h"
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Riggle {
+
+class Rig;
+
+// Solves the rig's IK constraints after animation sampling.
+// Constraints are grouped into waves once per setup change: a constraint whose
+// chain or target sits below another constraint's chain waits for a later wave.
+// Extra effectors on a constraint are solved in the same workspace with DLS.
+// Within a wave every chain is solved on its own workspace (no bone access),
+// so waves can run on the shared worker pool; results are written back serially.
+class IKConstraintSystem {
+public:
+    IKConstraintSystem();
+
+    void clear();
+    void update(Rig* rig);
+
+    // Solve several characters together, each wave fanned out over WorkerPool::shared()
+    static void updateAll(const std::vector<std::pair<IKConstraintSystem*, Rig*>>& systems);
+
+    // Local rotation the live rig had before IK was written back (for saving the authored pose)
+    bool getAnimatedLocalRotation(const std::string& boneName, float& rotation) const;
+
+    // Settings and stats
+    void setEnabled(bool enabled) { m_enabled = enabled; }
+    bool isEnabled() const { return m_enabled; }
+    void setParallelThreshold(size_t jobs) { m_parallelThreshold = jobs; }
+    size_t getActiveConstraintCount() const { return m_jobs.size(); }
+    int getWaveCount() const { return m_waveCount; }
+    double getLastSolveMilliseconds() const { return m_lastSolveMilliseconds; }
+
+private:
+    struct Job {
+        int source = -1;                            // Index into the rig's IK constraints
+        int wave = 0;
+        std::vector<std::shared_ptr<Bone>> chain;   // With extra effectors, the union of their chains
+        std::vector<std::shared_ptr<Bone>> roots;   // Chain bones whose parent is outside it
+        std::vector<float> inputRotations;          // Animated pose before write-back
+        std::vector<float> writtenRotations;        // What we wrote, to detect fresh animation input
+        bool hasWritten = false;
+        // Per end effector, the constraint's own first, then its extra effectors
+        std::vector<int> effectorJoints;            // Chain index of the bone whose tip is pulled
+        std::vector<std::shared_ptr<Bone>> targetBones; // Null uses the fixed target point
+        std::vector<Vector2> targets;
+        std::vector<float> weights;
+        IKSolveSettings settings;
+        IKChainWorkspace workspace;
+        IKSolver solver;                            // One per job so jobs can run concurrently
+    };
+
+    bool m_enabled = true;
+    size_t m_parallelThreshold = 4;
+    int m_waveCount = 0;
+    double m_lastSolveMilliseconds = 0.0;
+
+    const Rig* m_rig = nullptr;
+    unsigned int m_rigVersion = 0;
+    std::vector<std::unique_ptr<Job>> m_jobs;
+
+    bool prepare(Rig* rig);
+    void rebuildFromRig(Rig* rig);
+    void loadWave(int wave);
+    void commitWave(int wave);
+};
+
+} // namespace Riggle
@@ -1,8 +1,10 @@
 #pragma once
 #include "Math.h"
+#include "Bone.h"
 #include <vector>
 #include <string>
 #include <memory>
+#include <chrono>
 
 namespace Riggle {
     class Rig;
@@ -15,14 +17,142 @@ namespace Riggle {
         std::vector<std::shared_ptr<Bone>> chain;
     };
 
+    enum class IKSolverType {
+        CCD,     // Cyclic coordinate descent - rotates one joint at a time
+        FABRIK,  // Forward and backward reaching - moves joint positions, fewer iterations
+        TwoBone, // Closed form, used automatically for two-bone chains
+        DLS      // Damped least squares Jacobian - all joints at once, smooth near singularities, multiple effectors
+    };
+
+    struct IKSolveSettings {
+        IKSolverType type = IKSolverType::CCD;
+        int maxIterations = 50;
+        float tolerance = 1.0f;  // Distance from target counted as reached, pixels
+        int bendDirection = 0;   // Two-bone chains: 0 keeps the current bend side, +1/-1 forces it
+        float damping = 5.0f;    // DLS damping (lambda), pixels - higher is smoother but slower
+        float maxMilliseconds = 0.0f; // Stop iterating after this long (interactive use), 0 = no limit
+    };
+
+    // Another bone pulled by the same solve as a constraint's end effector
+    struct IKExtraEffector {
+        std::string endEffector;
+        std::string targetBone;      // Follows this bone's head when set
+        Vector2 targetPosition;      // World-space target otherwise
+        float weight = 1.0f;         // Pull relative to the main end effector
+    };
+
+    // Persistent IK setup stored on the rig and solved every frame after animation
+    struct IKConstraint {
+        std::string endEffector;
+        std::string targetBone;      // Follows this bone's head when set
+        Vector2 targetPosition;      // World-space target otherwise
+        int chainLength = 2;
+        IKSolveSettings settings;
+        bool enabled = true;
+        // Each walks up chainLength bones too; shared bones are solved once for all
+        // effectors, so a constraint with any is always solved with DLS
+        std::vector<IKExtraEffector> extraEffectors;
+    };
+
+    // One end effector of a multi-effector DLS solve
+    struct IKEffectorTarget {
+        std::shared_ptr<Bone> bone;
+        Vector2 target;
+        float weight = 1.0f;
+    };
+
+    // Filled by every solve, for comparing solvers on a chain
+    struct IKSolveStats {
+        IKSolverType type = IKSolverType::CCD;
+        int chainLength = 0;
+        int iterations = 0;
+        float error = 0.0f;         // Final end-effector distance to target
+        double milliseconds = 0.0;
+        bool reached = false;
+    };
+
+    // Chain-local copy of the transforms an IK solve touches. Solvers rotate
+    // joints here and only the rest of the chain is recomputed; the rig is
+    // written once at the end, so cost depends on chain length, not rig size.
+    // Bones must be parent-first: a chain, or a small tree for several effectors.
+    class IKChainWorkspace {
+    public:
+        // startRotations optionally replaces the bones' current local rotations
+        void load(const std::vector<std::shared_ptr<Bone>>& bones, const std::vector<float>* startRotations = nullptr);
+        void writeBack();
+
+        // Load from plain transforms (e.g. export data) - parents index into this list, -1 uses parentWorlds
+        void loadTransforms(const std::vector<int>& parents, const std::vector<Transform>& locals,
+                            const std::vector<Transform>& parentWorlds, const std::vector<BoneRotationLimits>& limits);
+
+        size_t size() const { return m_local.size(); }
+        int getParentIndex(size_t index) const { return m_parent[index]; }
+        const Transform& getLocalTransform(size_t index) const { return m_local[index]; }
+        const Transform& getWorldTransform(size_t index) const { return m_world[index]; }
+        Vector2 getJointPosition(size_t index) const { return m_world[index].position; }
+        Vector2 getTipPosition(size_t index) const;
+        Vector2 getEndPosition() const { return m_world.empty() ? Vector2(0, 0) : getTipPosition(m_world.size() - 1); }
+
+        // Modify local rotations (clamped to bone limits) and refresh world transforms below
+        void rotateJoint(size_t index, float deltaAngle);
+        void setJointRotation(size_t index, float localRotation);
+        void rotateAllJoints(const float* deltaAngles);
+
+    private:
+        std::vector<std::shared_ptr<Bone>> m_bones;
+        std::vector<int> m_parent;                // Workspace index, -1 if above the workspace
+        std::vector<Transform> m_local;
+        std::vector<Transform> m_world;
+        std::vector<Transform> m_parentWorld;     // World transform above each workspace root
+        std::vector<BoneRotationLimits> m_limits;
+        std::vector<float> m_originalRotation;
+
+        void updateFrom(size_t index);
+    };
+
     class IKSolver {
     public:
-        // Main solving function
+        // Main solving functions
+        bool solve(Rig* rig, std::shared_ptr<Bone> endEffector, const Vector2& targetPos, int chainLength,
+                   const IKSolveSettings& settings = IKSolveSettings());
         bool solveCCD(Rig* rig, std::shared_ptr<Bone> endEffector, const Vector2& targetPos, int chainLength, int maxIterations = 50, float tolerance = 1.0f);
+        bool solveFABRIK(Rig* rig, std::shared_ptr<Bone> endEffector, const Vector2& targetPos, int chainLength, int maxIterations = 20, float tolerance = 1.0f);
+        bool solveTwoBone(Rig* rig, std::shared_ptr<Bone> endEffector, const Vector2& targetPos, int bendDirection = 0);
+        
+        // Solve an already validated chain (root first), e.g. one cached for a whole drag.
+        // startRotations optionally warm-starts from a previous solution instead of the bones' pose
+        bool solveChain(Rig* rig, const std::vector<std::shared_ptr<Bone>>& chain, const Vector2& targetPos,
+                        const IKSolveSettings& settings = IKSolveSettings(),
+                        const std::vector<float>* startRotations = nullptr);
+        
+        // Several end effectors sharing bones (e.g. two hands on one spine), solved together
+        // with DLS. Each effector's chain is chainLength bones long
+        bool solveDLS(Rig* rig, const std::vector<IKEffectorTarget>& effectors, int chainLength,
+                      const IKSolveSettings& settings = IKSolveSettings());
+        
+        static constexpr int MaxDLSJoints = 64;
+        static constexpr int MaxDLSEffectors = 4;
+        
+        // Solve an already loaded workspace without touching any bones (safe to run
+        // on worker threads with one IKSolver per job)
+        bool solveWorkspace(IKChainWorkspace& workspace, const Vector2& targetPos,
+                            const IKSolveSettings& settings = IKSolveSettings());
+        
+        // Multi-effector DLS on a loaded workspace; effectorJoints index the bone whose tip follows each target
+        bool solveWorkspaceDLS(IKChainWorkspace& workspace, const std::vector<int>& effectorJoints,
+                               const std::vector<Vector2>& targets, const std::vector<float>& weights,
+                               const IKSolveSettings& settings = IKSolveSettings());
+        
+        const IKSolveStats& getLastStats() const { return m_lastStats; }
+        static const char* getSolverName(IKSolverType type);
+        static bool getSolverType(const std::string& name, IKSolverType& type);
         
         // Chain management
         std::vector<std::shared_ptr<Bone>> buildChain(std::shared_ptr<Bone> endEffector, int chainLength);
         IKChainValidation validateChain(std::shared_ptr<Bone> endEffector, int chainLength);
+        // Union of the effectors' chains (parent-first) and the index of each effector in it
+        bool buildEffectorTree(const std::vector<std::shared_ptr<Bone>>& effectors, int chainLength,
+                               std::vector<std::shared_ptr<Bone>>& bones, std::vector<int>& effectorJoints);
         
         // Utility functions
         Vector2 getBoneWorldPosition(std::shared_ptr<Bone> bone);
@@ -30,7 +160,24 @@ namespace Riggle {
         float getAngleBetweenVectors(const Vector2& from, const Vector2& to);
         
     private:
+        IKChainWorkspace m_workspace;  // Reused between solves
+        IKSolveStats m_lastStats;
+        std::vector<Vector2> m_joints;       // FABRIK joint positions (chain heads + end tip)
+        std::vector<float> m_segmentLengths;
+        std::chrono::steady_clock::time_point m_deadline;
+        bool m_hasDeadline = false;
+
+        void startBudget(const IKSolveSettings& settings);
+        bool outOfTime() const { return m_hasDeadline && std::chrono::steady_clock::now() >= m_deadline; }
+
+        // Solve on the loaded workspace, returning the iterations used
+        int iterateCCD(IKChainWorkspace& workspace, const Vector2& targetPos, int maxIterations, float tolerance);
+        int iterateFABRIK(IKChainWorkspace& workspace, const Vector2& targetPos, int maxIterations, float tolerance);
+        int iterateDLS(IKChainWorkspace& workspace, const int* effectorJoints, const Vector2* targets, const float* weights,
+                       int effectorCount, int maxIterations, float tolerance, float damping);
+        void solveTwoBoneAnalytic(IKChainWorkspace& workspace, const Vector2& targetPos, int bendDirection);
+        void alignSegment(IKChainWorkspace& workspace, size_t index, const Vector2& desiredEnd);
+
         int getDistanceToRoot(std::shared_ptr<Bone> bone);
-        void applyRotationToBone(std::shared_ptr<Bone> bone, float deltaAngle);
     };
 }
\ No newline at end of file
@@ -64,4 +64,124 @@ struct Transform {
     void setScaleY(float sy) { scale.y = sy; }
 };
 
+// Combine a parent's world transform with a child's local transform.
+// Same rules as the bone hierarchy: rotate local position, apply parent scale, add parent position.
+inline Transform combineTransforms(const Transform& parent, const Transform& local) {
+    float cosRot = std::cos(parent.rotation);
+    float sinRot = std::sin(parent.rotation);
+
+    Transform result;
+    result.position.x = parent.position.x + (local.position.x * cosRot - local.position.y * sinRot) * parent.scale.x;
+    result.position.y = parent.position.y + (local.position.x * sinRot + local.position.y * cosRot) * parent.scale.y;
+    result.rotation = parent.rotation + local.rotation;
+    result.scale.x = parent.scale.x * local.scale.x;
+    result.scale.y = parent.scale.y * local.scale.y;
+    result.length = local.length; // Length doesn't inherit
+    return result;
+}
+
+// Inverse of combineTransforms: the local transform that places 'world' under 'parent'
+inline Transform relativeTransform(const Transform& parent, const Transform& world) {
+    float cosRot = std::cos(parent.rotation);
+    float sinRot = std::sin(parent.rotation);
+    float scaleX = std::abs(parent.scale.x) > 1e-6f ? parent.scale.x : 1.0f;
+    float scaleY = std::abs(parent.scale.y) > 1e-6f ? parent.scale.y : 1.0f;
+    float dx = (world.position.x - parent.position.x) / scaleX;
+    float dy = (world.position.y - parent.position.y) / scaleY;
+
+    Transform result;
+    result.position.x = dx * cosRot + dy * sinRot;
+    result.position.y = -dx * sinRot + dy * cosRot;
+    result.rotation = world.rotation - parent.rotation;
+    result.scale.x = world.scale.x / scaleX;
+    result.scale.y = world.scale.y / scaleY;
+    result.length = world.length;
+    return result;
+}
+
+// Keyframe blend: linear position, scale and length, shortest-path rotation
+inline Transform interpolateTransform(const Transform& a, const Transform& b, float t) {
+    Transform result;
+    result.position.x = a.position.x + (b.position.x - a.position.x) * t;
+    result.position.y = a.position.y + (b.position.y - a.position.y) * t;
+    result.scale.x = a.scale.x + (b.scale.x - a.scale.x) * t;
+    result.scale.y = a.scale.y + (b.scale.y - a.scale.y) * t;
+    result.length = a.length + (b.length - a.length) * t;
+
+    // Normalize angle difference to [-π, π]
+    float angleDiff = b.rotation - a.rotation;
+    const float PI = 3.14159f;
+    while (angleDiff > PI) angleDiff -= 2.0f * PI;
+    while (angleDiff < -PI) angleDiff += 2.0f * PI;
+
+    result.rotation = a.rotation + angleDiff * t;
+    return result;
+}
+
+// World transform of a sprite bound to a bone: the bind offset is rotated and
+// scaled by the bone, the bind rotation added, and the sprite's own scale kept
+inline Transform bindTransform(const Transform& boneWorld, const Vector2& bindOffset, float bindRotation,
+                               const Transform& spriteLocal) {
+    float cosRot = std::cos(boneWorld.rotation);
+    float sinRot = std::sin(boneWorld.rotation);
+
+    Transform result;
+    result.position.x = boneWorld.position.x + (bindOffset.x * cosRot - bindOffset.y * sinRot) * boneWorld.scale.x;
+    result.position.y = boneWorld.position.y + (bindOffset.x * sinRot + bindOffset.y * cosRot) * boneWorld.scale.y;
+    result.rotation = boneWorld.rotation + bindRotation;
+    result.scale.x = boneWorld.scale.x * spriteLocal.scale.x;
+    result.scale.y = boneWorld.scale.y * spriteLocal.scale.y;
+    result.length = spriteLocal.length;
+    return result;
+}
+
+// 2D affine matrix [a b tx; c d ty], used for skinning
+struct Affine2 {
+    float a = 1.0f, b = 0.0f, tx = 0.0f;
+    float c = 0.0f, d = 1.0f, ty = 0.0f;
+
+    // Bone convention: world = position + scale * (R * p)
+    static Affine2 fromTransform(const Transform& t) {
+        float cosRot = std::cos(t.rotation);
+        float sinRot = std::sin(t.rotation);
+        Affine2 m;
+        m.a = cosRot * t.scale.x; m.b = -sinRot * t.scale.x; m.tx = t.position.x;
+        m.c = sinRot * t.scale.y; m.d = cosRot * t.scale.y;  m.ty = t.position.y;
+        return m;
+    }
+
+    // Sprite convention (translate * rotate * scale): world = position + R * (scale * p)
+    static Affine2 fromTRS(const Transform& t) {
+        float cosRot = std::cos(t.rotation);
+        float sinRot = std::sin(t.rotation);
+        Affine2 m;
+        m.a = cosRot * t.scale.x; m.b = -sinRot * t.scale.y; m.tx = t.position.x;
+        m.c = sinRot * t.scale.x; m.d = cosRot * t.scale.y;  m.ty = t.position.y;
+        return m;
+    }
+
+    Affine2 operator*(const Affine2& o) const {
+        Affine2 m;
+        m.a = a * o.a + b * o.c;  m.b = a * o.b + b * o.d;  m.tx = a * o.tx + b * o.ty + tx;
+        m.c = c * o.a + d * o.c;  m.d = c * o.b + d * o.d;  m.ty = c * o.tx + d * o.ty + ty;
+        return m;
+    }
+
+    Affine2 inverse() const {
+        float det = a * d - b * c;
+        if (std::abs(det) < 1e-8f) return Affine2();
+        float invDet = 1.0f / det;
+        Affine2 m;
+        m.a = d * invDet;   m.b = -b * invDet;
+        m.c = -c * invDet;  m.d = a * invDet;
+        m.tx = -(m.a * tx + m.b * ty);
+        m.ty = -(m.c * tx + m.d * ty);
+        return m;
+    }
+
+    Vector2 apply(const Vector2& p) const {
+        return Vector2(a * p.x + b * p.y + tx, c * p.x + d * p.y + ty);
+    }
+};
+
 } // namespace Riggle
\ No newline at end of file
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "SpriteMesh.h"
+#include <vector>
+
+namespace Riggle {
+
+struct MeshGeneratorSettings {
+    unsigned char alphaThreshold = 8;  // Pixels at or below this alpha count as empty
+    int maxVertices = 32;              // Outline vertex budget
+    float padding = 2.0f;              // Grow the outline so filtered edges aren't clipped
+};
+
+// Builds a tight sprite mesh from a texture's alpha channel:
+// trace contour -> simplify to the vertex budget -> expand -> ear-clip triangulate.
+// Every opaque pixel ends up inside the mesh; when the simplified outline can't
+// manage that, the convex hull is used, as it is when the opaque area is split
+// into several pieces, and the full quad as a last resort.
+class MeshGenerator {
+public:
+    // pixels are RGBA8, row-major, width * height * 4 bytes
+    static SpriteMesh generateFromAlpha(const unsigned char* pixels, unsigned int width, unsigned int height,
+                                        const MeshGeneratorSettings& settings = MeshGeneratorSettings());
+
+    // Mesh area relative to the full texture quad (1.0 = no savings)
+    static float computeCoverage(const SpriteMesh& mesh, float width, float height);
+
+private:
+    static std::vector<Vector2> traceContour(const std::vector<unsigned char>& mask, int width, int height,
+                                             int startX, int startY);
+    static std::vector<Vector2> convexHull(std::vector<Vector2> points);
+    static std::vector<Vector2> simplify(const std::vector<Vector2>& contour, int maxVertices, float& outEpsilon);
+    static std::vector<Vector2> expand(const std::vector<Vector2>& polygon, float distance, float width, float height);
+    static bool isSimplePolygon(const std::vector<Vector2>& polygon);
+    static bool triangulate(const std::vector<Vector2>& polygon, std::vector<unsigned int>& indices);
+    static SpriteMesh buildMesh(const std::vector<Vector2>& polygon, const std::vector<unsigned int>& indices,
+                                float width, float height);
+};
+
+} // namespace Riggle
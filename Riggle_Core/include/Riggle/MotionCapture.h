@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Math.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Riggle {
+
+class Rig;
+class Animation;
+
+// Error bounds for turning captured samples into keyframes. A sample is dropped
+// when the keys around it reproduce it within all three tolerances.
+struct MotionCaptureSettings {
+    float positionTolerance = 0.5f;   // Pixels
+    float rotationTolerance = 0.01f;  // Radians
+    float scaleTolerance = 0.01f;
+};
+
+// Records bone transforms at full event rate while the timeline plays.
+// Samples go into a ring buffer allocated up front, so recording never
+// allocates or sorts; all the work happens in bakeInto() after recording.
+class MotionCapture {
+public:
+    explicit MotionCapture(size_t capacity = 65536);
+
+    // Samples kept per take; the buffer is allocated by begin(), only while not recording
+    void setCapacity(size_t capacity);
+    size_t getCapacity() const { return m_capacity; }
+
+    bool begin(const Rig& rig);
+    void record(const std::string& boneName, float time, const Transform& transform);
+    void end();
+    bool isRecording() const { return m_recording; }
+
+    // Replaces keys of captured bones inside the captured time range; returns keys written
+    size_t bakeInto(Animation& animation, const MotionCaptureSettings& settings = MotionCaptureSettings());
+
+    // Stats for the last recording
+    size_t getSampleCount() const { return m_count; }
+    size_t getDroppedSampleCount() const { return m_dropped; }  // Overwritten once the buffer was full
+    size_t getLastKeyCount() const { return m_lastKeyCount; }
+
+private:
+    struct Sample {
+        int bone = -1;
+        float time = 0.0f;
+        Transform transform;
+    };
+
+    size_t m_capacity = 0;
+    std::vector<Sample> m_samples;  // Ring buffer
+    size_t m_head = 0;               // Next write slot
+    size_t m_count = 0;
+    size_t m_dropped = 0;
+    size_t m_lastKeyCount = 0;
+    bool m_recording = false;
+
+    std::vector<std::string> m_boneNames;
+    std::unordered_map<std::string, int> m_boneIndex;
+
+    // Indices into 'samples' that keep the curve within tolerance (Ramer-Douglas-Peucker)
+    static void decimate(const std::vector<Sample>& samples, const MotionCaptureSettings& settings,
+                         std::vector<size_t>& keep);
+};
+
+} // namespace Riggle
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Math.h"
+#include "Export/ExportData.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Riggle {
+
+// Poses an exported skeleton without building a Rig. compile() turns the
+// name-linked ExportBone/ExportSprite lists into flat index arrays once; after
+// that, sampling an animation and updating world transforms do no string
+// lookups and no allocations. Keyframe interpolation, the bone hierarchy and
+// sprite binding use the same math as the live rig, so exported frames match
+// the viewport.
+class PoseEvaluator {
+public:
+    PoseEvaluator() = default;
+
+    // Setup (once per export)
+    void compile(const std::vector<ExportBone>& bones, const std::vector<ExportSprite>& sprites);
+    void bindAnimation(const ExportAnimation& animation);  // Keyframes must outlive the evaluator's use
+    void clear();
+
+    // Per frame
+    void resetToRest();
+    void sampleAnimation(float time);                         // Rest pose, then every bound track
+    bool sampleTrack(int bone, float time, Transform& local); // False if the bone has no track
+    void updateWorldTransforms();
+
+    // Bones, in the order given to compile()
+    int getBoneCount() const { return static_cast<int>(m_parents.size()); }
+    int findBone(const std::string& name) const;  // -1 if missing; meant for setup, not per frame
+    int getParent(int bone) const { return m_parents[bone]; }
+    float getBoneLength(int bone) const { return m_lengths[bone]; }
+    const Transform& getLocalTransform(int bone) const { return m_locals[bone]; }
+    void setLocalTransform(int bone, const Transform& local) { m_locals[bone] = local; }
+    const Transform& getWorldTransform(int bone) const { return m_worlds[bone]; }
+
+    // Sprites, in the order given to compile()
+    int getSpriteBone(int sprite) const { return m_sprites[sprite].bone; }  // -1 if unbound
+    const std::vector<int>& getSpriteSkinBones(int sprite) const { return m_sprites[sprite].skinBones; }  // Empty if any is missing
+    Transform getSpriteWorldTransform(int sprite) const;
+
+private:
+    struct Track {
+        const ExportKeyframe* keyframes = nullptr;
+        int count = 0;
+        int cursor = 1;  // Segment [cursor - 1, cursor] used last; frames usually advance by one
+    };
+
+    struct CompiledSprite {
+        Transform local;
+        Vector2 bindOffset;
+        float bindRotation = 0.0f;
+        int bone = -1;
+        std::vector<int> skinBones;
+    };
+
+    std::unordered_map<std::string, int> m_boneIndex;
+    std::vector<int> m_parents;
+    std::vector<int> m_order;  // Parents before children
+    std::vector<float> m_lengths;
+    std::vector<Transform> m_restLocals;
+    std::vector<Transform> m_locals;
+    std::vector<Transform> m_worlds;
+
+    std::vector<Track> m_tracks;
+    std::vector<int> m_boneTracks;  // Track index per bone, -1 if not animated
+
+    std::vector<CompiledSprite> m_sprites;
+
+    Transform sample(Track& track, float time) const;
+};
+
+} // namespace Riggle
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <string>
+
+namespace Riggle {
+
+enum class ProceduralGenerator {
+    Sine,           // amplitude * sin(2*pi*frequency*t + phase)
+    Noise,          // Smoothed value noise, reproducible from the seed
+    FollowThrough   // Lags behind the source bone's motion on the same channel
+};
+
+enum class ProceduralTarget {
+    PositionX,
+    PositionY,
+    Rotation,
+    ScaleX,
+    ScaleY
+};
+
+// Procedural motion owned by the rig, added on top of the keyframed pose after
+// animation sampling. Generators are pure functions of time, so a given time
+// and seed always produce the same pose.
+struct ProceduralChannel {
+    ProceduralGenerator generator = ProceduralGenerator::Sine;
+    ProceduralTarget target = ProceduralTarget::Rotation;
+    std::string boneName;            // Driven bone
+    std::string sourceName;          // FollowThrough: followed bone (empty = parent)
+    bool enabled = true;
+    float amplitude = 0.05f;         // Channel units; FollowThrough: gain on the lagged motion
+    float frequency = 0.5f;          // Sine: Hz, Noise: lattice points per second
+    float phase = 0.0f;              // Sine, radians
+    unsigned int seed = 1;           // Noise
+    int octaves = 2;                 // Noise
+    float delay = 0.15f;             // FollowThrough, seconds
+};
+
+inline const char* proceduralGeneratorToString(ProceduralGenerator generator) {
+    switch (generator) {
+        case ProceduralGenerator::Sine: return "Sine";
+        case ProceduralGenerator::Noise: return "Noise";
+        case ProceduralGenerator::FollowThrough: return "FollowThrough";
+    }
+    return "Sine";
+}
+
+inline bool proceduralGeneratorFromString(const std::string& name, ProceduralGenerator& generator) {
+    for (ProceduralGenerator candidate : {ProceduralGenerator::Sine, ProceduralGenerator::Noise,
+                                          ProceduralGenerator::FollowThrough}) {
+        if (name == proceduralGeneratorToString(candidate)) {
+            generator = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+inline const char* proceduralTargetToString(ProceduralTarget target) {
+    switch (target) {
+        case ProceduralTarget::PositionX: return "PositionX";
+        case ProceduralTarget::PositionY: return "PositionY";
+        case ProceduralTarget::Rotation: return "Rotation";
+        case ProceduralTarget::ScaleX: return "ScaleX";
+        case ProceduralTarget::ScaleY: return "ScaleY";
+    }
+    return "Rotation";
+}
+
+inline bool proceduralTargetFromString(const std::string& name, ProceduralTarget& target) {
+    for (ProceduralTarget candidate : {ProceduralTarget::PositionX, ProceduralTarget::PositionY,
+                                       ProceduralTarget::Rotation, ProceduralTarget::ScaleX,
+                                       ProceduralTarget::ScaleY}) {
+        if (name == proceduralTargetToString(candidate)) {
+            target = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace Riggle
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "Bone.h"
+#include "ProceduralChannel.h"
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Riggle {
+
+class Rig;
+class Animation;
+class BoneTrack;
+
+// Adds procedural channels on top of the keyframed pose after animation sampling.
+// Channels are split by generator into flat parameter arrays once per setup
+// change; evaluation runs one straight loop per generator over every channel,
+// then scatters the results into per-bone offsets that are added to the pose.
+class ProceduralChannelSystem {
+public:
+    // Keyframed local pose of 'bone' at 'time' - FollowThrough samples its source through this
+    using KeySampler = std::function<bool(int bone, float time, Transform& local)>;
+
+    // One character of a scene for updateAll()
+    struct Entry {
+        ProceduralChannelSystem* system = nullptr;
+        Rig* rig = nullptr;
+        const Animation* animation = nullptr;  // Source of FollowThrough motion, may be null
+        float time = 0.0f;
+        float loopDuration = 0.0f;              // Wraps delayed samples, 0 = no wrap
+    };
+
+    ProceduralChannelSystem();
+
+    // Flat setup - parentIndex refers to an earlier added bone, -1 for a root
+    void clear();
+    int addBone(int parentIndex);
+    void addChannel(const ProceduralChannel& channel, int boneIndex, int sourceIndex); // sourceIndex -1 = parent
+    void finalize();
+
+    // Per-frame evaluation in bone index space
+    void evaluate(float time, float loopDuration, const KeySampler& sampler);
+    bool isDriven(int index) const;
+    void applyOffsets(int index, Transform& local) const;
+
+    // Convenience path for a live rig: reschedules on setup changes, evaluates, writes back
+    void update(Rig* rig, float time, const Animation* animation = nullptr, float loopDuration = 0.0f);
+
+    // Evaluate every character of a scene in one pass
+    static void updateAll(const std::vector<Entry>& entries);
+
+    // Call once the rest of the frame (IK, constraints, springs) has posed the rig, so
+    // their writes to a driven bone are not taken as new input and offset again next frame
+    void endFrame(Rig* rig);
+
+    // Local transform the live rig had before channels were added (for saving the authored pose)
+    bool getAnimatedLocalTransform(const std::string& boneName, Transform& transform) const;
+
+    // Settings and stats
+    void setEnabled(bool enabled) { m_enabled = enabled; }
+    bool isEnabled() const { return m_enabled; }
+    size_t getActiveChannelCount() const { return m_sineOut.size() + m_noiseOut.size() + m_followOut.size(); }
+    size_t getDrivenBoneCount() const { return m_slotBone.size(); }
+
+private:
+    struct PendingChannel {
+        ProceduralChannel channel;
+        int bone = -1;
+        int sourceBone = -1;
+        int source = -1;  // Index into the rig's channel list (live path)
+    };
+
+    bool m_enabled = true;
+
+    // Setup before finalize()
+    std::vector<int> m_boneParent;
+    std::vector<PendingChannel> m_pending;
+
+    // Bone index space
+    std::vector<int> m_slotOf;      // -1 if no channel drives the bone
+    std::vector<int> m_slotBone;
+    std::vector<float> m_offsets;   // One per ProceduralTarget per slot
+
+    // Generator parameters, one array per field; *Out is the offset written
+    std::vector<int> m_sineOut;
+    std::vector<float> m_sineAmplitude;
+    std::vector<float> m_sineFrequency;
+    std::vector<float> m_sinePhase;
+    std::vector<float> m_sineValue;
+    std::vector<int> m_sineSource;
+
+    std::vector<int> m_noiseOut;
+    std::vector<float> m_noiseAmplitude;
+    std::vector<float> m_noiseFrequency;
+    std::vector<unsigned int> m_noiseSeed;
+    std::vector<int> m_noiseOctaves;
+    std::vector<float> m_noiseValue;
+    std::vector<int> m_noiseSource;
+
+    std::vector<int> m_followOut;
+    std::vector<float> m_followGain;
+    std::vector<float> m_followDelay;
+    std::vector<int> m_followBone;      // Bone whose motion is followed
+    std::vector<int> m_followTarget;    // ProceduralTarget as int
+    std::vector<int> m_followLinkBegin; // Links of i are [m_followLinkBegin[i], m_followLinkBegin[i + 1])
+    std::vector<int> m_followLinks;     // Sine index, or ~noise index
+    std::vector<float> m_followValue;
+    std::vector<int> m_followSource;
+
+    // Live rig binding
+    const Rig* m_rig = nullptr;
+    unsigned int m_rigVersion = 0;
+    std::vector<std::weak_ptr<Bone>> m_bones;
+    std::vector<Transform> m_inputLocal;
+    std::vector<Transform> m_writtenLocal;  // What we wrote, to detect fresh animation input
+    std::vector<bool> m_hasWritten;
+    unsigned int m_boundTrackSet = 0;  // Animation::getTrackSetVersion of m_tracks, 0 = none
+    std::vector<const BoneTrack*> m_tracks;
+
+    bool prepare(Rig* rig, const Animation* animation);
+    void rebuildFromRig(Rig* rig);
+    void refreshParams(const Rig& rig);
+    void bindTracks(const Animation* animation);
+    void commit();
+    float sineAt(size_t i, float time) const;
+    float noiseAt(size_t i, float time) const;
+};
+
+} // namespace Riggle
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Math.h"
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Riggle {
+
+class Rig;
+class Bone;
+class Animation;
+class BoneTrack;
+
+// Plays animations authored for one rig on another rig with the same structure
+// but different bone names and lengths. The bone map and per-bone corrections
+// are built once; applying then walks a flat list with no name lookups.
+// Build while both rigs are in their rest pose - keys are retargeted as
+// offsets from the source rest pose onto the target rest pose.
+class Retargeter {
+public:
+    Retargeter();
+
+    // Bone map - each returns false if nothing could be mapped (see getLastError)
+    bool buildByName(const Rig& source, const Rig& target);
+    bool buildByHierarchy(const Rig& source, const Rig& target);
+    bool buildFromTable(const Rig& source, const Rig& target,
+                        const std::vector<std::pair<std::string, std::string>>& table);
+
+    // Prefixes ignored by buildByName (e.g. "mixamorig:"), compared case-insensitively
+    void setIgnoredPrefixes(const std::vector<std::string>& prefixes) { m_ignoredPrefixes = prefixes; }
+
+    // Sample 'animation' (authored for the source rig) at 'time' onto the target rig
+    void apply(const Animation& animation, float time, Rig* target);
+
+    // Map queries
+    size_t getMappedBoneCount() const { return m_map.size(); }
+    const std::vector<std::pair<std::string, std::string>>& getBoneMap() const { return m_mapNames; }
+    const std::vector<std::string>& getUnmappedSourceBones() const { return m_unmapped; }
+    const std::string& getLastError() const { return m_lastError; }
+
+private:
+    // Per mapped bone, precomputed when the map is built
+    struct Correction {
+        std::string sourceName;
+        std::shared_ptr<Bone> target;
+        Transform sourceRest;
+        Transform targetRest;
+        float positionScale = 1.0f;  // Target / source parent length (rig size for roots)
+    };
+
+    // Per animation track, resolved once per animation
+    struct Binding {
+        const BoneTrack* track = nullptr;
+        int correction = -1;
+    };
+
+    std::vector<std::string> m_ignoredPrefixes;
+    std::vector<Correction> m_map;
+    std::vector<std::pair<std::string, std::string>> m_mapNames;
+    std::vector<std::string> m_unmapped;
+    std::string m_lastError;
+
+    unsigned int m_boundTrackSet = 0;  // Animation::getTrackSetVersion of the bindings, 0 = unbound
+    std::vector<Binding> m_bindings;
+
+    bool finalize(const Rig& source, const Rig& target,
+                  const std::vector<std::pair<std::shared_ptr<Bone>, std::shared_ptr<Bone>>>& pairs);
+    void bind(const Animation& animation);
+    std::string normalizeName(const std::string& name) const;
+};
+
+} // namespace Riggle
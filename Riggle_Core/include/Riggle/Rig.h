@@ -1,5 +1,8 @@
 #pragma once
 #include "Bone.h"
+#include "Constraint.h"
+#include "IK_Solver.h"
+#include "ProceduralChannel.h"
 #include <vector>
 #include <memory>
 #include <string>
@@ -8,6 +11,14 @@ namespace Riggle {
 
 class Character; // Forward declaration
 
+// Skeleton level of detail - bones listed here (and their descendants) are
+// merged into their nearest surviving ancestor while the level is active
+struct SkeletonLOD {
+    std::string name;
+    float screenScaleThreshold = 0.5f;      // Selected when on-screen scale drops below this
+    std::vector<std::string> collapsedBones;
+};
+
 class Rig {
 public:
     Rig(const std::string& name);
@@ -24,7 +35,7 @@ public:
     std::shared_ptr<Bone> findBone(const std::string& name);
     
     // Bone hierarchy
-    void addRootBone(std::shared_ptr<Bone> bone) { m_rootBones.push_back(bone); }
+    void addRootBone(std::shared_ptr<Bone> bone) { m_rootBones.push_back(bone); markSetupChanged(); }
     const std::vector<std::shared_ptr<Bone>>& getRootBones() const { return m_rootBones; }
     std::vector<std::shared_ptr<Bone>> getAllBones() const;
     
@@ -35,12 +46,70 @@ public:
     // Character reference management
     void setCharacter(Character* character);
 
+    // Bumped whenever hierarchy or solver setup changes, so solvers can
+    // rebuild their flat data only when needed
+    unsigned int getSetupVersion() const { return m_setupVersion; }
+    void markSetupChanged();
+
+    // Changes with the setup version and whenever the active LOD changes; never
+    // repeats across rigs, so caches of bone pointers keyed on it can't go stale
+    unsigned int getLayoutVersion() const { return m_layoutVersion; }
+
+    // Bones evaluated at the active LOD, parents before children; rebuilt on layout changes
+    const std::vector<std::shared_ptr<Bone>>& getEvaluatedBones() const;
+
+    // Transform constraints (evaluated by ConstraintSystem after animation)
+    int addConstraint(const BoneConstraint& constraint);
+    void setConstraint(int index, const BoneConstraint& constraint);
+    void removeConstraint(int index);
+    void clearConstraints();
+    const std::vector<BoneConstraint>& getConstraints() const { return m_constraints; }
+
+    // IK constraints (evaluated by IKConstraintSystem after animation)
+    int addIKConstraint(const IKConstraint& constraint);
+    void setIKConstraint(int index, const IKConstraint& constraint);
+    void removeIKConstraint(int index);
+    void clearIKConstraints();
+    const std::vector<IKConstraint>& getIKConstraints() const { return m_ikConstraints; }
+
+    // Procedural channels (evaluated by ProceduralChannelSystem right after animation)
+    int addProceduralChannel(const ProceduralChannel& channel);
+    void setProceduralChannel(int index, const ProceduralChannel& channel);
+    void removeProceduralChannel(int index);
+    void clearProceduralChannels();
+    const std::vector<ProceduralChannel>& getProceduralChannels() const { return m_proceduralChannels; }
+
+    // Skeleton LOD levels (level 0 is always the full skeleton)
+    int addLODLevel(const SkeletonLOD& lod);
+    void removeLODLevel(int level);
+    void clearLODLevels();
+    const std::vector<SkeletonLOD>& getLODLevels() const { return m_lodLevels; }
+    int getLODLevelCount() const { return static_cast<int>(m_lodLevels.size()) + 1; }
+    int generateLODLevels(int levelCount = 2, float minBoneLength = 20.0f);
+
+    void setActiveLOD(int level);
+    int getActiveLOD() const { return m_activeLOD; }
+    int selectLODForScreenScale(float screenScale) const;
+    size_t getEvaluatedBoneCount() const;
+
 private:
     std::string m_name;
     std::vector<std::shared_ptr<Bone>> m_rootBones;
     Character* m_character = nullptr; // Non-owning pointer
+    unsigned int m_setupVersion = 0;
+    unsigned int m_layoutVersion;
+    mutable std::vector<std::shared_ptr<Bone>> m_evaluatedBones;
+    mutable unsigned int m_evaluatedLayout = 0;
+
+    std::vector<BoneConstraint> m_constraints;
+    std::vector<IKConstraint> m_ikConstraints;
+    std::vector<ProceduralChannel> m_proceduralChannels;
+
+    // Skeleton LOD
+    std::vector<SkeletonLOD> m_lodLevels;
+    int m_activeLOD = 0;
     
-    void updateBoneHierarchy(std::shared_ptr<Bone> bone); // Recursive helper
+    void applyLOD(int level);
 };
 
 } // namespace Riggle
\ No newline at end of file
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Math.h"
+#include "WorkerPool.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Riggle {
+
+// RGBA8 pixels, rows top to bottom, straight (not premultiplied) alpha -
+// the same layout sf::Image uses, so images convert without copying per pixel
+struct RasterImage {
+    int width = 0;
+    int height = 0;
+    std::vector<std::uint8_t> pixels;
+
+    void resize(int newWidth, int newHeight);
+    bool isEmpty() const { return width <= 0 || height <= 0; }
+};
+
+// Target-space position and texture coordinates in texels
+struct RasterVertex {
+    Vector2 position;
+    Vector2 uv;
+};
+
+enum class RasterFilter {
+    Nearest,   // Matches an sf::Texture without smoothing
+    Bilinear   // Matches an sf::Texture with setSmooth(true)
+};
+
+// CPU rasteriser for textured triangles, for exports without a GPU context.
+// Follows the OpenGL rules the SFML path relies on: pixel-centre sampling,
+// top-left fill rule, clamp-to-edge texture lookups and SFML's default
+// alpha blend. Draws are queued, binned into screen tiles, and finish()
+// renders the tiles on the rasteriser's own persistent threads; each tile
+// keeps draw order, so blending matches drawing the queue front to back.
+class SoftwareRasterizer {
+public:
+    SoftwareRasterizer();
+
+    // Starts a frame cleared to the given colour (no blending, like sf::RenderTarget::clear)
+    void begin(int width, int height, std::uint8_t r, std::uint8_t g, std::uint8_t b, std::uint8_t a);
+
+    // Queue geometry; textures must stay alive until finish()
+    void drawTriangles(const std::vector<RasterVertex>& vertices, const RasterImage& texture, RasterFilter filter);
+    void drawQuad(const Vector2 corners[4], const RasterImage& texture, RasterFilter filter);
+
+    // Renders everything queued since begin()
+    void finish();
+    const RasterImage& getImage() const { return m_image; }
+
+    // Settings
+    // Threads rendering tiles, the caller included (0 = one per core); helpers are
+    // started once and kept until the count changes
+    void setThreadCount(unsigned int count) { m_threadCount = count; }
+    void setTileSize(int size) { m_tileSize = size < 8 ? 8 : size; }
+    size_t getQueuedTriangleCount() const { return m_triangles.size(); }
+
+private:
+    struct Triangle {
+        RasterVertex v[3];
+        std::int64_t fx[3] = {0, 0, 0};              // Sub-pixel fixed point
+        std::int64_t fy[3] = {0, 0, 0};
+        std::int64_t area = 0;
+        const RasterImage* texture = nullptr;
+        RasterFilter filter = RasterFilter::Nearest;
+        int minX = 0, minY = 0, maxX = 0, maxY = 0;  // Pixel bounds, inclusive
+    };
+
+    RasterImage m_image;
+    std::vector<Triangle> m_triangles;
+    unsigned int m_threadCount = 0;
+    WorkerPool m_workers;
+    int m_tileSize = 64;
+
+    // Triangles per tile in draw order: tile t owns [m_binBegin[t], m_binBegin[t + 1])
+    int m_tilesX = 0;
+    int m_tilesY = 0;
+    std::vector<int> m_binBegin;
+    std::vector<int> m_binTriangles;
+
+    void addTriangle(const RasterVertex& a, const RasterVertex& b, const RasterVertex& c,
+                     const RasterImage& texture, RasterFilter filter);
+    void binTriangles();
+    void renderTile(int tile, std::vector<float>& span);
+    void rasterizeTriangle(const Triangle& triangle, int x0, int y0, int x1, int y1, std::vector<float>& span);
+};
+
+} // namespace Riggle
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Bone.h"
+#include <memory>
+#include <vector>
+
+namespace Riggle {
+
+class Rig;
+
+// Verlet spring chains for secondary motion (hair, tails, cloth strips).
+// Runs after animation sampling. All chains are stored flat and grouped by
+// depth, so each depth layer is processed across every chain at once: the
+// animated pose (scalar trig), the Verlet step (SSE2 where available) and the
+// resulting rotation each run as their own loop over the layer.
+// A fixed substep keeps results deterministic for a given frame rate.
+class SpringBoneSolver {
+public:
+    SpringBoneSolver();
+
+    // Flat setup - parentIndex refers to an earlier added bone, -1 for a chain root
+    void clear();
+    int addBone(int parentIndex, const SpringBoneParams& params);
+    void finalize();
+    void setParams(int index, const SpringBoneParams& params);
+
+    // Per-frame input: the animated local pose (length included), and for
+    // chain roots the animated parent world transform
+    void setAnimatedPose(int index, const Transform& local);
+    void setAnchor(int index, const Transform& parentWorld);
+
+    // Advance by deltaTime using fixed substeps (the first step after reset only seats the chains)
+    void step(float deltaTime);
+    void reset();
+
+    // Simulated local rotation to write back
+    float getLocalRotation(int index) const;
+
+    // Convenience path for a live rig: rebuilds on setup changes, simulates, writes back
+    void update(Rig* rig, float deltaTime);
+
+    // Rotation the live rig had before simulation was written back (for saving the authored pose)
+    bool getAnimatedLocalRotation(const std::string& boneName, float& rotation) const;
+
+    // Settings
+    void setFixedTimeStep(float step) { m_fixedTimeStep = step > 0.0f ? step : m_fixedTimeStep; }
+    float getFixedTimeStep() const { return m_fixedTimeStep; }
+    void setMaxSubsteps(int steps) { m_maxSubsteps = steps > 0 ? steps : 1; }
+    void setEnabled(bool enabled) { m_enabled = enabled; }
+    bool isEnabled() const { return m_enabled; }
+
+    size_t getBoneCount() const { return m_slotOf.size(); }
+
+private:
+    bool m_enabled = true;
+    float m_fixedTimeStep = 1.0f / 60.0f;
+    int m_maxSubsteps = 8;
+    float m_accumulator = 0.0f;
+    bool m_needsSeat = true;
+
+    // Setup before finalize()
+    std::vector<int> m_pendingParent;
+    std::vector<SpringBoneParams> m_pendingParams;
+
+    // Index mapping (external index -> slot in layer order) and layer ranges
+    std::vector<int> m_slotOf;
+    std::vector<int> m_parentSlot;
+    std::vector<int> m_layerStart;
+
+    // Structure-of-arrays state, in slot order
+    std::vector<float> m_length, m_stiffness, m_damping, m_gravity;
+    std::vector<float> m_localX, m_localY, m_localRot, m_localSX, m_localSY;
+    std::vector<float> m_anchorX, m_anchorY, m_anchorRot, m_anchorSX, m_anchorSY;
+    std::vector<float> m_headX, m_headY, m_simRot, m_restRot;
+    std::vector<float> m_tailX, m_tailY, m_prevX, m_prevY;
+    std::vector<float> m_tipX, m_tipY;  // Animated tip, scratch for the current substep
+
+    // Live rig binding
+    const Rig* m_rig = nullptr;
+    unsigned int m_rigVersion = 0;
+    std::vector<std::weak_ptr<Bone>> m_bones;
+    std::vector<float> m_inputRot;    // Animated rotation before write-back
+    std::vector<float> m_writtenRot;  // What we wrote, to detect fresh animation input
+    std::vector<bool> m_hasWritten;
+
+    void rebuildFromRig(Rig* rig);
+    void simulate(float dt, bool seatOnly);
+    void integrate(int begin, int end, float gravityStep);
+};
+
+} // namespace Riggle
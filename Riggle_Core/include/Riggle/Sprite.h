@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Math.h"
+#include "SpriteMesh.h"
 #include <vector>
 #include <string>
 #include <memory>
@@ -48,6 +49,28 @@ public:
     void restoreBinding(std::shared_ptr<Bone> bone, const Vector2& localOffset, float localRotation);
     void clearBinding() { unbindFromBone(); }
 
+    // Mesh - sprites without one are drawn as a full texture quad
+    bool hasMesh() const { return !m_mesh.isEmpty(); }
+    const SpriteMesh& getMesh() const { return m_mesh; }
+    // On a skinned sprite each new vertex takes the weights of the nearest old one
+    void setMesh(const SpriteMesh& mesh);
+    void clearMesh();
+
+    // Multi-bone skinning: mesh vertices weighted to up to four bones
+    bool isSkinned() const { return hasMesh() && !m_skin.isEmpty(); }
+    const std::vector<std::shared_ptr<Bone>>& getSkinBones() const { return m_skinBones; }
+    const SkinData& getSkinData() const { return m_skin; }
+
+    // Bind using the current pose as bind pose
+    bool bindSkin(const std::vector<std::shared_ptr<Bone>>& bones, const std::vector<VertexWeights>& weights);
+    bool bindSkinAutoWeights(const std::vector<std::shared_ptr<Bone>>& bones, float falloff = 2.0f);
+    bool restoreSkin(const std::vector<std::shared_ptr<Bone>>& bones, const std::vector<Transform>& bindPoses,
+                     const std::vector<Vector2>& bindVertices, const std::vector<VertexWeights>& weights);
+    void clearSkin();
+
+    // World-space mesh vertices for the current pose (skinned or rigid)
+    bool computeDeformedVertices(std::vector<float>& outX, std::vector<float>& outY) const;
+
 private:
     std::string m_name;
     std::string m_texturePath;
@@ -56,6 +79,13 @@ private:
     
     // SIMPLIFIED: Single bone binding
     BoneBinding m_binding;  // Only one binding per sprite
+
+    SpriteMesh m_mesh;
+    SkinData m_skin;
+    std::vector<std::shared_ptr<Bone>> m_skinBones;
+    mutable std::vector<Affine2> m_skinMatrices; // Scratch, reused every deform
+
+    std::vector<Vector2> getMeshWorldVertices() const;
 };
 
 } // namespace Riggle
\ No newline at end of file
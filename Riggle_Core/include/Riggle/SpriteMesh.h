@@ -0,0 +1,67 @@
+#pragma once
+
+#include "Math.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace Riggle {
+
+constexpr int MAX_BONE_INFLUENCES = 4;
+
+// Triangle mesh in sprite space (origin at the texture center, pixels)
+struct SpriteMesh {
+    std::vector<Vector2> vertices;      // Local vertex positions
+    std::vector<Vector2> uvs;           // Texture coordinates in pixels
+    std::vector<unsigned int> indices;  // Triangle list
+
+    bool isEmpty() const { return vertices.empty() || indices.size() < 3; }
+    size_t getVertexCount() const { return vertices.size(); }
+    size_t getTriangleCount() const { return indices.size() / 3; }
+
+    // Regular grid covering a width x height texture
+    static SpriteMesh createGrid(float width, float height, int columns, int rows);
+};
+
+// Up to four bone influences for one vertex
+struct VertexWeights {
+    std::array<int, MAX_BONE_INFLUENCES> boneIndices = {0, 0, 0, 0};
+    std::array<float, MAX_BONE_INFLUENCES> weights = {0.0f, 0.0f, 0.0f, 0.0f};
+};
+
+// Skinning data in structure-of-arrays layout for the deform kernel
+struct SkinData {
+    std::vector<Transform> bindPoses;           // Bone world transforms at bind time
+    std::vector<Affine2> inverseBindMatrices;   // Inverse of bindPoses
+
+    // Vertex world positions at bind time
+    std::vector<float> bindX;
+    std::vector<float> bindY;
+
+    // Influence slot k of vertex i lives at [k][i]
+    std::array<std::vector<uint16_t>, MAX_BONE_INFLUENCES> boneIndices;
+    std::array<std::vector<float>, MAX_BONE_INFLUENCES> weights;
+    int influenceCount = 0;  // Highest slot in use + 1
+
+    bool isEmpty() const { return bindX.empty() || bindPoses.empty(); }
+    size_t getVertexCount() const { return bindX.size(); }
+
+    void clear();
+    void setBindPoses(const std::vector<Transform>& poses);
+    void setBindVertices(const std::vector<Vector2>& worldVertices);
+    void setVertexWeights(const std::vector<VertexWeights>& vertexWeights);
+    std::vector<VertexWeights> getVertexWeights() const;
+};
+
+// Linear blend skinning: out = sum(w_k * skinMatrix[bone_k] * bindVertex)
+// skinMatrices[j] must be boneWorld[j] * inverseBind[j]; outX/outY hold getVertexCount() floats
+void skinVertices(const SkinData& skin, const std::vector<Affine2>& skinMatrices, float* outX, float* outY);
+
+// Weights from distance to each bone segment, normalized over the closest bones
+// boneWorlds carry length, as returned by Bone::getWorldTransform()
+std::vector<VertexWeights> computeAutoWeights(const std::vector<Vector2>& worldVertices,
+                                              const std::vector<Transform>& boneWorlds,
+                                              int maxInfluences = MAX_BONE_INFLUENCES,
+                                              float falloff = 2.0f);
+
+} // namespace Riggle
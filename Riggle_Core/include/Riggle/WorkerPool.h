@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Riggle {
+
+// Persistent threads for per-frame fork/join work. The threads are started
+// once and sleep between jobs; run() hands out tasks [0, count) and the
+// calling thread works on them too, returning when every task is done.
+// One job runs at a time: a run() that finds the pool busy (another thread,
+// or a task calling run() itself) does its tasks inline instead of waiting.
+class WorkerPool {
+public:
+    explicit WorkerPool(unsigned int helperThreads = 0);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // Calls task(i) for every i in [0, count), spread over the helpers and the caller
+    void run(size_t count, const std::function<void(size_t)>& task);
+
+    // Threads besides the caller; changing it joins the old ones first
+    void setHelperThreadCount(unsigned int count);
+    unsigned int getHelperThreadCount() const { return static_cast<unsigned int>(m_threads.size()); }
+
+    // One helper per core beyond the caller, shared by the per-frame rig systems
+    static WorkerPool& shared();
+
+private:
+    std::vector<std::thread> m_threads;
+    std::mutex m_runMutex;   // Held for the whole of run()
+    std::mutex m_mutex;      // Guards the job fields below
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    bool m_stopping = false;
+    unsigned long long m_generation = 0;
+    const std::function<void(size_t)>* m_task = nullptr;
+    size_t m_count = 0;
+    std::atomic<size_t> m_next{0};
+    size_t m_busy = 0;  // Helpers still working on the current job
+
+    void start(unsigned int count);
+    void stop();
+    void workerLoop(unsigned long long seen);
+    void work();
+};
+
+} // namespace Riggle
@@ -1,21 +1,34 @@
 #include "Riggle/Animation.h"
 #include "Riggle/Rig.h"
 #include "Riggle/Bone.h"
+#include "Riggle/Retargeter.h"
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <unordered_map>
 
 namespace Riggle {
 
+namespace {
+std::atomic<unsigned int> s_nextTrackSetVersion{1};
+}
+
 // BoneTrack Implementation
 BoneTrack::BoneTrack(const std::string& boneName) : m_boneName(boneName) {}
 
 void BoneTrack::addKeyframe(float time, const Transform& transform) {
-    // Remove existing keyframe at same time
-    removeKeyframe(time);
+    const float tolerance = 0.001f;
     
-    // Add new keyframe
-    m_keyframes.emplace_back(time, transform);
-    sortKeyframes();
+    // Keyframes stay sorted, so replace or insert in place instead of re-sorting
+    auto it = std::lower_bound(m_keyframes.begin(), m_keyframes.end(), time - tolerance,
+        [](const BoneKeyframe& kf, float t) {
+            return kf.time <= t;
+        });
+    if (it != m_keyframes.end() && std::abs(it->time - time) < tolerance) {
+        *it = BoneKeyframe(time, transform);
+        return;
+    }
+    m_keyframes.insert(it, BoneKeyframe(time, transform));
 }
 
 void BoneTrack::removeKeyframe(float time) {
@@ -29,6 +42,19 @@ void BoneTrack::removeKeyframe(float time) {
     );
 }
 
+void BoneTrack::removeKeyframesInRange(float startTime, float endTime) {
+    const float tolerance = 0.001f;
+    auto first = std::lower_bound(m_keyframes.begin(), m_keyframes.end(), startTime - tolerance,
+        [](const BoneKeyframe& kf, float t) {
+            return kf.time < t;
+        });
+    auto last = std::upper_bound(first, m_keyframes.end(), endTime + tolerance,
+        [](float t, const BoneKeyframe& kf) {
+            return t < kf.time;
+        });
+    m_keyframes.erase(first, last);
+}
+
 void BoneTrack::clearKeyframes() {
     m_keyframes.clear();
 }
@@ -87,30 +113,12 @@ size_t BoneTrack::findKeyframeIndex(float time) const {
 }
 
 Transform BoneTrack::interpolateTransforms(const Transform& a, const Transform& b, float t) const {
-    Transform result;
-    
-    // FIXED: Linear interpolation for position and scale using Vector2
-    result.position.x = a.position.x + (b.position.x - a.position.x) * t;
-    result.position.y = a.position.y + (b.position.y - a.position.y) * t;
-    result.scale.x = a.scale.x + (b.scale.x - a.scale.x) * t;
-    result.scale.y = a.scale.y + (b.scale.y - a.scale.y) * t;
-    result.length = a.length + (b.length - a.length) * t;
-    
-    // Shortest path rotation interpolation
-    float angleDiff = b.rotation - a.rotation;
-    const float PI = 3.14159f;
-    
-    // Normalize angle difference to [-π, π]
-    while (angleDiff > PI) angleDiff -= 2.0f * PI;
-    while (angleDiff < -PI) angleDiff += 2.0f * PI;
-    
-    result.rotation = a.rotation + angleDiff * t;
-    
-    return result;
+    // Shared with the export pose evaluator so both sample identically
+    return interpolateTransform(a, b, t);
 }
 
 // Animation Implementation
-Animation::Animation(const std::string& name) : m_name(name) {}
+Animation::Animation(const std::string& name) : m_name(name), m_trackSetVersion(s_nextTrackSetVersion++) {}
 
 float Animation::getDuration() const {
     float maxDuration = 0.0f;
@@ -133,11 +141,14 @@ BoneTrack* Animation::createBoneTrack(const std::string& boneName) {
     auto track = std::make_unique<BoneTrack>(boneName);
     BoneTrack* result = track.get();
     m_tracks[boneName] = std::move(track);
+    m_trackSetVersion = s_nextTrackSetVersion++;
     return result;
 }
 
 void Animation::removeBoneTrack(const std::string& boneName) {
-    m_tracks.erase(boneName);
+    if (m_tracks.erase(boneName) > 0) {
+        m_trackSetVersion = s_nextTrackSetVersion++;
+    }
 }
 
 void Animation::addKeyframe(const std::string& boneName, float time, const Transform& transform) {
@@ -163,16 +174,27 @@ void Animation::removeKeyframe(const std::string& boneName, float time) {
 void Animation::applyAtTime(Rig* rig, float time) const {
     if (!rig) return;
     
-    // Apply each track to its corresponding bone
-    for (const auto& pair : m_tracks) {
-        const std::string& boneName = pair.first;
-        const BoneTrack* track = pair.second.get();
-        
-        auto bone = rig->findBone(boneName);
-        if (bone) {
-            Transform transform = track->getTransformAtTime(time);
-            bone->setLocalTransform(transform);
+    // Tracks are resolved to bones once per rig layout (setup or LOD change) and
+    // track set; bones collapsed by skeleton LOD get no binding at all
+    if (m_boundLayout != rig->getLayoutVersion() || m_boundTrackSet != m_trackSetVersion) {
+        std::unordered_map<std::string, Bone*> bones;
+        for (const auto& bone : rig->getAllBones()) {
+            bones.emplace(bone->getName(), bone.get());
         }
+
+        m_boneBindings.clear();
+        for (const auto& pair : m_tracks) {
+            auto it = bones.find(pair.first);
+            if (it != bones.end() && !it->second->isCollapsed()) {
+                m_boneBindings.push_back({pair.second.get(), it->second});
+            }
+        }
+        m_boundLayout = rig->getLayoutVersion();
+        m_boundTrackSet = m_trackSetVersion;
+    }
+
+    for (const auto& binding : m_boneBindings) {
+        binding.bone->setLocalTransform(binding.track->getTransformAtTime(time));
     }
     
     // Force update all world transforms
@@ -182,6 +204,7 @@ void Animation::applyAtTime(Rig* rig, float time) const {
 // AnimationPlayer Implementation
 AnimationPlayer::AnimationPlayer() 
     : m_animation(nullptr)
+    , m_retargeter(nullptr)
     , m_currentTime(0.0f)
     , m_isPlaying(false)
     , m_isLooping(true)
@@ -238,6 +261,10 @@ void AnimationPlayer::update(float deltaTime) {
 
 void AnimationPlayer::applyToRig(Rig* rig) {
     if (m_animation && rig) {
+        if (m_retargeter) {
+            m_retargeter->apply(*m_animation, m_currentTime, rig);
+            return;
+        }
         m_animation->applyAtTime(rig, m_currentTime);
     }
 }
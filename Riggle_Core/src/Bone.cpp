@@ -45,34 +45,21 @@ Transform Bone::getWorldTransform() const {
 }
 
 void Bone::updateWorldTransform() const {
+    // Collapsed by skeleton LOD - follow the surviving ancestor directly
+    if (auto proxy = m_lodProxy.lock()) {
+        m_worldTransform = combineTransforms(proxy->getWorldTransform(), m_lodOffset);
+        m_worldTransform.length = m_localTransform.length;
+        m_worldTransformDirty = false;
+        return;
+    }
+
     auto parent = m_parent.lock();
     if (!parent) {
         // Root bone - world transform = local transform
         m_worldTransform = m_localTransform;
     } else {
         // Child bone - combine with parent's world transform
-        Transform parentWorld = parent->getWorldTransform();
-        
-        // Apply parent transform to local transform
-        float cosRot = std::cos(parentWorld.rotation);
-        float sinRot = std::sin(parentWorld.rotation);
-        
-        // Transform position: rotate local position and add to parent position
-        float rotatedX = m_localTransform.position.x * cosRot - m_localTransform.position.y * sinRot;
-        float rotatedY = m_localTransform.position.x * sinRot + m_localTransform.position.y * cosRot;
-        
-        m_worldTransform.position.x = parentWorld.position.x + rotatedX * parentWorld.scale.x;
-        m_worldTransform.position.y = parentWorld.position.y + rotatedY * parentWorld.scale.y;
-            
-        // Combine rotations
-        m_worldTransform.rotation = parentWorld.rotation + m_localTransform.rotation;
-        
-        // Combine scales
-        m_worldTransform.scale.x = parentWorld.scale.x * m_localTransform.scale.x;
-        m_worldTransform.scale.y = parentWorld.scale.y * m_localTransform.scale.y;
-        
-        // Keep length from local transform
-        m_worldTransform.length = m_localTransform.length;
+        m_worldTransform = combineTransforms(parent->getWorldTransform(), m_localTransform);
     }
     
     m_worldTransformDirty = false;
@@ -114,6 +101,7 @@ void Bone::addChild(std::shared_ptr<Bone> child) {
     m_children.push_back(child);
     child->setParent(shared_from_this());
     child->markWorldTransformDirty();
+    notifyRigSetupChanged();
 }
 
 void Bone::removeChild(std::shared_ptr<Bone> child) {
@@ -121,6 +109,7 @@ void Bone::removeChild(std::shared_ptr<Bone> child) {
     if (it != m_children.end()) {
         (*it)->setParent(nullptr);
         m_children.erase(it);
+        notifyRigSetupChanged();
     }
 }
 
@@ -191,6 +180,34 @@ void Bone::getWorldEndpoints(float& startX, float& startY, float& endX, float& e
     endY = world.position.y + world.length * sinRot * world.scale.y;
 }
 
+void Bone::setLODProxy(std::shared_ptr<Bone> proxy, const Transform& offset) {
+    m_lodProxy = proxy;
+    m_lodOffset = offset;
+    markWorldTransformDirty();
+}
+
+void Bone::clearLODProxy() {
+    if (m_lodProxy.expired()) return;
+    m_lodProxy.reset();
+    markWorldTransformDirty();
+}
+
+void Bone::setSpringParams(const SpringBoneParams& params) {
+    bool chainsChanged = params.enabled != m_springParams.enabled;
+    m_springParams = params;
+
+    // Enabling/disabling changes the simulated chains
+    if (chainsChanged) {
+        notifyRigSetupChanged();
+    }
+}
+
+void Bone::notifyRigSetupChanged() {
+    if (m_character && m_character->getRig()) {
+        m_character->getRig()->markSetupChanged();
+    }
+}
+
 std::vector<std::shared_ptr<Bone>> Bone::getAllDescendants() const {
     std::vector<std::shared_ptr<Bone>> descendants;
     
@@ -13,16 +13,51 @@ void Character::notifyTransformChanged(const std::string& boneName, const Transf
         return;
     }
     
-    TransformEvent event{
-        boneName, 
-        oldTransform, 
-        newTransform, 
-        getCurrentTime()
-    };
+    // Captured at full rate, before events are coalesced
+    if (m_motionCapture.isRecording()) {
+        m_motionCapture.record(boneName, m_animationPlayer.getCurrentTime(), newTransform);
+    }
     
-    for (auto& handler : m_transformHandlers) {
-        handler(event);
+    if (m_transformHandlers.empty()) {
+        return;
+    }
+    
+    // Repeated changes to a bone (IK iterations, drag steps) collapse into one event
+    auto it = m_pendingEventIndex.find(boneName);
+    if (it != m_pendingEventIndex.end()) {
+        m_pendingEvents[it->second].newTransform = newTransform;
+        return;
+    }
+    
+    m_pendingEventIndex.emplace(boneName, m_pendingEvents.size());
+    m_pendingEvents.push_back(TransformEvent{boneName, oldTransform, newTransform, 0.0f});
+}
+
+void Character::flushTransformEvents() {
+    if (m_pendingEvents.empty()) {
+        return;
+    }
+    
+    // Handlers may change bones again, those changes queue for the next flush
+    std::vector<TransformEvent> events;
+    events.swap(m_pendingEvents);
+    m_pendingEventIndex.clear();
+    
+    float timestamp = getCurrentTime();
+    for (auto& event : events) {
+        event.timestamp = timestamp;
+        for (auto& handler : m_transformHandlers) {
+            handler(event);
+        }
+    }
+}
+
+void Character::setManualBoneEditMode(bool enabled) {
+    // Deliver edits made in manual mode before leaving it
+    if (!enabled) {
+        flushTransformEvents();
     }
+    m_manualBoneEditMode = enabled;
 }
 
 float Character::getCurrentTime() const {
@@ -92,6 +127,10 @@ Sprite* Character::findSprite(const std::string& name) {
 
 void Character::setRig(std::unique_ptr<Rig> rig) {
     m_rig = std::move(rig);
+    m_proceduralChannels.clear();
+    m_ikConstraintSystem.clear();
+    m_constraintSystem.clear();
+    m_springSolver.clear();
 
     // Set character reference in rig
     if (m_rig) {
@@ -103,16 +142,46 @@ void Character::setRig(std::unique_ptr<Rig> rig) {
     }
 }
 
-bool Character::solveIK(std::shared_ptr<Bone> endEffector, const Vector2& targetPos, int chainLength) {
+bool Character::solveIK(std::shared_ptr<Bone> endEffector, const Vector2& targetPos, int chainLength,
+                        const IKSolveSettings& settings) {
     if (!m_rig) return false;
-    bool result = m_ikSolver.solveCCD(m_rig.get(), endEffector, targetPos, chainLength);
+    bool result = m_ikSolver.solve(m_rig.get(), endEffector, targetPos, chainLength, settings);
     if (result) {
         // Force update after IK solving
         forceUpdateDeformations();
     }
+    flushTransformEvents();
     return result;
 }
 
+bool Character::solveIKChain(const std::vector<std::shared_ptr<Bone>>& chain, const Vector2& targetPos,
+                             const IKSolveSettings& settings, const std::vector<float>* startRotations) {
+    if (!m_rig) return false;
+    bool result = m_ikSolver.solveChain(m_rig.get(), chain, targetPos, settings, startRotations);
+    
+    // Budgeted solves may stop short of the target, the partial pose still needs showing
+    forceUpdateDeformations();
+    flushTransformEvents();
+    return result;
+}
+
+void Character::setLODLevel(int level) {
+    if (m_rig) {
+        m_rig->setActiveLOD(level);
+    }
+}
+
+int Character::getLODLevel() const {
+    return m_rig ? m_rig->getActiveLOD() : 0;
+}
+
+int Character::updateLODForScreenScale(float screenScale) {
+    if (!m_rig) return 0;
+
+    m_rig->setActiveLOD(m_rig->selectLODForScreenScale(screenScale));
+    return m_rig->getActiveLOD();
+}
+
 void Character::addAnimation(std::unique_ptr<Animation> animation) {
     if (animation) {
         m_animations.push_back(std::move(animation));
@@ -156,9 +225,25 @@ void Character::update(float deltaTime) {
     // Update animation player
     m_animationPlayer.update(deltaTime);
     
-    // Apply animation to rig
+    // Apply animation to rig, then procedural channels, IK, constraints and secondary motion on top
     if (m_rig) {
         m_animationPlayer.applyToRig(m_rig.get());
+
+        // Channels follow the timeline so previews match exports; without an animation they free-run
+        const Animation* animation = m_animationPlayer.getAnimation();
+        float loopDuration = 0.0f;
+        if (animation) {
+            m_proceduralTime = m_animationPlayer.getCurrentTime();
+            loopDuration = m_animationPlayer.isLooping() ? animation->getDuration() : 0.0f;
+            if (m_animationPlayer.getRetargeter()) animation = nullptr; // Tracks belong to another rig
+        } else {
+            m_proceduralTime += deltaTime;
+        }
+        m_proceduralChannels.update(m_rig.get(), m_proceduralTime, animation, loopDuration);
+        m_ikConstraintSystem.update(m_rig.get());
+        m_constraintSystem.update(m_rig.get());
+        m_springSolver.update(m_rig.get(), deltaTime);
+        m_proceduralChannels.endFrame(m_rig.get());
     }
     
     // Update deformations if auto-update is enabled
@@ -0,0 +1,494 @@
+#include "Riggle/ConstraintSystem.h"
+#include "Riggle/Rig.h"
+#include "Riggle/WorkerPool.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <unordered_map>
+
+namespace Riggle {
+
+namespace {
+
+float wrapAngle(float angle) {
+    const float PI = 3.14159265f;
+    while (angle > PI) angle -= 2.0f * PI;
+    while (angle < -PI) angle += 2.0f * PI;
+    return angle;
+}
+
+float mixAngle(float from, float to, float t) {
+    return from + wrapAngle(to - from) * t;
+}
+
+bool samePose(const Transform& a, const Transform& b) {
+    return a.position.x == b.position.x && a.position.y == b.position.y && a.rotation == b.rotation &&
+           a.scale.x == b.scale.x && a.scale.y == b.scale.y;
+}
+
+bool needsTarget(ConstraintType type) {
+    return type != ConstraintType::LimitRotation;
+}
+
+int findRoot(std::vector<int>& parent, int i) {
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+} // namespace
+
+ConstraintSystem::ConstraintSystem() {
+}
+
+void ConstraintSystem::clear() {
+    m_boneParent.clear();
+    m_pending.clear();
+    m_inputLocal.clear();
+    m_slotOf.clear();
+    m_slotBone.clear();
+    m_parentSlot.clear();
+    m_opBegin.clear();
+    m_ops.clear();
+    m_components.clear();
+    m_local.clear();
+    m_world.clear();
+    m_droppedConstraints = 0;
+
+    m_rig = nullptr;
+    m_bones.clear();
+    m_writtenLocal.clear();
+    m_hasWritten.clear();
+}
+
+int ConstraintSystem::addBone(int parentIndex) {
+    int index = static_cast<int>(m_boneParent.size());
+    m_boneParent.push_back(parentIndex >= 0 && parentIndex < index ? parentIndex : -1);
+    return index;
+}
+
+void ConstraintSystem::addConstraint(const BoneConstraint& constraint, int boneIndex, int targetIndex) {
+    PendingConstraint pending;
+    pending.constraint = constraint;
+    pending.bone = boneIndex;
+    pending.target = targetIndex;
+    m_pending.push_back(pending);
+}
+
+bool ConstraintSystem::finalize() {
+    const int count = static_cast<int>(m_boneParent.size());
+    m_inputLocal.assign(count, Transform());
+    m_droppedConstraints = 0;
+    m_lastError.clear();
+
+    // Drop constraints that can't be evaluated
+    std::vector<PendingConstraint> active;
+    for (const auto& pending : m_pending) {
+        bool validBone = pending.bone >= 0 && pending.bone < count;
+        bool validTarget = !needsTarget(pending.constraint.type) ||
+                           (pending.target >= 0 && pending.target < count && pending.target != pending.bone);
+        if (pending.constraint.enabled && validBone && validTarget) {
+            active.push_back(pending);
+        }
+    }
+
+    // Only owners, targets and their ancestors need evaluating - the rest of the
+    // hierarchy follows through the normal world transform update
+    std::vector<bool> needed(count, false);
+    auto markChain = [&](int bone) {
+        for (; bone >= 0 && !needed[bone]; bone = m_boneParent[bone]) {
+            needed[bone] = true;
+        }
+    };
+    for (const auto& pending : active) {
+        markChain(pending.bone);
+        if (needsTarget(pending.constraint.type)) markChain(pending.target);
+    }
+
+    // Dependency graph: parent -> child and target -> owner edges
+    std::vector<std::vector<int>> dependents(count);
+    for (int i = 0; i < count; ++i) {
+        if (needed[i] && m_boneParent[i] >= 0) dependents[m_boneParent[i]].push_back(i);
+    }
+    for (const auto& pending : active) {
+        if (needsTarget(pending.constraint.type)) dependents[pending.target].push_back(pending.bone);
+    }
+
+    // Strongly connected components (iterative Tarjan). A constraint whose target and
+    // owner share a component sits on a cycle; the hierarchy alone is always acyclic,
+    // so dropping exactly those constraints leaves the rest schedulable.
+    std::vector<int> sccOf(count, -1);
+    {
+        std::vector<int> visitIndex(count, -1), lowLink(count, 0);
+        std::vector<bool> onStack(count, false);
+        std::vector<int> stack;
+        std::vector<std::pair<int, size_t>> callStack;
+        int nextIndex = 0, sccCount = 0;
+        for (int start = 0; start < count; ++start) {
+            if (!needed[start] || visitIndex[start] >= 0) continue;
+            callStack.emplace_back(start, 0);
+            while (!callStack.empty()) {
+                int node = callStack.back().first;
+                size_t& edge = callStack.back().second;
+                if (edge == 0 && visitIndex[node] < 0) {
+                    visitIndex[node] = lowLink[node] = nextIndex++;
+                    stack.push_back(node);
+                    onStack[node] = true;
+                }
+                if (edge < dependents[node].size()) {
+                    int next = dependents[node][edge++];
+                    if (visitIndex[next] < 0) {
+                        callStack.emplace_back(next, 0);
+                    } else if (onStack[next]) {
+                        lowLink[node] = std::min(lowLink[node], visitIndex[next]);
+                    }
+                    continue;
+                }
+
+                if (lowLink[node] == visitIndex[node]) {
+                    int member;
+                    do {
+                        member = stack.back();
+                        stack.pop_back();
+                        onStack[member] = false;
+                        sccOf[member] = sccCount;
+                    } while (member != node);
+                    ++sccCount;
+                }
+                callStack.pop_back();
+                if (!callStack.empty()) {
+                    int caller = callStack.back().first;
+                    lowLink[caller] = std::min(lowLink[caller], lowLink[node]);
+                }
+            }
+        }
+    }
+
+    size_t before = active.size();
+    active.erase(std::remove_if(active.begin(), active.end(), [&](const PendingConstraint& pending) {
+        return needsTarget(pending.constraint.type) && sccOf[pending.bone] == sccOf[pending.target];
+    }), active.end());
+    m_droppedConstraints = before - active.size();
+
+    if (m_droppedConstraints > 0) {
+        m_lastError = "Dropped " + std::to_string(m_droppedConstraints) +
+                      " constraint(s) whose target depends on the constrained bone (dependency cycle)";
+        std::cout << "ConstraintSystem: " << m_lastError << std::endl;
+    }
+
+    // Topological sort over what is left
+    std::vector<int> inDegree(count, 0);
+    for (int i = 0; i < count; ++i) {
+        if (needed[i] && m_boneParent[i] >= 0) ++inDegree[i];
+    }
+    for (int i = 0; i < count; ++i) dependents[i].clear();
+    for (int i = 0; i < count; ++i) {
+        if (needed[i] && m_boneParent[i] >= 0) dependents[m_boneParent[i]].push_back(i);
+    }
+    for (const auto& pending : active) {
+        if (!needsTarget(pending.constraint.type)) continue;
+        dependents[pending.target].push_back(pending.bone);
+        ++inDegree[pending.bone];
+    }
+
+    std::vector<int> order;
+    for (int i = 0; i < count; ++i) {
+        if (needed[i] && inDegree[i] == 0) order.push_back(i);
+    }
+    for (size_t head = 0; head < order.size(); ++head) {
+        for (int next : dependents[order[head]]) {
+            if (--inDegree[next] == 0) order.push_back(next);
+        }
+    }
+
+    // Connected components, so independent sub-graphs can run side by side
+    std::vector<int> unionParent(count);
+    std::iota(unionParent.begin(), unionParent.end(), 0);
+    auto unite = [&](int a, int b) { unionParent[findRoot(unionParent, a)] = findRoot(unionParent, b); };
+    for (int bone : order) {
+        if (m_boneParent[bone] >= 0) unite(bone, m_boneParent[bone]);
+    }
+    for (const auto& pending : active) {
+        if (needsTarget(pending.constraint.type)) unite(pending.bone, pending.target);
+    }
+
+    std::unordered_map<int, int> componentOf;
+    std::vector<int> componentIndex(count, 0);
+    for (int bone : order) {
+        int root = findRoot(unionParent, bone);
+        auto it = componentOf.emplace(root, static_cast<int>(componentOf.size())).first;
+        componentIndex[bone] = it->second;
+    }
+
+    // Group by component, keeping the topological order inside each one
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return componentIndex[a] < componentIndex[b];
+    });
+
+    const int slotCount = static_cast<int>(order.size());
+    m_slotOf.assign(count, -1);
+    m_slotBone = order;
+    for (int slot = 0; slot < slotCount; ++slot) {
+        m_slotOf[order[slot]] = slot;
+    }
+
+    m_parentSlot.assign(slotCount, -1);
+    m_components.clear();
+    for (int slot = 0; slot < slotCount; ++slot) {
+        int parent = m_boneParent[order[slot]];
+        m_parentSlot[slot] = parent >= 0 ? m_slotOf[parent] : -1;
+
+        if (slot == 0 || componentIndex[order[slot]] != componentIndex[order[slot - 1]]) {
+            m_components.emplace_back(slot, slot);
+        }
+        m_components.back().second = slot + 1;
+    }
+
+    // Flatten constraints per slot, keeping their original order on each bone
+    std::vector<std::vector<ConstraintOp>> opsPerSlot(slotCount);
+    for (const auto& pending : active) {
+        const BoneConstraint& constraint = pending.constraint;
+        ConstraintOp op;
+        op.type = constraint.type;
+        op.targetSlot = needsTarget(constraint.type) ? m_slotOf[pending.target] : -1;
+        op.influence = std::clamp(constraint.influence, 0.0f, 1.0f);
+        op.rotationOffset = constraint.rotationOffset;
+        op.minRotation = std::min(constraint.minRotation, constraint.maxRotation);
+        op.maxRotation = std::max(constraint.minRotation, constraint.maxRotation);
+        op.targetOffset = constraint.targetOffset;
+        op.source = pending.source;
+        opsPerSlot[m_slotOf[pending.bone]].push_back(op);
+    }
+
+    m_ops.clear();
+    m_opBegin.assign(slotCount + 1, 0);
+    for (int slot = 0; slot < slotCount; ++slot) {
+        m_opBegin[slot] = static_cast<int>(m_ops.size());
+        m_ops.insert(m_ops.end(), opsPerSlot[slot].begin(), opsPerSlot[slot].end());
+    }
+    m_opBegin[slotCount] = static_cast<int>(m_ops.size());
+
+    m_local.assign(slotCount, Transform());
+    m_world.assign(slotCount, Transform());
+    return m_droppedConstraints == 0;
+}
+
+void ConstraintSystem::setLocalTransform(int index, const Transform& local) {
+    m_inputLocal[index] = local;
+}
+
+Transform ConstraintSystem::getConstrainedTransform(int index) const {
+    int slot = m_slotOf[index];
+    return slot >= 0 ? m_local[slot] : m_inputLocal[index];
+}
+
+bool ConstraintSystem::isConstrained(int index) const {
+    int slot = m_slotOf[index];
+    return slot >= 0 && m_opBegin[slot] < m_opBegin[slot + 1];
+}
+
+void ConstraintSystem::evaluate() {
+    const int slotCount = static_cast<int>(m_slotBone.size());
+    if (m_ops.empty()) return;
+
+    for (int slot = 0; slot < slotCount; ++slot) {
+        m_local[slot] = m_inputLocal[m_slotBone[slot]];
+    }
+
+    // Small rigs: one pass on this thread, handing out work would cost more than it saves
+    WorkerPool& pool = WorkerPool::shared();
+    size_t workers = std::min<size_t>(pool.getHelperThreadCount() + 1, m_components.size());
+    if (workers < 2 || static_cast<size_t>(slotCount) < m_parallelThreshold) {
+        evaluateRange(0, slotCount);
+        return;
+    }
+
+    // Components are contiguous, so split into balanced runs of whole components
+    std::vector<std::pair<int, int>> batches;
+    const int perWorker = slotCount / static_cast<int>(workers);
+    for (const auto& component : m_components) {
+        if (batches.empty() || batches.back().second - batches.back().first >= perWorker) {
+            batches.emplace_back(component.first, component.second);
+        } else {
+            batches.back().second = component.second;
+        }
+    }
+
+    // Persistent helpers; no threads are started per frame
+    pool.run(batches.size(), [this, &batches](size_t i) {
+        evaluateRange(batches[i].first, batches[i].second);
+    });
+}
+
+void ConstraintSystem::evaluateRange(int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+        const int parent = m_parentSlot[i];
+        const Transform parentWorld = parent >= 0 ? m_world[parent] : Transform();
+        Transform world = combineTransforms(parentWorld, m_local[i]);
+
+        const int opEnd = m_opBegin[i + 1];
+        for (int o = m_opBegin[i]; o < opEnd; ++o) {
+            const ConstraintOp& op = m_ops[o];
+
+            switch (op.type) {
+                case ConstraintType::CopyRotation: {
+                    float targetRotation = m_world[op.targetSlot].rotation + op.rotationOffset;
+                    world.rotation = mixAngle(world.rotation, targetRotation, op.influence);
+                    break;
+                }
+                case ConstraintType::LookAt: {
+                    // Direction in the bone's own scaled frame, so the drawn bone points at the target
+                    const Vector2 delta = m_world[op.targetSlot].position - world.position;
+                    if (delta.lengthSquared() < 1e-8f) break;
+                    float scaleX = std::abs(world.scale.x) > 1e-6f ? world.scale.x : 1.0f;
+                    float scaleY = std::abs(world.scale.y) > 1e-6f ? world.scale.y : 1.0f;
+                    float aim = std::atan2(delta.y / scaleY, delta.x / scaleX) + op.rotationOffset;
+                    world.rotation = mixAngle(world.rotation, aim, op.influence);
+                    break;
+                }
+                case ConstraintType::LimitRotation: {
+                    float localRotation = wrapAngle(world.rotation - parentWorld.rotation);
+                    float limited = std::clamp(localRotation, op.minRotation, op.maxRotation);
+                    world.rotation = parentWorld.rotation + localRotation + (limited - localRotation) * op.influence;
+                    break;
+                }
+                case ConstraintType::ParentSpace: {
+                    Transform followed = combineTransforms(m_world[op.targetSlot], op.targetOffset);
+                    float t = op.influence;
+                    world.position = world.position + (followed.position - world.position) * t;
+                    world.rotation = mixAngle(world.rotation, followed.rotation, t);
+                    world.scale = world.scale + (followed.scale - world.scale) * t;
+                    break;
+                }
+            }
+        }
+
+        if (m_opBegin[i] < opEnd) {
+            float length = m_local[i].length;
+            m_local[i] = relativeTransform(parentWorld, world);
+            m_local[i].length = length;
+        }
+        m_world[i] = world;
+    }
+}
+
+void ConstraintSystem::rebuildFromRig(Rig* rig) {
+    clear();
+
+    // Hierarchy order guarantees parents are added before children
+    std::unordered_map<std::string, int> indexOf;
+    std::function<void(const std::shared_ptr<Bone>&, int)> visit = [&](const std::shared_ptr<Bone>& bone, int parent) {
+        if (!bone) return;
+        int index = addBone(parent);
+        indexOf[bone->getName()] = index;
+        m_bones.push_back(bone);
+        for (const auto& child : bone->getChildren()) {
+            visit(child, index);
+        }
+    };
+    for (const auto& root : rig->getRootBones()) {
+        visit(root, -1);
+    }
+
+    const auto& constraints = rig->getConstraints();
+    size_t unresolved = 0;
+    for (size_t i = 0; i < constraints.size(); ++i) {
+        auto bone = indexOf.find(constraints[i].boneName);
+        auto target = indexOf.find(constraints[i].targetName);
+        if (bone == indexOf.end() || (needsTarget(constraints[i].type) && target == indexOf.end())) {
+            ++unresolved;
+            continue;
+        }
+
+        addConstraint(constraints[i], bone->second, target != indexOf.end() ? target->second : -1);
+        m_pending.back().source = static_cast<int>(i);
+    }
+
+    finalize();
+    if (unresolved > 0) {
+        std::cout << "ConstraintSystem: " << unresolved << " constraint(s) reference missing bones" << std::endl;
+    }
+
+    m_writtenLocal.assign(m_bones.size(), Transform());
+    m_hasWritten.assign(m_bones.size(), false);
+
+    m_rig = rig;
+    m_rigVersion = rig->getSetupVersion();
+}
+
+void ConstraintSystem::refreshParams(const Rig& rig) {
+    const auto& constraints = rig.getConstraints();
+    for (auto& op : m_ops) {
+        if (op.source < 0 || op.source >= static_cast<int>(constraints.size())) continue;
+
+        const BoneConstraint& constraint = constraints[op.source];
+        op.influence = std::clamp(constraint.influence, 0.0f, 1.0f);
+        op.rotationOffset = constraint.rotationOffset;
+        op.minRotation = std::min(constraint.minRotation, constraint.maxRotation);
+        op.maxRotation = std::max(constraint.minRotation, constraint.maxRotation);
+        op.targetOffset = constraint.targetOffset;
+    }
+}
+
+bool ConstraintSystem::getAnimatedLocalTransform(const std::string& boneName, Transform& transform) const {
+    for (size_t i = 0; i < m_bones.size(); ++i) {
+        auto bone = m_bones[i].lock();
+        if (!bone || bone->getName() != boneName) continue;
+        if (!m_hasWritten[i] || !isConstrained(static_cast<int>(i))) return false;
+
+        // Only if nothing re-posed the bone since our write-back
+        if (!samePose(bone->getLocalTransform(), m_writtenLocal[i])) return false;
+        transform = m_inputLocal[i];
+        return true;
+    }
+    return false;
+}
+
+Transform ConstraintSystem::captureParentSpaceOffset(const Bone& bone, const Bone& target) {
+    return relativeTransform(target.getWorldTransform(), bone.getWorldTransform());
+}
+
+void ConstraintSystem::update(Rig* rig) {
+    if (!rig || !m_enabled) return;
+
+    if (rig != m_rig || rig->getSetupVersion() != m_rigVersion) {
+        rebuildFromRig(rig);
+    } else {
+        refreshParams(*rig);
+    }
+    if (m_ops.empty()) return;
+
+    // Gather the animated pose of every scheduled bone
+    for (int bone : m_slotBone) {
+        auto ptr = m_bones[bone].lock();
+        if (!ptr) {
+            m_rig = nullptr; // Rebuild next frame
+            return;
+        }
+
+        // Unchanged since our write-back means nothing re-posed the bone this frame
+        const Transform& local = ptr->getLocalTransform();
+        if (!(m_hasWritten[bone] && samePose(local, m_writtenLocal[bone]))) {
+            m_inputLocal[bone] = local;
+        }
+    }
+
+    evaluate();
+
+    // Single write-back, only for bones that own constraints
+    for (size_t slot = 0; slot < m_slotBone.size(); ++slot) {
+        if (m_opBegin[slot] == m_opBegin[slot + 1]) continue;
+
+        int bone = m_slotBone[slot];
+        auto ptr = m_bones[bone].lock();
+        ptr->setLocalTransform(m_local[slot]);
+        m_writtenLocal[bone] = ptr->getLocalTransform();
+        m_hasWritten[bone] = true;
+    }
+}
+
+} // namespace Riggle
@@ -11,6 +11,8 @@ ExportProject ExportService::extractProjectData(const Character& character, cons
     // Extract rig data
     if (character.getRig()) {
         project.bones = extractBoneData(*character.getRig());
+        project.lodLevels = extractLODData(*character.getRig());
+        restoreAuthoredPose(character, project.bones);
     }
     
     // Extract sprite data
@@ -58,9 +60,48 @@ std::vector<ExportBone> ExportService::extractBoneData(const Rig& rig) {
         }
     }
     
+    // Constraints travel with the bone they constrain
+    for (const auto& constraint : rig.getConstraints()) {
+        auto it = std::find_if(bones.begin(), bones.end(),
+            [&constraint](const ExportBone& bone) { return bone.name == constraint.boneName; });
+        if (it != bones.end()) {
+            it->constraints.push_back(constraint);
+        }
+    }
+    for (const auto& constraint : rig.getIKConstraints()) {
+        auto it = std::find_if(bones.begin(), bones.end(),
+            [&constraint](const ExportBone& bone) { return bone.name == constraint.endEffector; });
+        if (it != bones.end()) {
+            it->ikConstraints.push_back(constraint);
+        }
+    }
+    for (const auto& channel : rig.getProceduralChannels()) {
+        auto it = std::find_if(bones.begin(), bones.end(),
+            [&channel](const ExportBone& bone) { return bone.name == channel.boneName; });
+        if (it != bones.end()) {
+            it->proceduralChannels.push_back(channel);
+        }
+    }
+    
     return bones;
 }
 
+void ExportService::restoreAuthoredPose(const Character& character, std::vector<ExportBone>& bones) {
+    for (auto& bone : bones) {
+        character.getIKConstraintSystem().getAnimatedLocalRotation(bone.name, bone.transform.rotation);
+        if (bone.spring.enabled) {
+            character.getSpringBoneSolver().getAnimatedLocalRotation(bone.name, bone.transform.rotation);
+        }
+        if (!bone.constraints.empty()) {
+            character.getConstraintSystem().getAnimatedLocalTransform(bone.name, bone.transform);
+        }
+        // Channels run first, so their input is the keyframed pose
+        if (!bone.proceduralChannels.empty()) {
+            character.getProceduralChannelSystem().getAnimatedLocalTransform(bone.name, bone.transform);
+        }
+    }
+}
+
 std::vector<ExportSprite> ExportService::extractSpriteData(const std::vector<std::shared_ptr<Sprite>>& sprites) {
     std::vector<ExportSprite> exportSprites;
     exportSprites.reserve(sprites.size());
@@ -74,11 +115,28 @@ std::vector<ExportSprite> ExportService::extractSpriteData(const std::vector<std
     return exportSprites;
 }
 
+std::vector<ExportLODLevel> ExportService::extractLODData(const Rig& rig) {
+    std::vector<ExportLODLevel> levels;
+    levels.reserve(rig.getLODLevels().size());
+    
+    for (const auto& lod : rig.getLODLevels()) {
+        ExportLODLevel level;
+        level.name = lod.name;
+        level.screenScaleThreshold = lod.screenScaleThreshold;
+        level.collapsedBones = lod.collapsedBones;
+        levels.push_back(level);
+    }
+    
+    return levels;
+}
+
 ExportBone ExportService::convertBone(std::shared_ptr<Bone> bone) {
     ExportBone exportBone;
     exportBone.name = bone->getName();
     exportBone.transform = bone->getLocalTransform();
     exportBone.length = bone->getLength();
+    exportBone.spring = bone->getSpringParams();
+    exportBone.rotationLimits = bone->getRotationLimits();
     
     // Set parent name
     auto parent = bone->getParent();
@@ -127,6 +185,24 @@ ExportSprite ExportService::convertSprite(const Sprite& sprite) {
         exportSprite.transform = sprite.getLocalTransform();
     }
     
+    // Mesh and skin weights
+    if (sprite.hasMesh()) {
+        exportSprite.mesh = sprite.getMesh();
+        
+        if (sprite.isSkinned()) {
+            const SkinData& skin = sprite.getSkinData();
+            for (const auto& bone : sprite.getSkinBones()) {
+                exportSprite.skinBoneNames.push_back(bone->getName());
+            }
+            exportSprite.skinBindPoses = skin.bindPoses;
+            exportSprite.skinBindVertices.reserve(skin.getVertexCount());
+            for (size_t i = 0; i < skin.getVertexCount(); ++i) {
+                exportSprite.skinBindVertices.emplace_back(skin.bindX[i], skin.bindY[i]);
+            }
+            exportSprite.skinWeights = skin.getVertexWeights();
+        }
+    }
+    
     return exportSprite;
 }
 
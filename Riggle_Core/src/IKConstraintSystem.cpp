@@ -0,0 +1,257 @@
+#include "Riggle/IKConstraintSystem.h"
+#include "Riggle/Rig.h"
+#include "Riggle/WorkerPool.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace Riggle {
+
+namespace {
+
+// True if 'bone' is 'ancestor' or sits anywhere below it
+bool isInSubtree(std::shared_ptr<Bone> bone, const std::shared_ptr<Bone>& ancestor) {
+    for (; bone; bone = bone->getParent()) {
+        if (bone == ancestor) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+IKConstraintSystem::IKConstraintSystem() {
+}
+
+void IKConstraintSystem::clear() {
+    m_jobs.clear();
+    m_waveCount = 0;
+    m_rig = nullptr;
+}
+
+void IKConstraintSystem::rebuildFromRig(Rig* rig) {
+    clear();
+
+    IKSolver chainBuilder;
+    const auto& constraints = rig->getIKConstraints();
+    size_t unresolved = 0;
+    for (size_t i = 0; i < constraints.size(); ++i) {
+        const IKConstraint& constraint = constraints[i];
+        if (!constraint.enabled) continue;
+
+        // The constraint's own end effector first, then any extra ones
+        std::vector<std::shared_ptr<Bone>> effectors;
+        std::vector<std::shared_ptr<Bone>> targetBones;
+        bool resolved = constraint.extraEffectors.size() < static_cast<size_t>(IKSolver::MaxDLSEffectors);
+        auto addEffector = [&](const std::string& endEffector, const std::string& targetName) {
+            auto bone = rig->findBone(endEffector);
+            std::shared_ptr<Bone> targetBone;
+            if (!targetName.empty()) {
+                targetBone = rig->findBone(targetName);
+                if (!targetBone) resolved = false;
+            }
+            if (!bone) resolved = false;
+            effectors.push_back(bone);
+            targetBones.push_back(targetBone);
+        };
+        addEffector(constraint.endEffector, constraint.targetBone);
+        for (const auto& extra : constraint.extraEffectors) {
+            addEffector(extra.endEffector, extra.targetBone);
+        }
+
+        auto job = std::make_unique<Job>();
+        if (resolved && effectors.size() == 1) {
+            auto validation = chainBuilder.validateChain(effectors[0], constraint.chainLength);
+            resolved = validation.isValid && validation.chain.size() >= 2;
+            job->chain = validation.chain;
+            job->effectorJoints.push_back(static_cast<int>(job->chain.size()) - 1);
+        } else if (resolved) {
+            resolved = chainBuilder.buildEffectorTree(effectors, constraint.chainLength, job->chain, job->effectorJoints);
+        }
+        if (!resolved) {
+            ++unresolved;
+            continue;
+        }
+
+        job->source = static_cast<int>(i);
+        for (const auto& bone : job->chain) {
+            if (std::find(job->chain.begin(), job->chain.end(), bone->getParent()) == job->chain.end()) {
+                job->roots.push_back(bone);
+            }
+        }
+        job->targetBones = targetBones;
+        job->targets.assign(effectors.size(), Vector2());
+        job->weights.assign(effectors.size(), 1.0f);
+        job->inputRotations.assign(job->chain.size(), 0.0f);
+        job->writtenRotations.assign(job->chain.size(), 0.0f);
+        m_jobs.push_back(std::move(job));
+    }
+
+    // Same result as solving in list order: a constraint waits for every earlier one
+    // whose chain moves its own bones, the bones above them, or its targets
+    m_waveCount = 0;
+    for (size_t j = 0; j < m_jobs.size(); ++j) {
+        Job& job = *m_jobs[j];
+        for (size_t i = 0; i < j; ++i) {
+            const Job& earlier = *m_jobs[i];
+            bool dependent = false;
+            for (const auto& movedRoot : earlier.roots) {
+                for (size_t k = 0; k < job.effectorJoints.size() && !dependent; ++k) {
+                    dependent = isInSubtree(job.chain[job.effectorJoints[k]], movedRoot) ||
+                                isInSubtree(job.targetBones[k], movedRoot);
+                }
+            }
+            if (dependent) {
+                job.wave = std::max(job.wave, earlier.wave + 1);
+            }
+        }
+        m_waveCount = std::max(m_waveCount, job.wave + 1);
+    }
+
+    if (unresolved > 0) {
+        std::cout << "IKConstraintSystem: " << unresolved << " IK constraint(s) reference missing bones, too long chains or too many effectors" << std::endl;
+    }
+
+    m_rig = rig;
+    m_rigVersion = rig->getSetupVersion();
+}
+
+bool IKConstraintSystem::prepare(Rig* rig) {
+    if (!rig || !m_enabled) return false;
+
+    if (rig != m_rig || rig->getSetupVersion() != m_rigVersion) {
+        rebuildFromRig(rig);
+    }
+
+    // Solver settings and target points are picked up live
+    const auto& constraints = rig->getIKConstraints();
+    for (auto& job : m_jobs) {
+        if (job->source >= static_cast<int>(constraints.size()) ||
+            job->targets.size() != constraints[job->source].extraEffectors.size() + 1) {
+            m_rig = nullptr; // Rebuild next frame
+            return false;
+        }
+        const IKConstraint& constraint = constraints[job->source];
+        job->settings = constraint.settings;
+        job->targets[0] = constraint.targetPosition;
+        for (size_t k = 1; k < job->targets.size(); ++k) {
+            job->targets[k] = constraint.extraEffectors[k - 1].targetPosition;
+            job->weights[k] = constraint.extraEffectors[k - 1].weight;
+        }
+    }
+    return !m_jobs.empty();
+}
+
+void IKConstraintSystem::loadWave(int wave) {
+    for (auto& job : m_jobs) {
+        if (job->wave != wave) continue;
+
+        // Unchanged since our write-back means nothing re-posed the bone this frame,
+        // so start again from last frame's animated pose instead of the IK result
+        for (size_t i = 0; i < job->chain.size(); ++i) {
+            float rotation = job->chain[i]->getLocalTransform().rotation;
+            if (!(job->hasWritten && rotation == job->writtenRotations[i])) {
+                job->inputRotations[i] = rotation;
+            }
+        }
+
+        for (size_t k = 0; k < job->targetBones.size(); ++k) {
+            if (job->targetBones[k]) job->targets[k] = job->targetBones[k]->getWorldTransform().position;
+        }
+        job->workspace.load(job->chain, &job->inputRotations);
+    }
+}
+
+void IKConstraintSystem::commitWave(int wave) {
+    for (auto& job : m_jobs) {
+        if (job->wave != wave) continue;
+
+        // Setting a bone marks its subtree dirty, so the next wave reads fresh world transforms
+        job->workspace.writeBack();
+        for (size_t i = 0; i < job->chain.size(); ++i) {
+            job->writtenRotations[i] = job->chain[i]->getLocalTransform().rotation;
+        }
+        job->hasWritten = true;
+    }
+}
+
+void IKConstraintSystem::update(Rig* rig) {
+    updateAll({{this, rig}});
+}
+
+void IKConstraintSystem::updateAll(const std::vector<std::pair<IKConstraintSystem*, Rig*>>& systems) {
+    auto startTime = std::chrono::steady_clock::now();
+
+    std::vector<std::pair<IKConstraintSystem*, Rig*>> active;
+    int waveCount = 0;
+    size_t threshold = 0;
+    for (const auto& entry : systems) {
+        if (!entry.first || !entry.first->prepare(entry.second)) continue;
+        active.push_back(entry);
+        waveCount = std::max(waveCount, entry.first->m_waveCount);
+        threshold = std::max(threshold, entry.first->m_parallelThreshold);
+    }
+
+    WorkerPool& pool = WorkerPool::shared();
+    const size_t hardware = pool.getHelperThreadCount() + 1;
+    std::vector<Job*> waveJobs;
+    for (int wave = 0; wave < waveCount; ++wave) {
+        // Bones cache world transforms lazily, so anything that reads them stays on this thread
+        waveJobs.clear();
+        for (const auto& entry : active) {
+            entry.first->loadWave(wave);
+            for (auto& job : entry.first->m_jobs) {
+                if (job->wave == wave) waveJobs.push_back(job.get());
+            }
+        }
+
+        // Workspaces share nothing, so solving is the part that can fan out
+        auto solveRange = [&waveJobs](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                Job& job = *waveJobs[i];
+                if (job.targets.size() > 1) {
+                    job.solver.solveWorkspaceDLS(job.workspace, job.effectorJoints, job.targets, job.weights, job.settings);
+                } else {
+                    job.solver.solveWorkspace(job.workspace, job.targets[0], job.settings);
+                }
+            }
+        };
+
+        size_t workers = std::min<size_t>(hardware, waveJobs.size());
+        if (workers < 2 || waveJobs.size() < threshold) {
+            solveRange(0, waveJobs.size());
+        } else {
+            // Persistent helpers from the shared pool; no threads are started per wave
+            const size_t perWorker = (waveJobs.size() + workers - 1) / workers;
+            const size_t batches = (waveJobs.size() + perWorker - 1) / perWorker;
+            pool.run(batches, [&](size_t batch) {
+                solveRange(batch * perWorker, std::min((batch + 1) * perWorker, waveJobs.size()));
+            });
+        }
+
+        for (const auto& entry : active) {
+            entry.first->commitWave(wave);
+        }
+    }
+
+    double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    for (const auto& entry : active) {
+        entry.first->m_lastSolveMilliseconds = milliseconds;
+    }
+}
+
+bool IKConstraintSystem::getAnimatedLocalRotation(const std::string& boneName, float& rotation) const {
+    for (const auto& job : m_jobs) {
+        if (!job->hasWritten) continue;
+        for (size_t i = 0; i < job->chain.size(); ++i) {
+            if (job->chain[i]->getName() != boneName) continue;
+
+            // Only if nothing re-posed the bone since our write-back
+            if (job->chain[i]->getLocalTransform().rotation != job->writtenRotations[i]) return false;
+            rotation = job->inputRotations[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace Riggle
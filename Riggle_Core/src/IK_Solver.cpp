@@ -3,31 +3,294 @@
 #include "Riggle/Bone.h"
 #include <cmath>
 #include <algorithm>
+#include <chrono>
 
 namespace Riggle {
 
-bool IKSolver::solveCCD(Rig* rig,std::shared_ptr<Bone> endEffector, const Vector2& targetPos, int chainLength, int maxIterations, float tolerance) {
+void IKChainWorkspace::load(const std::vector<std::shared_ptr<Bone>>& bones, const std::vector<float>* startRotations) {
+    const size_t count = bones.size();
+    m_bones = bones;
+    m_parent.assign(count, -1);
+    m_local.resize(count);
+    m_world.resize(count);
+    m_parentWorld.resize(count);
+    m_limits.resize(count);
+    m_originalRotation.resize(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        auto parent = bones[i]->getParent();
+
+        // Parents come first, so a parent inside the workspace has a lower index
+        for (size_t j = i; j-- > 0;) {
+            if (bones[j] == parent) {
+                m_parent[i] = static_cast<int>(j);
+                break;
+            }
+        }
+        m_parentWorld[i] = (m_parent[i] < 0 && parent) ? parent->getWorldTransform() : Transform();
+
+        m_local[i] = bones[i]->getLocalTransform();
+        m_limits[i] = bones[i]->getRotationLimits();
+        m_originalRotation[i] = m_local[i].rotation;
+        if (startRotations) m_local[i].rotation = (*startRotations)[i];
+    }
+    updateFrom(0);
+}
+
+void IKChainWorkspace::loadTransforms(const std::vector<int>& parents, const std::vector<Transform>& locals,
+                                      const std::vector<Transform>& parentWorlds,
+                                      const std::vector<BoneRotationLimits>& limits) {
+    m_bones.clear(); // Nothing to write back, read the result with getLocalTransform()
+    m_parent = parents;
+    m_local = locals;
+    m_parentWorld = parentWorlds;
+    m_limits = limits;
+    m_world.resize(locals.size());
+    m_originalRotation.resize(locals.size());
+    for (size_t i = 0; i < locals.size(); ++i) {
+        m_originalRotation[i] = locals[i].rotation;
+    }
+    updateFrom(0);
+}
+
+void IKChainWorkspace::writeBack() {
+    // One setLocalTransform per changed joint (this dirties subtrees and fires events)
+    for (size_t i = 0; i < m_bones.size(); ++i) {
+        if (m_local[i].rotation != m_originalRotation[i]) {
+            m_bones[i]->setLocalTransform(m_local[i]);
+            m_originalRotation[i] = m_local[i].rotation;
+        }
+    }
+}
+
+Vector2 IKChainWorkspace::getTipPosition(size_t index) const {
+    // Same tip as Bone::getWorldEndpoints
+    const Transform& world = m_world[index];
+    return Vector2(world.position.x + world.length * std::cos(world.rotation) * world.scale.x,
+                   world.position.y + world.length * std::sin(world.rotation) * world.scale.y);
+}
+
+void IKChainWorkspace::rotateJoint(size_t index, float deltaAngle) {
+    setJointRotation(index, m_local[index].rotation + deltaAngle);
+}
+
+void IKChainWorkspace::setJointRotation(size_t index, float localRotation) {
+    m_local[index].rotation = m_limits[index].clamp(localRotation);
+    updateFrom(index);
+}
+
+void IKChainWorkspace::rotateAllJoints(const float* deltaAngles) {
+    for (size_t i = 0; i < m_local.size(); ++i) {
+        m_local[i].rotation = m_limits[i].clamp(m_local[i].rotation + deltaAngles[i]);
+    }
+    updateFrom(0);
+}
+
+void IKChainWorkspace::updateFrom(size_t index) {
+    // Everything after index in parent-first order covers all of its descendants
+    for (size_t i = index; i < m_local.size(); ++i) {
+        const int parent = m_parent[i];
+        m_world[i] = combineTransforms(parent >= 0 ? m_world[parent] : m_parentWorld[i], m_local[i]);
+    }
+}
+
+bool IKSolver::solve(Rig* rig, std::shared_ptr<Bone> endEffector, const Vector2& targetPos, int chainLength,
+                     const IKSolveSettings& settings) {
+    m_lastStats = IKSolveStats();
+    m_lastStats.type = settings.type;
+
     if (!endEffector) return false;
 
     auto validation = validateChain(endEffector, chainLength);
     if (!validation.isValid) return false;
 
-    std::vector<std::shared_ptr<Bone>> chain = validation.chain;
+    return solveChain(rig, validation.chain, targetPos, settings);
+}
+
+bool IKSolver::solveChain(Rig* rig, const std::vector<std::shared_ptr<Bone>>& chain, const Vector2& targetPos,
+                          const IKSolveSettings& settings, const std::vector<float>* startRotations) {
+    m_lastStats = IKSolveStats();
+    m_lastStats.type = settings.type;
     if (chain.size() < 2) return false; // Need at least one bone to rotate and an end-effector.
 
-    for (int iteration = 0; iteration < maxIterations; ++iteration) {
-        Vector2 endPos = getBoneWorldEndPosition(endEffector);
-        if ((targetPos - endPos).length() < tolerance) {
-            return true; // Success
+    // Solve on a chain-local copy, the rig is only touched by the final write-back
+    if (startRotations && startRotations->size() != chain.size()) startRotations = nullptr;
+    m_workspace.load(chain, startRotations);
+    bool reached = solveWorkspace(m_workspace, targetPos, settings);
+
+    m_workspace.writeBack();
+    if (rig) rig->forceUpdateWorldTransforms();
+    return reached;
+}
+
+void IKSolver::startBudget(const IKSolveSettings& settings) {
+    m_hasDeadline = settings.maxMilliseconds > 0.0f;
+    if (m_hasDeadline) {
+        auto budget = std::chrono::duration<double, std::milli>(settings.maxMilliseconds);
+        m_deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(budget);
+    }
+}
+
+bool IKSolver::solveWorkspace(IKChainWorkspace& workspace, const Vector2& targetPos, const IKSolveSettings& settings) {
+    auto startTime = std::chrono::steady_clock::now();
+    m_lastStats = IKSolveStats();
+    m_lastStats.type = settings.type;
+
+    const size_t count = workspace.size();
+    if (count < 2) return false;
+    startBudget(settings);
+    if (settings.type == IKSolverType::DLS && count > static_cast<size_t>(MaxDLSJoints)) return false;
+
+    // Arms and legs: exact closed-form solve, no iterations
+    IKSolverType type = settings.type;
+    if (count == 2) {
+        type = IKSolverType::TwoBone;
+    } else if (type == IKSolverType::TwoBone) {
+        type = IKSolverType::CCD;
+    }
+    m_lastStats.type = type;
+
+    int iterations = 0;
+    switch (type) {
+        case IKSolverType::TwoBone:
+            solveTwoBoneAnalytic(workspace, targetPos, settings.bendDirection);
+            iterations = 1;
+            break;
+        case IKSolverType::FABRIK:
+            iterations = iterateFABRIK(workspace, targetPos, settings.maxIterations, settings.tolerance);
+            break;
+        case IKSolverType::DLS: {
+            const int endJoint = static_cast<int>(count) - 1;
+            const float weight = 1.0f;
+            iterations = iterateDLS(workspace, &endJoint, &targetPos, &weight, 1,
+                                    settings.maxIterations, settings.tolerance, settings.damping);
+            break;
         }
+        case IKSolverType::CCD:
+        default:
+            iterations = iterateCCD(workspace, targetPos, settings.maxIterations, settings.tolerance);
+            break;
+    }
+
+    m_lastStats.chainLength = static_cast<int>(count);
+    m_lastStats.iterations = iterations;
+    m_lastStats.error = (targetPos - workspace.getEndPosition()).length();
+    m_lastStats.reached = m_lastStats.error < settings.tolerance;
+    m_lastStats.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    return m_lastStats.reached;
+}
+
+bool IKSolver::solveWorkspaceDLS(IKChainWorkspace& workspace, const std::vector<int>& effectorJoints,
+                                 const std::vector<Vector2>& targets, const std::vector<float>& weights,
+                                 const IKSolveSettings& settings) {
+    auto startTime = std::chrono::steady_clock::now();
+    m_lastStats = IKSolveStats();
+    m_lastStats.type = IKSolverType::DLS;
+
+    const size_t effectorCount = effectorJoints.size();
+    if (effectorCount == 0 || effectorCount > static_cast<size_t>(MaxDLSEffectors) ||
+        targets.size() != effectorCount || weights.size() != effectorCount) return false;
+    if (workspace.size() < 2 || workspace.size() > static_cast<size_t>(MaxDLSJoints)) return false;
+    startBudget(settings);
+
+    int iterations = iterateDLS(workspace, effectorJoints.data(), targets.data(), weights.data(),
+                                static_cast<int>(effectorCount), settings.maxIterations, settings.tolerance, settings.damping);
+
+    m_lastStats.chainLength = static_cast<int>(workspace.size());
+    m_lastStats.iterations = iterations;
+    for (size_t k = 0; k < effectorCount; ++k) {
+        m_lastStats.error = std::max(m_lastStats.error, (targets[k] - workspace.getTipPosition(effectorJoints[k])).length());
+    }
+    m_lastStats.reached = m_lastStats.error < settings.tolerance;
+    m_lastStats.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    return m_lastStats.reached;
+}
+
+bool IKSolver::solveCCD(Rig* rig,std::shared_ptr<Bone> endEffector, const Vector2& targetPos, int chainLength, int maxIterations, float tolerance) {
+    IKSolveSettings settings;
+    settings.type = IKSolverType::CCD;
+    settings.maxIterations = maxIterations;
+    settings.tolerance = tolerance;
+    return solve(rig, endEffector, targetPos, chainLength, settings);
+}
+
+bool IKSolver::solveFABRIK(Rig* rig, std::shared_ptr<Bone> endEffector, const Vector2& targetPos, int chainLength, int maxIterations, float tolerance) {
+    IKSolveSettings settings;
+    settings.type = IKSolverType::FABRIK;
+    settings.maxIterations = maxIterations;
+    settings.tolerance = tolerance;
+    return solve(rig, endEffector, targetPos, chainLength, settings);
+}
+
+bool IKSolver::solveTwoBone(Rig* rig, std::shared_ptr<Bone> endEffector, const Vector2& targetPos, int bendDirection) {
+    IKSolveSettings settings;
+    settings.type = IKSolverType::TwoBone;
+    settings.bendDirection = bendDirection;
+    return solve(rig, endEffector, targetPos, 2, settings);
+}
+
+bool IKSolver::solveDLS(Rig* rig, const std::vector<IKEffectorTarget>& effectors, int chainLength,
+                        const IKSolveSettings& settings) {
+    m_lastStats = IKSolveStats();
+    m_lastStats.type = IKSolverType::DLS;
+    if (effectors.empty() || effectors.size() > static_cast<size_t>(MaxDLSEffectors)) return false;
+
+    std::vector<std::shared_ptr<Bone>> effectorBones;
+    std::vector<Vector2> targets;
+    std::vector<float> weights;
+    for (const auto& effector : effectors) {
+        effectorBones.push_back(effector.bone);
+        targets.push_back(effector.target);
+        weights.push_back(effector.weight);
+    }
+
+    std::vector<std::shared_ptr<Bone>> bones;
+    std::vector<int> effectorJoints;
+    if (!buildEffectorTree(effectorBones, chainLength, bones, effectorJoints)) return false;
+
+    m_workspace.load(bones);
+    bool reached = solveWorkspaceDLS(m_workspace, effectorJoints, targets, weights, settings);
+
+    m_workspace.writeBack();
+    if (rig) rig->forceUpdateWorldTransforms();
+    return reached;
+}
+
+const char* IKSolver::getSolverName(IKSolverType type) {
+    switch (type) {
+        case IKSolverType::CCD: return "CCD";
+        case IKSolverType::FABRIK: return "FABRIK";
+        case IKSolverType::TwoBone: return "Two-Bone";
+        case IKSolverType::DLS: return "DLS";
+    }
+    return "CCD";
+}
+
+bool IKSolver::getSolverType(const std::string& name, IKSolverType& type) {
+    for (IKSolverType candidate : {IKSolverType::CCD, IKSolverType::FABRIK, IKSolverType::TwoBone, IKSolverType::DLS}) {
+        if (name == getSolverName(candidate)) {
+            type = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+int IKSolver::iterateCCD(IKChainWorkspace& workspace, const Vector2& targetPos, int maxIterations, float tolerance) {
+    const int count = static_cast<int>(workspace.size());
+
+    int iteration = 0;
+    for (; iteration < maxIterations; ++iteration) {
+        if ((targetPos - workspace.getEndPosition()).length() < tolerance) {
+            break; // Success
+        }
+        if (iteration > 0 && outOfTime()) break;
 
-        // Iterate backwards from the end-effector's parent up the chain.**
         // The chain is ordered [Root-of-chain, ..., Parent, EndEffector].
-        // So we loop from chain.size() - 2 down to 0.
-        for (int i = chain.size() - 1; i >= 0; --i) {
-            std::shared_ptr<Bone> currentBone = chain[i];
-            Vector2 jointPos = getBoneWorldPosition(currentBone);
-            Vector2 currentEndPos = getBoneWorldEndPosition(endEffector);
+        // Rotate from the end-effector back up to the chain root.
+        for (int i = count - 1; i >= 0; --i) {
+            Vector2 jointPos = workspace.getJointPosition(i);
+            Vector2 currentEndPos = workspace.getEndPosition();
 
             Vector2 toEnd = currentEndPos - jointPos;
             Vector2 toTarget = targetPos - jointPos;
@@ -37,30 +300,264 @@ bool IKSolver::solveCCD(Rig* rig,std::shared_ptr<Bone> endEffector, const Vector
                 continue;
             }
 
-            toEnd = toEnd.normalized();
-            toTarget = toTarget.normalized();
-            float dot = std::max(-1.0f, std::min(1.0f, toEnd.dot(toTarget)));
-            
-            // Skip if already aligned
-            if (dot > 0.9999f) {
-                continue;
+            // atan2 stays accurate for the small corrections near convergence, where an
+            // acos of the dot product rounds to zero and the chain stalls short of the target
+            float angle = std::atan2(toEnd.cross(toTarget), toEnd.dot(toTarget));
+
+            if (std::abs(angle) > 1e-6f) {
+                // Only this joint and the bones below it in the chain are refreshed
+                workspace.rotateJoint(i, angle);
             }
+        }
+    }
+
+    return iteration;
+}
+
+int IKSolver::iterateFABRIK(IKChainWorkspace& workspace, const Vector2& targetPos, int maxIterations, float tolerance) {
+    const size_t count = workspace.size();
+
+    // Joints are the chain heads plus the end-effector tip
+    m_joints.resize(count + 1);
+    m_segmentLengths.resize(count);
+    float totalLength = 0.0f;
+    for (size_t i = 0; i < count; ++i) {
+        m_joints[i] = workspace.getJointPosition(i);
+    }
+    m_joints[count] = workspace.getEndPosition();
+    for (size_t i = 0; i < count; ++i) {
+        m_segmentLengths[i] = (m_joints[i + 1] - m_joints[i]).length();
+        totalLength += m_segmentLengths[i];
+    }
+
+    const Vector2 base = m_joints[0];
+    int iteration = 0;
 
-            float angle = std::acos(dot);
-            if (toEnd.cross(toTarget) < 0) {
-                angle = -angle;
+    if ((targetPos - base).length() >= totalLength) {
+        // Out of reach - stretch the chain straight toward the target
+        Vector2 direction = (targetPos - base).normalized();
+        for (size_t i = 0; i < count; ++i) {
+            m_joints[i + 1] = m_joints[i] + direction * m_segmentLengths[i];
+        }
+        iteration = 1;
+    } else {
+        for (; iteration < maxIterations; ++iteration) {
+            if ((targetPos - m_joints[count]).length() < tolerance) break;
+            if (iteration > 0 && outOfTime()) break;
+
+            // Backward pass: pin the tip to the target
+            m_joints[count] = targetPos;
+            for (size_t i = count; i-- > 0;) {
+                Vector2 direction = (m_joints[i] - m_joints[i + 1]).normalized();
+                m_joints[i] = m_joints[i + 1] + direction * m_segmentLengths[i];
             }
 
-            if (std::abs(angle) > 0.0001f) {
-                // After rotating a bone, we MUST update the world transforms
-                // of all bones so the next calculation is accurate.
-                applyRotationToBone(currentBone, angle);
-                if (i > 0) rig->forceUpdateWorldTransforms();
+            // Forward pass: pin the base back in place
+            m_joints[0] = base;
+            for (size_t i = 0; i < count; ++i) {
+                Vector2 direction = (m_joints[i + 1] - m_joints[i]).normalized();
+                m_joints[i + 1] = m_joints[i] + direction * m_segmentLengths[i];
             }
         }
     }
 
-    return (targetPos - getBoneWorldEndPosition(endEffector)).length() < tolerance;
+    // Back to joint rotations: turn each segment onto its solved direction.
+    // Measured on the workspace so bone offsets and parent rotations are respected.
+    for (size_t i = 0; i < count; ++i) {
+        alignSegment(workspace, i, m_joints[i + 1]);
+    }
+
+    return iteration;
+}
+
+namespace {
+
+// Four partial sums, one per lane of a joint block, so the loop vectorises
+// without reassociating the float additions
+float dotBlocks(const float* a, const float* b, int padded) {
+    float sum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    for (int j = 0; j < padded; j += 4) {
+        for (int l = 0; l < 4; ++l) sum[l] += a[j + l] * b[j + l];
+    }
+    return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+}
+
+} // namespace
+
+int IKSolver::iterateDLS(IKChainWorkspace& workspace, const int* effectorJoints, const Vector2* targets, const float* weights,
+                         int effectorCount, int maxIterations, float tolerance, float damping) {
+    const int joints = static_cast<int>(workspace.size());
+    const int rows = effectorCount * 2;
+
+    // Joint loops run over blocks of four lanes, zero-padded past the last joint:
+    // the fixed inner trip count lets GCC vectorise them at -O2
+    const int padded = (joints + 3) & ~3;
+    alignas(16) float jointX[MaxDLSJoints];
+    alignas(16) float jointY[MaxDLSJoints];
+    alignas(16) float influence[MaxDLSEffectors][MaxDLSJoints];
+    alignas(16) float jacobian[MaxDLSEffectors * 2][MaxDLSJoints];
+    alignas(16) float delta[MaxDLSJoints];
+    float system[MaxDLSEffectors * 2][MaxDLSEffectors * 2];
+    float error[MaxDLSEffectors * 2];
+
+    // Which joints move which effector (ancestor-or-self inside the workspace)
+    for (int k = 0; k < effectorCount; ++k) {
+        std::fill(influence[k], influence[k] + padded, 0.0f);
+        for (int j = effectorJoints[k]; j >= 0; j = workspace.getParentIndex(j)) {
+            influence[k][j] = weights[k];
+        }
+    }
+    std::fill(jointX + joints, jointX + padded, 0.0f);
+    std::fill(jointY + joints, jointY + padded, 0.0f);
+
+    // Limit the per-iteration correction so linearization stays valid
+    float reach = 0.0f;
+    for (int j = 0; j < joints; ++j) {
+        reach += (workspace.getTipPosition(j) - workspace.getJointPosition(j)).length();
+    }
+    const float maxStep = std::max(tolerance, reach * 0.25f);
+    const float lambdaSquared = damping * damping;
+
+    int iteration = 0;
+    for (; iteration < maxIterations; ++iteration) {
+        float worstError = 0.0f;
+        Vector2 tips[MaxDLSEffectors];
+        for (int k = 0; k < effectorCount; ++k) {
+            tips[k] = workspace.getTipPosition(effectorJoints[k]);
+            Vector2 offset = targets[k] - tips[k];
+            const float distance = offset.length();
+            worstError = std::max(worstError, distance);
+            if (distance > maxStep) offset = offset * (maxStep / distance);
+            error[2 * k] = offset.x * weights[k];
+            error[2 * k + 1] = offset.y * weights[k];
+        }
+        if (worstError < tolerance) break;
+        if (iteration > 0 && outOfTime()) break;
+
+        for (int j = 0; j < joints; ++j) {
+            const Vector2 joint = workspace.getJointPosition(j);
+            jointX[j] = joint.x;
+            jointY[j] = joint.y;
+        }
+
+        // Jacobian rows: d(tip)/d(theta_j) = perp(tip - joint_j) for the joints that move the tip
+        for (int k = 0; k < effectorCount; ++k) {
+            float* rowX = jacobian[2 * k];
+            float* rowY = jacobian[2 * k + 1];
+            const float* mask = influence[k];
+            const float tipX = tips[k].x;
+            const float tipY = tips[k].y;
+            for (int j = 0; j < padded; j += 4) {
+                for (int l = 0; l < 4; ++l) {
+                    rowX[j + l] = (jointY[j + l] - tipY) * mask[j + l];
+                    rowY[j + l] = (tipX - jointX[j + l]) * mask[j + l];
+                }
+            }
+        }
+
+        // (J J^T + lambda^2 I) y = e, at most 8x8
+        for (int a = 0; a < rows; ++a) {
+            for (int b = 0; b <= a; ++b) {
+                system[a][b] = system[b][a] = dotBlocks(jacobian[a], jacobian[b], padded);
+            }
+            system[a][a] += lambdaSquared;
+        }
+
+        // Cholesky decomposition in place (lower triangle), then forward/back substitution
+        bool solvable = true;
+        for (int a = 0; a < rows && solvable; ++a) {
+            for (int b = 0; b <= a; ++b) {
+                float sum = system[a][b];
+                for (int c = 0; c < b; ++c) sum -= system[a][c] * system[b][c];
+                if (a == b) {
+                    if (sum <= 1e-12f) { solvable = false; break; }
+                    system[a][a] = std::sqrt(sum);
+                } else {
+                    system[a][b] = sum / system[b][b];
+                }
+            }
+        }
+        if (!solvable) break;
+
+        for (int a = 0; a < rows; ++a) {
+            float sum = error[a];
+            for (int c = 0; c < a; ++c) sum -= system[a][c] * error[c];
+            error[a] = sum / system[a][a];
+        }
+        for (int a = rows - 1; a >= 0; --a) {
+            float sum = error[a];
+            for (int c = a + 1; c < rows; ++c) sum -= system[c][a] * error[c];
+            error[a] = sum / system[a][a];
+        }
+
+        // delta theta = J^T y
+        for (int j = 0; j < padded; j += 4) {
+            for (int l = 0; l < 4; ++l) delta[j + l] = 0.0f;
+        }
+        for (int a = 0; a < rows; ++a) {
+            const float y = error[a];
+            const float* row = jacobian[a];
+            for (int j = 0; j < padded; j += 4) {
+                for (int l = 0; l < 4; ++l) delta[j + l] += row[j + l] * y;
+            }
+        }
+
+        workspace.rotateAllJoints(delta);
+    }
+
+    return iteration;
+}
+
+void IKSolver::solveTwoBoneAnalytic(IKChainWorkspace& workspace, const Vector2& targetPos, int bendDirection) {
+    const Vector2 root = workspace.getJointPosition(0);
+    const Vector2 joint = workspace.getJointPosition(1);
+    const Vector2 tip = workspace.getEndPosition();
+
+    const float upper = (joint - root).length();
+    const float lower = (tip - joint).length();
+    if (upper < 0.0001f || lower < 0.0001f) return;
+
+    // Keep the current bend side unless one is forced
+    float side = bendDirection > 0 ? 1.0f : (bendDirection < 0 ? -1.0f : 0.0f);
+    if (side == 0.0f) {
+        side = (joint - root).cross(tip - joint) < 0.0f ? -1.0f : 1.0f;
+    }
+
+    // Clamp reach so the triangle always exists
+    Vector2 toTarget = targetPos - root;
+    float distance = toTarget.length();
+    float baseAngle = distance > 0.0001f ? std::atan2(toTarget.y, toTarget.x)
+                                         : std::atan2(tip.y - root.y, tip.x - root.x);
+    distance = std::max(std::abs(upper - lower), std::min(distance, upper + lower));
+
+    // Law of cosines for the angle at the root, bending toward 'side'
+    float cosRoot = distance > 0.0001f ? (upper * upper + distance * distance - lower * lower) / (2.0f * upper * distance) : 1.0f;
+    float rootAngle = baseAngle - side * std::acos(std::max(-1.0f, std::min(1.0f, cosRoot)));
+
+    Vector2 desiredJoint = root + Vector2(std::cos(rootAngle), std::sin(rootAngle)) * upper;
+    alignSegment(workspace, 0, desiredJoint);
+
+    // Lower bone points at the target (or as far toward it as it reaches)
+    Vector2 solvedJoint = workspace.getJointPosition(1);
+    Vector2 toTip = targetPos - solvedJoint;
+    if (toTip.lengthSquared() > 0.000001f) {
+        alignSegment(workspace, 1, solvedJoint + toTip.normalized() * lower);
+    }
+}
+
+void IKSolver::alignSegment(IKChainWorkspace& workspace, size_t index, const Vector2& desiredEnd) {
+    // Rotate joint 'index' so its segment (head to next head, or tip) points at desiredEnd.
+    // Measured on the workspace so bone offsets and parent rotations are respected.
+    Vector2 head = workspace.getJointPosition(index);
+    Vector2 end = index + 1 < workspace.size() ? workspace.getJointPosition(index + 1) : workspace.getEndPosition();
+    Vector2 current = end - head;
+    Vector2 desired = desiredEnd - head;
+    if (current.lengthSquared() < 0.000001f || desired.lengthSquared() < 0.000001f) return;
+
+    float angle = getAngleBetweenVectors(current, desired);
+    if (std::abs(angle) > 0.0001f) {
+        workspace.rotateJoint(index, angle);
+    }
 }
 
 std::vector<std::shared_ptr<Bone>> IKSolver::buildChain(std::shared_ptr<Bone> endEffector, int chainLength) {
@@ -104,6 +601,29 @@ IKChainValidation IKSolver::validateChain(std::shared_ptr<Bone> endEffector, int
     return {true, "Valid chain", maxPossibleLength, chain};
 }
 
+bool IKSolver::buildEffectorTree(const std::vector<std::shared_ptr<Bone>>& effectors, int chainLength,
+                                 std::vector<std::shared_ptr<Bone>>& bones, std::vector<int>& effectorJoints) {
+    bones.clear();
+    effectorJoints.clear();
+    for (const auto& effector : effectors) {
+        auto validation = validateChain(effector, chainLength);
+        if (!validation.isValid || validation.chain.size() < 2) return false;
+        for (const auto& bone : validation.chain) {
+            if (std::find(bones.begin(), bones.end(), bone) == bones.end()) bones.push_back(bone);
+        }
+    }
+    if (bones.size() > static_cast<size_t>(MaxDLSJoints)) return false;
+
+    // Shallower bones first keeps every parent ahead of its children
+    std::stable_sort(bones.begin(), bones.end(), [this](const std::shared_ptr<Bone>& a, const std::shared_ptr<Bone>& b) {
+        return getDistanceToRoot(a) < getDistanceToRoot(b);
+    });
+    for (const auto& effector : effectors) {
+        effectorJoints.push_back(static_cast<int>(std::find(bones.begin(), bones.end(), effector) - bones.begin()));
+    }
+    return true;
+}
+
 Vector2 IKSolver::getBoneWorldPosition(std::shared_ptr<Bone> bone) {
     if (!bone) return Vector2(0, 0);
     
@@ -143,17 +663,4 @@ int IKSolver::getDistanceToRoot(std::shared_ptr<Bone> bone) {
     return distance;
 }
 
-void IKSolver::applyRotationToBone(std::shared_ptr<Bone> bone, float deltaAngle) {
-    if (!bone) return;
-    
-    // Get current local transform
-    Transform localTransform = bone->getLocalTransform();
-    
-    // Add delta angle to current rotation
-    localTransform.rotation += deltaAngle;
-    
-    // Set the updated transform
-    bone->setLocalTransform(localTransform);
-}
-
 }
\ No newline at end of file
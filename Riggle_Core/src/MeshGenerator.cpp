@@ -0,0 +1,517 @@
+#include "Riggle/MeshGenerator.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace Riggle {
+
+namespace {
+
+float signedArea(const std::vector<Vector2>& polygon) {
+    float area = 0.0f;
+    for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+        area += polygon[j].cross(polygon[i]);
+    }
+    return area * 0.5f;
+}
+
+float distanceToLine(const Vector2& p, const Vector2& a, const Vector2& b) {
+    Vector2 ab = b - a;
+    float length = ab.length();
+    if (length < 1e-6f) return (p - a).length();
+    return std::abs(ab.cross(p - a)) / length;
+}
+
+// Douglas-Peucker on an open polyline, keeps first and last point
+void douglasPeucker(const std::vector<Vector2>& points, size_t first, size_t last, float epsilon,
+                    std::vector<bool>& keep) {
+    if (last <= first + 1) return;
+
+    float maxDistance = 0.0f;
+    size_t index = first;
+    for (size_t i = first + 1; i < last; ++i) {
+        float distance = distanceToLine(points[i], points[first], points[last]);
+        if (distance > maxDistance) {
+            maxDistance = distance;
+            index = i;
+        }
+    }
+
+    if (maxDistance > epsilon) {
+        keep[index] = true;
+        douglasPeucker(points, first, index, epsilon, keep);
+        douglasPeucker(points, index, last, epsilon, keep);
+    }
+}
+
+bool segmentsIntersect(const Vector2& a, const Vector2& b, const Vector2& c, const Vector2& d) {
+    float d1 = (b - a).cross(c - a);
+    float d2 = (b - a).cross(d - a);
+    float d3 = (d - c).cross(a - c);
+    float d4 = (d - c).cross(b - c);
+    return ((d1 > 0.0f) != (d2 > 0.0f)) && ((d3 > 0.0f) != (d4 > 0.0f)) &&
+           d1 != 0.0f && d2 != 0.0f && d3 != 0.0f && d4 != 0.0f;
+}
+
+bool pointInTriangle(const Vector2& p, const Vector2& a, const Vector2& b, const Vector2& c) {
+    // Counter-clockwise triangle (positive area), boundary counts as inside
+    return (b - a).cross(p - a) >= 0.0f && (c - b).cross(p - b) >= 0.0f && (a - c).cross(p - c) >= 0.0f;
+}
+
+float distanceToSegment(const Vector2& p, const Vector2& a, const Vector2& b) {
+    Vector2 ab = b - a;
+    float lengthSquared = ab.lengthSquared();
+    float t = lengthSquared > 1e-12f ? std::clamp((p - a).dot(ab) / lengthSquared, 0.0f, 1.0f) : 0.0f;
+    return (p - (a + ab * t)).length();
+}
+
+// Even-odd rule, points on the outline count as inside
+bool pointInPolygon(const Vector2& p, const std::vector<Vector2>& polygon) {
+    bool inside = false;
+    for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+        const Vector2& a = polygon[j];
+        const Vector2& b = polygon[i];
+        if (distanceToSegment(p, a, b) < 1e-3f) return true;
+        if ((a.y > p.y) != (b.y > p.y) && p.x < a.x + (b.x - a.x) * (p.y - a.y) / (b.y - a.y)) {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+// Every corner of every listed pixel must be inside, so no opaque texel is even partly cut
+bool coversPixels(const std::vector<Vector2>& polygon, const std::vector<std::pair<int, int>>& pixels) {
+    for (const auto& pixel : pixels) {
+        const float x = static_cast<float>(pixel.first);
+        const float y = static_cast<float>(pixel.second);
+        if (!pointInPolygon(Vector2(x, y), polygon) || !pointInPolygon(Vector2(x + 1.0f, y), polygon) ||
+            !pointInPolygon(Vector2(x, y + 1.0f), polygon) || !pointInPolygon(Vector2(x + 1.0f, y + 1.0f), polygon)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+SpriteMesh MeshGenerator::generateFromAlpha(const unsigned char* pixels, unsigned int width, unsigned int height,
+                                            const MeshGeneratorSettings& settings) {
+    const int w = static_cast<int>(width);
+    const int h = static_cast<int>(height);
+    const float fw = static_cast<float>(width);
+    const float fh = static_cast<float>(height);
+    SpriteMesh quad = SpriteMesh::createGrid(fw, fh, 1, 1);
+    if (!pixels || w == 0 || h == 0) return quad;
+
+    // Opaque mask
+    std::vector<unsigned char> mask(static_cast<size_t>(w) * h);
+    size_t opaqueCount = 0;
+    for (size_t i = 0; i < mask.size(); ++i) {
+        mask[i] = pixels[i * 4 + 3] > settings.alphaThreshold ? 1 : 0;
+        opaqueCount += mask[i];
+    }
+    if (opaqueCount == 0 || opaqueCount == mask.size()) return quad;
+
+    // Label 8-connected components, remember where the first one starts
+    std::vector<int> labels(mask.size(), 0);
+    std::vector<size_t> stack;
+    int componentCount = 0;
+    int startX = -1, startY = -1;
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            size_t seed = static_cast<size_t>(y) * w + x;
+            if (!mask[seed] || labels[seed]) continue;
+
+            ++componentCount;
+            if (componentCount == 1) { startX = x; startY = y; }
+
+            stack.push_back(seed);
+            labels[seed] = componentCount;
+            while (!stack.empty()) {
+                size_t current = stack.back();
+                stack.pop_back();
+                int cx = static_cast<int>(current % w);
+                int cy = static_cast<int>(current / w);
+                for (int dy = -1; dy <= 1; ++dy) {
+                    for (int dx = -1; dx <= 1; ++dx) {
+                        int nx = cx + dx, ny = cy + dy;
+                        if (nx < 0 || ny < 0 || nx >= w || ny >= h) continue;
+                        size_t n = static_cast<size_t>(ny) * w + nx;
+                        if (mask[n] && !labels[n]) {
+                            labels[n] = componentCount;
+                            stack.push_back(n);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // Outline in pixel-corner space. Contour points are pixel centers, so they sit half a pixel inside.
+    std::vector<Vector2> outline;
+    bool useHull = componentCount > 1;
+    if (!useHull) {
+        outline = traceContour(mask, w, h, startX, startY);
+        for (auto& p : outline) {
+            p = p + Vector2(0.5f, 0.5f);
+        }
+        useHull = outline.size() < 3;
+    }
+
+    std::vector<Vector2> hull;
+    {
+        // Hull over the outer corners of each row's opaque span
+        std::vector<Vector2> corners;
+        for (int y = 0; y < h; ++y) {
+            int minX = -1, maxX = -1;
+            for (int x = 0; x < w; ++x) {
+                if (mask[static_cast<size_t>(y) * w + x]) {
+                    if (minX < 0) minX = x;
+                    maxX = x;
+                }
+            }
+            if (minX < 0) continue;
+            corners.emplace_back(static_cast<float>(minX), static_cast<float>(y));
+            corners.emplace_back(static_cast<float>(minX), static_cast<float>(y + 1));
+            corners.emplace_back(static_cast<float>(maxX + 1), static_cast<float>(y));
+            corners.emplace_back(static_cast<float>(maxX + 1), static_cast<float>(y + 1));
+        }
+        hull = convexHull(corners);
+    }
+
+    // Opaque pixels next to an empty one or the texture border. A simple polygon
+    // holding all of them holds the whole shape.
+    std::vector<std::pair<int, int>> edgePixels;
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            if (!mask[static_cast<size_t>(y) * w + x]) continue;
+            if (x == 0 || y == 0 || x == w - 1 || y == h - 1 ||
+                !mask[static_cast<size_t>(y) * w + x - 1] || !mask[static_cast<size_t>(y) * w + x + 1] ||
+                !mask[static_cast<size_t>(y - 1) * w + x] || !mask[static_cast<size_t>(y + 1) * w + x]) {
+                edgePixels.emplace_back(x, y);
+            }
+        }
+    }
+
+    // The expansion is only an estimate: grow further while pixels still poke out, and
+    // simplify harder while squared-off spikes push the result over the vertex budget
+    const float extraGrowth[] = { 0.0f, 0.5f, 1.0f, 2.0f };
+    const int budget = std::max(3, settings.maxVertices);
+    std::vector<unsigned int> indices;
+    std::vector<Vector2> polygon;
+    auto fit = [&](const std::vector<Vector2>& source, float margin, bool checkSimple) {
+        for (int target = budget; target >= 3;) {
+            float epsilon = 0.0f;
+            std::vector<Vector2> simplified = simplify(source, target, epsilon);
+            for (float extra : extraGrowth) {
+                polygon = expand(simplified, margin + epsilon + extra, fw, fh);
+                if (polygon.size() < 3 || (checkSimple && !isSimplePolygon(polygon)) ||
+                    !coversPixels(polygon, edgePixels)) {
+                    continue;
+                }
+                if (static_cast<int>(polygon.size()) > budget) break;
+                return triangulate(polygon, indices);
+            }
+            if (static_cast<int>(polygon.size()) <= budget) return false;
+            target -= static_cast<int>(polygon.size()) - budget;
+        }
+        return false;
+    };
+
+    // Outline points are pixel centers, so the margin includes the half pixel diagonal
+    bool covered = !useHull && fit(outline, settings.padding + 0.7072f, true);
+    if (!covered && !fit(hull, settings.padding, false)) {
+        return quad;
+    }
+
+    SpriteMesh mesh = buildMesh(polygon, indices, fw, fh);
+
+    // Not worth extra vertices if it barely saves anything
+    if (computeCoverage(mesh, fw, fh) > 0.95f) {
+        return quad;
+    }
+    return mesh;
+}
+
+float MeshGenerator::computeCoverage(const SpriteMesh& mesh, float width, float height) {
+    if (width <= 0.0f || height <= 0.0f) return 1.0f;
+
+    float area = 0.0f;
+    for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+        const Vector2& a = mesh.vertices[mesh.indices[i]];
+        const Vector2& b = mesh.vertices[mesh.indices[i + 1]];
+        const Vector2& c = mesh.vertices[mesh.indices[i + 2]];
+        area += std::abs((b - a).cross(c - a)) * 0.5f;
+    }
+    return area / (width * height);
+}
+
+std::vector<Vector2> MeshGenerator::traceContour(const std::vector<unsigned char>& mask, int width, int height,
+                                                 int startX, int startY) {
+    // Moore neighbourhood, clockwise on screen starting west
+    static const int dx[8] = {-1, -1, 0, 1, 1, 1, 0, -1};
+    static const int dy[8] = {0, -1, -1, -1, 0, 1, 1, 1};
+
+    auto filled = [&](int x, int y) {
+        return x >= 0 && y >= 0 && x < width && y < height && mask[static_cast<size_t>(y) * width + x];
+    };
+    auto directionOf = [](int ox, int oy) {
+        for (int i = 0; i < 8; ++i) {
+            if (dx[i] == ox && dy[i] == oy) return i;
+        }
+        return 0;
+    };
+
+    std::vector<Vector2> contour;
+    contour.emplace_back(static_cast<float>(startX), static_cast<float>(startY));
+
+    // Raster-scan start: the west neighbour is always empty
+    int cx = startX, cy = startY;
+    int backtrack = 0;
+    const int startBacktrack = backtrack;
+    const size_t maxSteps = static_cast<size_t>(width) * height * 4;
+
+    for (size_t step = 0; step < maxSteps; ++step) {
+        int found = -1;
+        for (int k = 1; k <= 8; ++k) {
+            int dir = (backtrack + k) % 8;
+            if (filled(cx + dx[dir], cy + dy[dir])) {
+                found = dir;
+                break;
+            }
+        }
+        if (found < 0) break; // Isolated pixel
+
+        // New backtrack: the empty cell checked just before the hit, seen from the new pixel
+        int prev = (found + 7) % 8;
+        int bx = cx + dx[prev], by = cy + dy[prev];
+        cx += dx[found];
+        cy += dy[found];
+        backtrack = directionOf(bx - cx, by - cy);
+
+        // Jacob's stopping criterion: back at start, entered the same way
+        if (cx == startX && cy == startY && backtrack == startBacktrack) break;
+        contour.emplace_back(static_cast<float>(cx), static_cast<float>(cy));
+    }
+
+    return contour;
+}
+
+std::vector<Vector2> MeshGenerator::convexHull(std::vector<Vector2> points) {
+    if (points.size() < 3) return points;
+
+    std::sort(points.begin(), points.end(), [](const Vector2& a, const Vector2& b) {
+        return a.x < b.x || (a.x == b.x && a.y < b.y);
+    });
+
+    // Andrew's monotone chain
+    std::vector<Vector2> hull(points.size() * 2);
+    size_t k = 0;
+    for (size_t i = 0; i < points.size(); ++i) {
+        while (k >= 2 && (hull[k - 1] - hull[k - 2]).cross(points[i] - hull[k - 2]) <= 0.0f) --k;
+        hull[k++] = points[i];
+    }
+    for (size_t i = points.size() - 1, lower = k + 1; i > 0; --i) {
+        while (k >= lower && (hull[k - 1] - hull[k - 2]).cross(points[i - 1] - hull[k - 2]) <= 0.0f) --k;
+        hull[k++] = points[i - 1];
+    }
+    hull.resize(k - 1);
+    return hull;
+}
+
+std::vector<Vector2> MeshGenerator::simplify(const std::vector<Vector2>& contour, int maxVertices, float& outEpsilon) {
+    outEpsilon = 0.0f;
+    if (static_cast<int>(contour.size()) <= maxVertices) return contour;
+
+    // Split the closed contour at its farthest point from the start
+    const size_t count = contour.size();
+    size_t split = 0;
+    float farthest = 0.0f;
+    for (size_t i = 1; i < count; ++i) {
+        float distance = (contour[i] - contour[0]).lengthSquared();
+        if (distance > farthest) {
+            farthest = distance;
+            split = i;
+        }
+    }
+
+    std::vector<Vector2> closed(contour);
+    closed.push_back(contour[0]);
+
+    auto run = [&](float epsilon) {
+        std::vector<bool> keep(closed.size(), false);
+        keep[0] = keep[split] = keep[closed.size() - 1] = true;
+        douglasPeucker(closed, 0, split, epsilon, keep);
+        douglasPeucker(closed, split, closed.size() - 1, epsilon, keep);
+
+        std::vector<Vector2> result;
+        for (size_t i = 0; i + 1 < closed.size(); ++i) {
+            if (keep[i]) result.push_back(closed[i]);
+        }
+        return result;
+    };
+
+    // Grow epsilon until within budget, then narrow it down
+    float low = 0.0f, high = 0.5f;
+    std::vector<Vector2> best = run(high);
+    while (static_cast<int>(best.size()) > maxVertices && high < 1e4f) {
+        low = high;
+        high *= 2.0f;
+        best = run(high);
+    }
+    for (int i = 0; i < 8; ++i) {
+        float mid = (low + high) * 0.5f;
+        std::vector<Vector2> candidate = run(mid);
+        if (static_cast<int>(candidate.size()) <= maxVertices) {
+            high = mid;
+            best = std::move(candidate);
+        } else {
+            low = mid;
+        }
+    }
+
+    outEpsilon = high;
+    return best;
+}
+
+std::vector<Vector2> MeshGenerator::expand(const std::vector<Vector2>& polygon, float distance, float width, float height) {
+    const size_t count = polygon.size();
+    if (count < 3) return polygon;
+
+    // Outward side depends on winding
+    float orientation = signedArea(polygon) > 0.0f ? 1.0f : -1.0f;
+
+    std::vector<Vector2> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const Vector2& prev = polygon[(i + count - 1) % count];
+        const Vector2& current = polygon[i];
+        const Vector2& next = polygon[(i + 1) % count];
+
+        Vector2 e1 = (current - prev).normalized();
+        Vector2 e2 = (next - current).normalized();
+        Vector2 n1(e1.y * orientation, -e1.x * orientation);
+        Vector2 n2(e2.y * orientation, -e2.x * orientation);
+
+        Vector2 miter = (n1 + n2).normalized();
+        if (miter.lengthSquared() < 1e-6f) miter = n1;
+        float scale = miter.dot(n1);
+
+        // Full miter keeps both edges 'distance' away. Past 4x on a convex spike the tip
+        // is squared off at 'distance' instead, which costs one extra vertex.
+        Vector2 points[2];
+        int pointCount = 1;
+        float along = e1.dot(miter);
+        if (scale < 0.25f && e1.cross(e2) * orientation > 0.0f && along > 1e-3f) {
+            float slide = distance * (1.0f - scale) / along;
+            points[0] = current + n1 * distance + e1 * slide;
+            points[1] = current + n2 * distance - e2 * slide;
+            pointCount = 2;
+        } else {
+            points[0] = current + miter * (distance / std::max(scale, 1e-3f));
+        }
+
+        for (int k = 0; k < pointCount; ++k) {
+            Vector2 p = points[k];
+            p.x = std::clamp(p.x, 0.0f, width);
+            p.y = std::clamp(p.y, 0.0f, height);
+
+            // Clamping can stack vertices on the texture border
+            if (!result.empty() && (result.back() - p).lengthSquared() < 1e-4f) continue;
+            result.push_back(p);
+        }
+    }
+    if (result.size() > 1 && (result.front() - result.back()).lengthSquared() < 1e-4f) {
+        result.pop_back();
+    }
+
+    return result;
+}
+
+bool MeshGenerator::isSimplePolygon(const std::vector<Vector2>& polygon) {
+    const size_t count = polygon.size();
+    for (size_t i = 0; i < count; ++i) {
+        const Vector2& a = polygon[i];
+        const Vector2& b = polygon[(i + 1) % count];
+        for (size_t j = i + 2; j < count; ++j) {
+            if (i == 0 && j == count - 1) continue; // Adjacent through the wrap
+            if (segmentsIntersect(a, b, polygon[j], polygon[(j + 1) % count])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool MeshGenerator::triangulate(const std::vector<Vector2>& polygon, std::vector<unsigned int>& indices) {
+    const size_t count = polygon.size();
+    if (count < 3) return false;
+
+    // Work in counter-clockwise order (positive area)
+    std::vector<unsigned int> remaining(count);
+    for (size_t i = 0; i < count; ++i) remaining[i] = static_cast<unsigned int>(i);
+    if (signedArea(polygon) < 0.0f) {
+        std::reverse(remaining.begin(), remaining.end());
+    }
+
+    indices.clear();
+    indices.reserve((count - 2) * 3);
+
+    while (remaining.size() > 3) {
+        const size_t n = remaining.size();
+        bool clipped = false;
+
+        for (size_t i = 0; i < n; ++i) {
+            unsigned int ia = remaining[(i + n - 1) % n];
+            unsigned int ib = remaining[i];
+            unsigned int ic = remaining[(i + 1) % n];
+            const Vector2& a = polygon[ia];
+            const Vector2& b = polygon[ib];
+            const Vector2& c = polygon[ic];
+
+            float cross = (b - a).cross(c - b);
+            if (cross < 0.0f) continue; // Reflex
+
+            // Collinear vertex: drop it without emitting a triangle
+            if (cross == 0.0f) {
+                remaining.erase(remaining.begin() + i);
+                clipped = true;
+                break;
+            }
+
+            bool isEar = true;
+            for (unsigned int other : remaining) {
+                if (other == ia || other == ib || other == ic) continue;
+                if (pointInTriangle(polygon[other], a, b, c)) {
+                    isEar = false;
+                    break;
+                }
+            }
+            if (!isEar) continue;
+
+            indices.insert(indices.end(), {ia, ib, ic});
+            remaining.erase(remaining.begin() + i);
+            clipped = true;
+            break;
+        }
+
+        if (!clipped) return false;
+    }
+
+    indices.insert(indices.end(), {remaining[0], remaining[1], remaining[2]});
+    return true;
+}
+
+SpriteMesh MeshGenerator::buildMesh(const std::vector<Vector2>& polygon, const std::vector<unsigned int>& indices,
+                                    float width, float height) {
+    SpriteMesh mesh;
+    mesh.uvs = polygon;
+    mesh.vertices.reserve(polygon.size());
+    for (const auto& uv : polygon) {
+        mesh.vertices.emplace_back(uv.x - width * 0.5f, uv.y - height * 0.5f);
+    }
+    mesh.indices = indices;
+    return mesh;
+}
+
+} // namespace Riggle
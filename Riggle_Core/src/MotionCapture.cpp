@@ -0,0 +1,197 @@
+#include "Riggle/MotionCapture.h"
+#include "Riggle/Animation.h"
+#include "Riggle/Rig.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <utility>
+
+namespace Riggle {
+
+namespace {
+
+float wrapAngle(float angle) {
+    const float PI = 3.14159265f;
+    while (angle > PI) angle -= 2.0f * PI;
+    while (angle < -PI) angle += 2.0f * PI;
+    return angle;
+}
+
+} // namespace
+
+MotionCapture::MotionCapture(size_t capacity) {
+    setCapacity(capacity);
+}
+
+void MotionCapture::setCapacity(size_t capacity) {
+    if (m_recording) return;
+    m_capacity = std::max<size_t>(capacity, 1);
+    m_samples.clear();
+    m_head = 0;
+    m_count = 0;
+    m_dropped = 0;
+}
+
+bool MotionCapture::begin(const Rig& rig) {
+    if (m_recording) return false;
+
+    // Names are resolved once here, recording only does a lookup
+    m_boneNames.clear();
+    m_boneIndex.clear();
+    for (const auto& bone : rig.getAllBones()) {
+        m_boneIndex.emplace(bone->getName(), static_cast<int>(m_boneNames.size()));
+        m_boneNames.push_back(bone->getName());
+    }
+
+    // The only allocation of a take
+    if (m_samples.size() != m_capacity) {
+        m_samples.assign(m_capacity, Sample());
+    }
+    m_head = 0;
+    m_count = 0;
+    m_dropped = 0;
+    m_lastKeyCount = 0;
+    m_recording = true;
+    return true;
+}
+
+void MotionCapture::record(const std::string& boneName, float time, const Transform& transform) {
+    if (!m_recording) return;
+
+    auto it = m_boneIndex.find(boneName);
+    if (it == m_boneIndex.end()) return;
+
+    Sample& sample = m_samples[m_head];
+    sample.bone = it->second;
+    sample.time = time;
+    sample.transform = transform;
+
+    m_head = (m_head + 1) % m_samples.size();
+    if (m_count < m_samples.size()) {
+        ++m_count;
+    } else {
+        ++m_dropped;
+    }
+}
+
+void MotionCapture::end() {
+    m_recording = false;
+    if (m_dropped > 0) {
+        std::cout << "MotionCapture: buffer full, " << m_dropped << " oldest samples were overwritten" << std::endl;
+    }
+}
+
+size_t MotionCapture::bakeInto(Animation& animation, const MotionCaptureSettings& settings) {
+    if (m_recording) end();
+    m_lastKeyCount = 0;
+    if (m_count == 0) return 0;
+
+    // Oldest sample first
+    const size_t capacity = m_samples.size();
+    const size_t first = (m_head + capacity - m_count) % capacity;
+    std::vector<std::vector<Sample>> perBone(m_boneNames.size());
+    for (size_t i = 0; i < m_count; ++i) {
+        const Sample& sample = m_samples[(first + i) % capacity];
+        perBone[sample.bone].push_back(sample);
+    }
+
+    const float sameTime = 0.0005f;
+    std::vector<Sample> samples;
+    std::vector<size_t> keep;
+    for (size_t bone = 0; bone < perBone.size(); ++bone) {
+        auto& captured = perBone[bone];
+        if (captured.empty()) continue;
+
+        // A looping timeline can pass the same time twice - the later take wins
+        std::stable_sort(captured.begin(), captured.end(),
+            [](const Sample& a, const Sample& b) { return a.time < b.time; });
+        samples.clear();
+        for (const auto& sample : captured) {
+            if (!samples.empty() && sample.time - samples.back().time < sameTime) {
+                samples.back() = sample;
+            } else {
+                samples.push_back(sample);
+            }
+        }
+
+        decimate(samples, settings, keep);
+
+        const std::string& boneName = m_boneNames[bone];
+        BoneTrack* track = animation.getBoneTrack(boneName);
+        if (!track) {
+            track = animation.createBoneTrack(boneName);
+        }
+        track->removeKeyframesInRange(samples.front().time, samples.back().time);
+        for (size_t index : keep) {
+            track->addKeyframe(samples[index].time, samples[index].transform);
+        }
+        m_lastKeyCount += keep.size();
+    }
+
+    std::cout << "MotionCapture: " << m_count << " samples reduced to " << m_lastKeyCount << " keyframes" << std::endl;
+    return m_lastKeyCount;
+}
+
+void MotionCapture::decimate(const std::vector<Sample>& samples, const MotionCaptureSettings& settings,
+                             std::vector<size_t>& keep) {
+    keep.clear();
+    const size_t count = samples.size();
+    if (count <= 2) {
+        for (size_t i = 0; i < count; ++i) keep.push_back(i);
+        return;
+    }
+
+    const float positionTolerance = std::max(settings.positionTolerance, 1e-6f);
+    const float rotationTolerance = std::max(settings.rotationTolerance, 1e-6f);
+    const float scaleTolerance = std::max(settings.scaleTolerance, 1e-6f);
+
+    // Error of sample i against the key interpolation between a and b (same rules as BoneTrack)
+    auto error = [&](size_t a, size_t b, size_t i) {
+        const Transform& ta = samples[a].transform;
+        const Transform& tb = samples[b].transform;
+        const Transform& ti = samples[i].transform;
+        float span = samples[b].time - samples[a].time;
+        float t = span > 0.0f ? (samples[i].time - samples[a].time) / span : 0.0f;
+
+        Vector2 position = ta.position + (tb.position - ta.position) * t;
+        float rotation = ta.rotation + wrapAngle(tb.rotation - ta.rotation) * t;
+        Vector2 scale = ta.scale + (tb.scale - ta.scale) * t;
+
+        float positionError = (ti.position - position).length() / positionTolerance;
+        float rotationError = std::abs(wrapAngle(ti.rotation - rotation)) / rotationTolerance;
+        float scaleError = (ti.scale - scale).length() / scaleTolerance;
+        return std::max(positionError, std::max(rotationError, scaleError));
+    };
+
+    // Iterative RDP - long takes would recurse too deep
+    std::vector<bool> kept(count, false);
+    kept.front() = kept.back() = true;
+    std::vector<std::pair<size_t, size_t>> stack;
+    stack.emplace_back(0, count - 1);
+    while (!stack.empty()) {
+        auto [a, b] = stack.back();
+        stack.pop_back();
+        if (b - a < 2) continue;
+
+        size_t worst = a;
+        float worstError = 1.0f;
+        for (size_t i = a + 1; i < b; ++i) {
+            float e = error(a, b, i);
+            if (e > worstError) {
+                worstError = e;
+                worst = i;
+            }
+        }
+        if (worst == a) continue;
+
+        kept[worst] = true;
+        stack.emplace_back(a, worst);
+        stack.emplace_back(worst, b);
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        if (kept[i]) keep.push_back(i);
+    }
+}
+
+} // namespace Riggle
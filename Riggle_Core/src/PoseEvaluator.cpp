@@ -0,0 +1,165 @@
+#include "Riggle/PoseEvaluator.h"
+#include <algorithm>
+
+namespace Riggle {
+
+void PoseEvaluator::compile(const std::vector<ExportBone>& bones, const std::vector<ExportSprite>& sprites) {
+    clear();
+
+    const int count = static_cast<int>(bones.size());
+    m_boneIndex.reserve(bones.size());
+    for (int i = 0; i < count; ++i) {
+        m_boneIndex.emplace(bones[i].name, i);
+    }
+
+    m_parents.resize(count, -1);
+    m_lengths.resize(count);
+    m_restLocals.resize(count);
+    for (int i = 0; i < count; ++i) {
+        if (!bones[i].parentName.empty()) {
+            m_parents[i] = findBone(bones[i].parentName);
+        }
+        m_lengths[i] = bones[i].length;
+        m_restLocals[i] = bones[i].transform;
+    }
+    m_locals = m_restLocals;
+    m_worlds.resize(count);
+    m_boneTracks.assign(count, -1);
+
+    // Exported bones are already parent-first, but don't rely on it
+    std::vector<char> placed(count, 0);
+    std::vector<int> chain;
+    m_order.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        chain.clear();
+        for (int bone = i; bone >= 0 && !placed[bone] && static_cast<int>(chain.size()) < count; bone = m_parents[bone]) {
+            chain.push_back(bone);
+        }
+        for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+            if (placed[*it]) continue;
+            placed[*it] = 1;
+            m_order.push_back(*it);
+        }
+    }
+
+    m_sprites.resize(sprites.size());
+    for (size_t i = 0; i < sprites.size(); ++i) {
+        const ExportSprite& sprite = sprites[i];
+        CompiledSprite& compiled = m_sprites[i];
+        compiled.local = sprite.transform;
+        compiled.bindOffset = sprite.bindOffset;
+        compiled.bindRotation = sprite.bindRotation;
+        compiled.bone = sprite.boundBoneName.empty() ? -1 : findBone(sprite.boundBoneName);
+
+        for (const auto& name : sprite.skinBoneNames) {
+            int bone = findBone(name);
+            if (bone < 0) {
+                compiled.skinBones.clear();
+                break;
+            }
+            compiled.skinBones.push_back(bone);
+        }
+    }
+}
+
+void PoseEvaluator::bindAnimation(const ExportAnimation& animation) {
+    m_tracks.clear();
+    std::fill(m_boneTracks.begin(), m_boneTracks.end(), -1);
+
+    for (const auto& exportTrack : animation.tracks) {
+        int bone = findBone(exportTrack.boneName);
+        if (bone < 0 || exportTrack.keyframes.empty()) continue;
+
+        Track track;
+        track.keyframes = exportTrack.keyframes.data();
+        track.count = static_cast<int>(exportTrack.keyframes.size());
+        m_boneTracks[bone] = static_cast<int>(m_tracks.size());
+        m_tracks.push_back(track);
+    }
+}
+
+void PoseEvaluator::clear() {
+    m_boneIndex.clear();
+    m_parents.clear();
+    m_order.clear();
+    m_lengths.clear();
+    m_restLocals.clear();
+    m_locals.clear();
+    m_worlds.clear();
+    m_tracks.clear();
+    m_boneTracks.clear();
+    m_sprites.clear();
+}
+
+void PoseEvaluator::resetToRest() {
+    std::copy(m_restLocals.begin(), m_restLocals.end(), m_locals.begin());
+}
+
+void PoseEvaluator::sampleAnimation(float time) {
+    resetToRest();
+    for (size_t bone = 0; bone < m_boneTracks.size(); ++bone) {
+        int track = m_boneTracks[bone];
+        if (track >= 0) {
+            m_locals[bone] = sample(m_tracks[track], time);
+        }
+    }
+}
+
+bool PoseEvaluator::sampleTrack(int bone, float time, Transform& local) {
+    int track = m_boneTracks[bone];
+    if (track < 0) return false;
+    local = sample(m_tracks[track], time);
+    return true;
+}
+
+void PoseEvaluator::updateWorldTransforms() {
+    for (int bone : m_order) {
+        int parent = m_parents[bone];
+        m_worlds[bone] = parent >= 0 ? combineTransforms(m_worlds[parent], m_locals[bone]) : m_locals[bone];
+    }
+}
+
+int PoseEvaluator::findBone(const std::string& name) const {
+    auto it = m_boneIndex.find(name);
+    return it != m_boneIndex.end() ? it->second : -1;
+}
+
+Transform PoseEvaluator::getSpriteWorldTransform(int sprite) const {
+    const CompiledSprite& compiled = m_sprites[sprite];
+    if (compiled.bone < 0) {
+        return compiled.local;
+    }
+    return bindTransform(m_worlds[compiled.bone], compiled.bindOffset, compiled.bindRotation, compiled.local);
+}
+
+Transform PoseEvaluator::sample(Track& track, float time) const {
+    const ExportKeyframe* keys = track.keyframes;
+    const int count = track.count;
+
+    // Clamp to the animation bounds, like BoneTrack::getTransformAtTime
+    if (count == 1 || time <= keys[0].time) {
+        return keys[0].transform;
+    }
+    if (time >= keys[count - 1].time) {
+        return keys[count - 1].transform;
+    }
+
+    // First keyframe after 'time'; reuse the last segment or its successor before searching
+    int next = track.cursor;
+    if (!(keys[next - 1].time <= time && time < keys[next].time)) {
+        if (next + 1 < count && keys[next].time <= time && time < keys[next + 1].time) {
+            ++next;
+        } else {
+            next = static_cast<int>(std::upper_bound(keys, keys + count, time,
+                [](float t, const ExportKeyframe& key) { return t < key.time; }) - keys);
+        }
+        track.cursor = next;
+    }
+
+    const ExportKeyframe& prev = keys[next - 1];
+    const ExportKeyframe& key = keys[next];
+    float t = (time - prev.time) / (key.time - prev.time);
+    return interpolateTransform(prev.transform, key.transform, t);
+}
+
+} // namespace Riggle
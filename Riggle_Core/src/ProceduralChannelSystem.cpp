@@ -0,0 +1,480 @@
+#include "Riggle/ProceduralChannelSystem.h"
+#include "Riggle/Animation.h"
+#include "Riggle/Rig.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <unordered_map>
+
+namespace Riggle {
+
+namespace {
+
+const int TARGET_COUNT = 5;
+const float TWO_PI = 6.28318531f;
+
+float wrapAngle(float angle) {
+    const float PI = 3.14159265f;
+    while (angle > PI) angle -= 2.0f * PI;
+    while (angle < -PI) angle += 2.0f * PI;
+    return angle;
+}
+
+bool samePose(const Transform& a, const Transform& b) {
+    return a.position.x == b.position.x && a.position.y == b.position.y && a.rotation == b.rotation &&
+           a.scale.x == b.scale.x && a.scale.y == b.scale.y;
+}
+
+float channelValue(const Transform& transform, int target) {
+    switch (static_cast<ProceduralTarget>(target)) {
+        case ProceduralTarget::PositionX: return transform.position.x;
+        case ProceduralTarget::PositionY: return transform.position.y;
+        case ProceduralTarget::Rotation: return transform.rotation;
+        case ProceduralTarget::ScaleX: return transform.scale.x;
+        case ProceduralTarget::ScaleY: return transform.scale.y;
+    }
+    return 0.0f;
+}
+
+// Integer hash to [-1, 1] - same value on every platform for a given seed and lattice point
+float latticeValue(unsigned int seed, int32_t point) {
+    uint32_t h = static_cast<uint32_t>(seed) * 0x9E3779B1u ^ static_cast<uint32_t>(point) * 0x85EBCA6Bu;
+    h ^= h >> 16;
+    h *= 0x7FEB352Du;
+    h ^= h >> 15;
+    h *= 0x846CA68Bu;
+    h ^= h >> 16;
+    return static_cast<float>(h & 0xFFFFFFu) / static_cast<float>(0xFFFFFFu) * 2.0f - 1.0f;
+}
+
+float smoothNoise(unsigned int seed, float x) {
+    float cell = std::floor(x);
+    float f = x - cell;
+    float u = f * f * (3.0f - 2.0f * f);
+    int32_t point = static_cast<int32_t>(cell);
+    float a = latticeValue(seed, point);
+    float b = latticeValue(seed, point + 1);
+    return a + (b - a) * u;
+}
+
+} // namespace
+
+ProceduralChannelSystem::ProceduralChannelSystem() {
+}
+
+void ProceduralChannelSystem::clear() {
+    m_boneParent.clear();
+    m_pending.clear();
+    m_slotOf.clear();
+    m_slotBone.clear();
+    m_offsets.clear();
+
+    m_sineOut.clear();
+    m_sineAmplitude.clear();
+    m_sineFrequency.clear();
+    m_sinePhase.clear();
+    m_sineValue.clear();
+    m_sineSource.clear();
+
+    m_noiseOut.clear();
+    m_noiseAmplitude.clear();
+    m_noiseFrequency.clear();
+    m_noiseSeed.clear();
+    m_noiseOctaves.clear();
+    m_noiseValue.clear();
+    m_noiseSource.clear();
+
+    m_followOut.clear();
+    m_followGain.clear();
+    m_followDelay.clear();
+    m_followBone.clear();
+    m_followTarget.clear();
+    m_followLinkBegin.clear();
+    m_followLinks.clear();
+    m_followValue.clear();
+    m_followSource.clear();
+
+    m_rig = nullptr;
+    m_bones.clear();
+    m_inputLocal.clear();
+    m_writtenLocal.clear();
+    m_hasWritten.clear();
+    m_boundTrackSet = 0;
+    m_tracks.clear();
+}
+
+int ProceduralChannelSystem::addBone(int parentIndex) {
+    int index = static_cast<int>(m_boneParent.size());
+    m_boneParent.push_back(parentIndex >= 0 && parentIndex < index ? parentIndex : -1);
+    return index;
+}
+
+void ProceduralChannelSystem::addChannel(const ProceduralChannel& channel, int boneIndex, int sourceIndex) {
+    PendingChannel pending;
+    pending.channel = channel;
+    pending.bone = boneIndex;
+    pending.sourceBone = sourceIndex;
+    m_pending.push_back(pending);
+}
+
+void ProceduralChannelSystem::finalize() {
+    const int count = static_cast<int>(m_boneParent.size());
+    m_slotOf.assign(count, -1);
+    m_slotBone.clear();
+
+    auto slotFor = [&](int bone) {
+        if (m_slotOf[bone] < 0) {
+            m_slotOf[bone] = static_cast<int>(m_slotBone.size());
+            m_slotBone.push_back(bone);
+        }
+        return m_slotOf[bone];
+    };
+
+    size_t dropped = 0;
+    std::vector<const PendingChannel*> follows;
+    for (const auto& pending : m_pending) {
+        const ProceduralChannel& channel = pending.channel;
+        if (!channel.enabled || pending.bone < 0 || pending.bone >= count) continue;
+
+        int out = slotFor(pending.bone) * TARGET_COUNT + static_cast<int>(channel.target);
+        switch (channel.generator) {
+            case ProceduralGenerator::Sine:
+                m_sineOut.push_back(out);
+                m_sineAmplitude.push_back(channel.amplitude);
+                m_sineFrequency.push_back(channel.frequency);
+                m_sinePhase.push_back(channel.phase);
+                m_sineSource.push_back(pending.source);
+                break;
+            case ProceduralGenerator::Noise:
+                m_noiseOut.push_back(out);
+                m_noiseAmplitude.push_back(channel.amplitude);
+                m_noiseFrequency.push_back(channel.frequency);
+                m_noiseSeed.push_back(channel.seed);
+                m_noiseOctaves.push_back(std::clamp(channel.octaves, 1, 8));
+                m_noiseSource.push_back(pending.source);
+                break;
+            case ProceduralGenerator::FollowThrough: {
+                int followed = pending.sourceBone >= 0 ? pending.sourceBone : m_boneParent[pending.bone];
+                if (followed < 0 || followed >= count || followed == pending.bone) {
+                    ++dropped;
+                    break;
+                }
+                m_followOut.push_back(out);
+                m_followGain.push_back(channel.amplitude);
+                m_followDelay.push_back(std::max(channel.delay, 0.0f));
+                m_followBone.push_back(followed);
+                m_followTarget.push_back(static_cast<int>(channel.target));
+                m_followSource.push_back(pending.source);
+                break;
+            }
+        }
+    }
+
+    // A followed bone's own generators are part of the motion being followed
+    m_followLinkBegin.assign(1, 0);
+    for (size_t i = 0; i < m_followOut.size(); ++i) {
+        int followedSlot = m_slotOf[m_followBone[i]];
+        if (followedSlot >= 0) {
+            int followedOut = followedSlot * TARGET_COUNT + m_followTarget[i];
+            for (size_t j = 0; j < m_sineOut.size(); ++j) {
+                if (m_sineOut[j] == followedOut) m_followLinks.push_back(static_cast<int>(j));
+            }
+            for (size_t j = 0; j < m_noiseOut.size(); ++j) {
+                if (m_noiseOut[j] == followedOut) m_followLinks.push_back(~static_cast<int>(j));
+            }
+        }
+        m_followLinkBegin.push_back(static_cast<int>(m_followLinks.size()));
+    }
+
+    m_offsets.assign(m_slotBone.size() * TARGET_COUNT, 0.0f);
+    m_sineValue.assign(m_sineOut.size(), 0.0f);
+    m_noiseValue.assign(m_noiseOut.size(), 0.0f);
+    m_followValue.assign(m_followOut.size(), 0.0f);
+
+    if (dropped > 0) {
+        std::cout << "ProceduralChannelSystem: " << dropped << " follow-through channel(s) have nothing to follow" << std::endl;
+    }
+}
+
+float ProceduralChannelSystem::sineAt(size_t i, float time) const {
+    return m_sineAmplitude[i] * std::sin(TWO_PI * m_sineFrequency[i] * time + m_sinePhase[i]);
+}
+
+float ProceduralChannelSystem::noiseAt(size_t i, float time) const {
+    // Octaves double the frequency and halve the weight; normalised back to the amplitude
+    float x = time * m_noiseFrequency[i];
+    float sum = 0.0f;
+    float weight = 1.0f;
+    float totalWeight = 0.0f;
+    for (int octave = 0; octave < m_noiseOctaves[i]; ++octave) {
+        sum += weight * smoothNoise(m_noiseSeed[i] + static_cast<unsigned int>(octave) * 1013u, x);
+        totalWeight += weight;
+        weight *= 0.5f;
+        x *= 2.0f;
+    }
+    return m_noiseAmplitude[i] * sum / totalWeight;
+}
+
+void ProceduralChannelSystem::evaluate(float time, float loopDuration, const KeySampler& sampler) {
+    // One loop per generator over its parameter arrays
+    const size_t sineCount = m_sineOut.size();
+    for (size_t i = 0; i < sineCount; ++i) {
+        m_sineValue[i] = m_sineAmplitude[i] * std::sin(TWO_PI * m_sineFrequency[i] * time + m_sinePhase[i]);
+    }
+
+    const size_t noiseCount = m_noiseOut.size();
+    for (size_t i = 0; i < noiseCount; ++i) {
+        m_noiseValue[i] = noiseAt(i, time);
+    }
+
+    // Follow-through: gain * (followed value a moment ago - followed value now)
+    const size_t followCount = m_followOut.size();
+    Transform past;
+    Transform now;
+    for (size_t i = 0; i < followCount; ++i) {
+        float pastTime = time - m_followDelay[i];
+        if (pastTime < 0.0f && loopDuration > 0.0f) {
+            pastTime = std::fmod(pastTime, loopDuration) + loopDuration;
+        }
+
+        float delta = 0.0f;
+        if (sampler && sampler(m_followBone[i], pastTime, past) && sampler(m_followBone[i], time, now)) {
+            delta = channelValue(past, m_followTarget[i]) - channelValue(now, m_followTarget[i]);
+            if (m_followTarget[i] == static_cast<int>(ProceduralTarget::Rotation)) {
+                delta = wrapAngle(delta);
+            }
+        }
+        for (int link = m_followLinkBegin[i]; link < m_followLinkBegin[i + 1]; ++link) {
+            int index = m_followLinks[link];
+            if (index >= 0) {
+                delta += sineAt(index, pastTime) - m_sineValue[index];
+            } else {
+                delta += noiseAt(~index, pastTime) - m_noiseValue[~index];
+            }
+        }
+        m_followValue[i] = m_followGain[i] * delta;
+    }
+
+    // Scatter into per-bone offsets
+    std::fill(m_offsets.begin(), m_offsets.end(), 0.0f);
+    for (size_t i = 0; i < sineCount; ++i) m_offsets[m_sineOut[i]] += m_sineValue[i];
+    for (size_t i = 0; i < noiseCount; ++i) m_offsets[m_noiseOut[i]] += m_noiseValue[i];
+    for (size_t i = 0; i < followCount; ++i) m_offsets[m_followOut[i]] += m_followValue[i];
+}
+
+bool ProceduralChannelSystem::isDriven(int index) const {
+    return index >= 0 && index < static_cast<int>(m_slotOf.size()) && m_slotOf[index] >= 0;
+}
+
+void ProceduralChannelSystem::applyOffsets(int index, Transform& local) const {
+    if (!isDriven(index)) return;
+
+    const float* offset = &m_offsets[m_slotOf[index] * TARGET_COUNT];
+    local.position.x += offset[static_cast<int>(ProceduralTarget::PositionX)];
+    local.position.y += offset[static_cast<int>(ProceduralTarget::PositionY)];
+    local.rotation += offset[static_cast<int>(ProceduralTarget::Rotation)];
+    local.scale.x += offset[static_cast<int>(ProceduralTarget::ScaleX)];
+    local.scale.y += offset[static_cast<int>(ProceduralTarget::ScaleY)];
+}
+
+void ProceduralChannelSystem::rebuildFromRig(Rig* rig) {
+    clear();
+
+    // Hierarchy order guarantees parents are added before children
+    std::unordered_map<std::string, int> indexOf;
+    std::function<void(const std::shared_ptr<Bone>&, int)> visit = [&](const std::shared_ptr<Bone>& bone, int parent) {
+        if (!bone) return;
+        int index = addBone(parent);
+        indexOf[bone->getName()] = index;
+        m_bones.push_back(bone);
+        for (const auto& child : bone->getChildren()) {
+            visit(child, index);
+        }
+    };
+    for (const auto& root : rig->getRootBones()) {
+        visit(root, -1);
+    }
+
+    const auto& channels = rig->getProceduralChannels();
+    size_t unresolved = 0;
+    for (size_t i = 0; i < channels.size(); ++i) {
+        auto bone = indexOf.find(channels[i].boneName);
+        auto source = indexOf.find(channels[i].sourceName);
+        bool needsSource = channels[i].generator == ProceduralGenerator::FollowThrough && !channels[i].sourceName.empty();
+        if (bone == indexOf.end() || (needsSource && source == indexOf.end())) {
+            ++unresolved;
+            continue;
+        }
+
+        addChannel(channels[i], bone->second, needsSource ? source->second : -1);
+        m_pending.back().source = static_cast<int>(i);
+    }
+
+    finalize();
+    if (unresolved > 0) {
+        std::cout << "ProceduralChannelSystem: " << unresolved << " channel(s) reference missing bones" << std::endl;
+    }
+
+    m_inputLocal.assign(m_bones.size(), Transform());
+    m_writtenLocal.assign(m_bones.size(), Transform());
+    m_hasWritten.assign(m_bones.size(), false);
+    m_tracks.assign(m_bones.size(), nullptr);
+
+    m_rig = rig;
+    m_rigVersion = rig->getSetupVersion();
+}
+
+void ProceduralChannelSystem::refreshParams(const Rig& rig) {
+    // Generator and bone changes reschedule; the numbers are picked up live
+    const auto& channels = rig.getProceduralChannels();
+    const int count = static_cast<int>(channels.size());
+    for (size_t i = 0; i < m_sineOut.size(); ++i) {
+        if (m_sineSource[i] < 0 || m_sineSource[i] >= count) continue;
+        const ProceduralChannel& channel = channels[m_sineSource[i]];
+        m_sineAmplitude[i] = channel.amplitude;
+        m_sineFrequency[i] = channel.frequency;
+        m_sinePhase[i] = channel.phase;
+    }
+    for (size_t i = 0; i < m_noiseOut.size(); ++i) {
+        if (m_noiseSource[i] < 0 || m_noiseSource[i] >= count) continue;
+        const ProceduralChannel& channel = channels[m_noiseSource[i]];
+        m_noiseAmplitude[i] = channel.amplitude;
+        m_noiseFrequency[i] = channel.frequency;
+        m_noiseSeed[i] = channel.seed;
+        m_noiseOctaves[i] = std::clamp(channel.octaves, 1, 8);
+    }
+    for (size_t i = 0; i < m_followOut.size(); ++i) {
+        if (m_followSource[i] < 0 || m_followSource[i] >= count) continue;
+        const ProceduralChannel& channel = channels[m_followSource[i]];
+        m_followGain[i] = channel.amplitude;
+        m_followDelay[i] = std::max(channel.delay, 0.0f);
+    }
+}
+
+void ProceduralChannelSystem::bindTracks(const Animation* animation) {
+    // Name lookups happen once per animation, not per frame
+    std::fill(m_tracks.begin(), m_tracks.end(), nullptr);
+    if (animation) {
+        const auto& tracks = animation->getTracks();
+        for (size_t i = 0; i < m_bones.size(); ++i) {
+            auto bone = m_bones[i].lock();
+            if (!bone) continue;
+            auto it = tracks.find(bone->getName());
+            if (it != tracks.end()) {
+                m_tracks[i] = it->second.get();
+            }
+        }
+    }
+    m_boundTrackSet = animation ? animation->getTrackSetVersion() : 0;
+}
+
+bool ProceduralChannelSystem::prepare(Rig* rig, const Animation* animation) {
+    if (!rig || !m_enabled) return false;
+
+    if (rig != m_rig || rig->getSetupVersion() != m_rigVersion) {
+        rebuildFromRig(rig);
+        bindTracks(animation);
+    } else {
+        refreshParams(*rig);
+        if ((animation ? animation->getTrackSetVersion() : 0) != m_boundTrackSet) {
+            bindTracks(animation);
+        }
+    }
+    if (m_slotBone.empty()) return false;
+
+    // Gather the animated pose of every driven bone
+    for (int bone : m_slotBone) {
+        auto ptr = m_bones[bone].lock();
+        if (!ptr) {
+            m_rig = nullptr; // Rebuild next frame
+            return false;
+        }
+
+        // Unchanged since our write-back means nothing re-posed the bone this frame
+        const Transform& local = ptr->getLocalTransform();
+        if (!(m_hasWritten[bone] && samePose(local, m_writtenLocal[bone]))) {
+            m_inputLocal[bone] = local;
+        }
+    }
+    return true;
+}
+
+void ProceduralChannelSystem::commit() {
+    for (int bone : m_slotBone) {
+        auto ptr = m_bones[bone].lock();
+        if (ptr->isCollapsed()) continue; // Collapsed by skeleton LOD
+
+        Transform local = m_inputLocal[bone];
+        applyOffsets(bone, local);
+        ptr->setLocalTransform(local);
+        m_writtenLocal[bone] = ptr->getLocalTransform();
+        m_hasWritten[bone] = true;
+    }
+}
+
+void ProceduralChannelSystem::update(Rig* rig, float time, const Animation* animation, float loopDuration) {
+    Entry entry;
+    entry.system = this;
+    entry.rig = rig;
+    entry.animation = animation;
+    entry.time = time;
+    entry.loopDuration = loopDuration;
+    updateAll({entry});
+}
+
+void ProceduralChannelSystem::updateAll(const std::vector<Entry>& entries) {
+    // Bones cache world transforms lazily, so reads and writes stay on this thread;
+    // only the generator loops in between touch the flat arrays
+    std::vector<const Entry*> active;
+    for (const auto& entry : entries) {
+        if (entry.system && entry.system->prepare(entry.rig, entry.animation)) {
+            active.push_back(&entry);
+        }
+    }
+
+    for (const Entry* entry : active) {
+        ProceduralChannelSystem* system = entry->system;
+        // Followed bones without a track hold still, only their own channels move them
+        auto sampler = [system](int bone, float time, Transform& local) {
+            // A track can lose and regain its keys without being recreated
+            const BoneTrack* track = system->m_tracks[bone];
+            if (!track || track->isEmpty()) return false;
+            local = track->getTransformAtTime(time);
+            return true;
+        };
+        system->evaluate(entry->time, entry->loopDuration, sampler);
+    }
+
+    for (const Entry* entry : active) {
+        entry->system->commit();
+    }
+}
+
+void ProceduralChannelSystem::endFrame(Rig* rig) {
+    if (!rig || !m_enabled || rig != m_rig || rig->getSetupVersion() != m_rigVersion) return;
+
+    // The final pose becomes what we compare against; the base pose stays in m_inputLocal
+    for (int bone : m_slotBone) {
+        if (!m_hasWritten[bone]) continue;
+        auto ptr = m_bones[bone].lock();
+        if (!ptr) continue;
+        m_writtenLocal[bone] = ptr->getLocalTransform();
+    }
+}
+
+bool ProceduralChannelSystem::getAnimatedLocalTransform(const std::string& boneName, Transform& transform) const {
+    for (size_t i = 0; i < m_bones.size(); ++i) {
+        auto bone = m_bones[i].lock();
+        if (!bone || bone->getName() != boneName) continue;
+        if (!m_hasWritten[i] || !isDriven(static_cast<int>(i))) return false;
+
+        // Only if nothing re-posed the bone since our write-back
+        if (!samePose(bone->getLocalTransform(), m_writtenLocal[i])) return false;
+        transform = m_inputLocal[i];
+        return true;
+    }
+    return false;
+}
+
+} // namespace Riggle
@@ -0,0 +1,249 @@
+#include "Riggle/Retargeter.h"
+#include "Riggle/Animation.h"
+#include "Riggle/Rig.h"
+#include "Riggle/Bone.h"
+#include <cctype>
+#include <iostream>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace Riggle {
+
+namespace {
+
+float wrapAngle(float angle) {
+    const float PI = 3.14159265f;
+    while (angle > PI) angle -= 2.0f * PI;
+    while (angle < -PI) angle += 2.0f * PI;
+    return angle;
+}
+
+std::string toLower(const std::string& text) {
+    std::string result = text;
+    for (char& c : result) {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return result;
+}
+
+bool replaceToken(std::string& text, const std::string& token, const std::string& replacement) {
+    size_t pos = text.find(token);
+    if (pos == std::string::npos) return false;
+    text.replace(pos, token.size(), replacement);
+    return true;
+}
+
+} // namespace
+
+Retargeter::Retargeter()
+    : m_ignoredPrefixes({"mixamorig:", "mixamorig_", "bip01 ", "bip01_", "def-", "def_", "org-"})
+{}
+
+bool Retargeter::buildByName(const Rig& source, const Rig& target) {
+    std::unordered_map<std::string, std::shared_ptr<Bone>> targetByName;
+    for (const auto& bone : target.getAllBones()) {
+        targetByName.emplace(normalizeName(bone->getName()), bone);
+    }
+
+    std::vector<std::pair<std::shared_ptr<Bone>, std::shared_ptr<Bone>>> pairs;
+    for (const auto& bone : source.getAllBones()) {
+        auto it = targetByName.find(normalizeName(bone->getName()));
+        if (it != targetByName.end()) {
+            pairs.emplace_back(bone, it->second);
+        }
+    }
+    return finalize(source, target, pairs);
+}
+
+bool Retargeter::buildByHierarchy(const Rig& source, const Rig& target) {
+    // Walk both trees in parallel, pairing roots and children by order
+    std::vector<std::pair<std::shared_ptr<Bone>, std::shared_ptr<Bone>>> pairs;
+    std::vector<std::pair<std::shared_ptr<Bone>, std::shared_ptr<Bone>>> stack;
+    const auto& sourceRoots = source.getRootBones();
+    const auto& targetRoots = target.getRootBones();
+    for (size_t i = 0; i < sourceRoots.size() && i < targetRoots.size(); ++i) {
+        stack.emplace_back(sourceRoots[i], targetRoots[i]);
+    }
+
+    while (!stack.empty()) {
+        auto [sourceBone, targetBone] = stack.back();
+        stack.pop_back();
+        pairs.emplace_back(sourceBone, targetBone);
+
+        const auto& sourceChildren = sourceBone->getChildren();
+        const auto& targetChildren = targetBone->getChildren();
+        for (size_t i = 0; i < sourceChildren.size() && i < targetChildren.size(); ++i) {
+            stack.emplace_back(sourceChildren[i], targetChildren[i]);
+        }
+    }
+    return finalize(source, target, pairs);
+}
+
+bool Retargeter::buildFromTable(const Rig& source, const Rig& target,
+                                const std::vector<std::pair<std::string, std::string>>& table) {
+    std::unordered_map<std::string, std::shared_ptr<Bone>> sourceByName;
+    std::unordered_map<std::string, std::shared_ptr<Bone>> targetByName;
+    for (const auto& bone : source.getAllBones()) sourceByName.emplace(bone->getName(), bone);
+    for (const auto& bone : target.getAllBones()) targetByName.emplace(bone->getName(), bone);
+
+    std::vector<std::pair<std::shared_ptr<Bone>, std::shared_ptr<Bone>>> pairs;
+    for (const auto& entry : table) {
+        auto sourceIt = sourceByName.find(entry.first);
+        auto targetIt = targetByName.find(entry.second);
+        if (sourceIt == sourceByName.end() || targetIt == targetByName.end()) {
+            std::cout << "Retargeter: skipping '" << entry.first << "' -> '" << entry.second
+                      << "', bone not found" << std::endl;
+            continue;
+        }
+        pairs.emplace_back(sourceIt->second, targetIt->second);
+    }
+    return finalize(source, target, pairs);
+}
+
+bool Retargeter::finalize(const Rig& source, const Rig& target,
+                          const std::vector<std::pair<std::shared_ptr<Bone>, std::shared_ptr<Bone>>>& pairs) {
+    m_map.clear();
+    m_mapNames.clear();
+    m_unmapped.clear();
+    m_bindings.clear();
+    m_boundTrackSet = 0;
+
+    // Overall size ratio, used for root translation
+    float sourceSize = 0.0f;
+    float targetSize = 0.0f;
+    for (const auto& pair : pairs) {
+        sourceSize += pair.first->getLength();
+        targetSize += pair.second->getLength();
+    }
+    const float rigScale = (sourceSize > 0.0f && targetSize > 0.0f) ? targetSize / sourceSize : 1.0f;
+
+    std::unordered_set<const Bone*> usedSource;
+    std::unordered_set<const Bone*> usedTarget;
+    for (const auto& [sourceBone, targetBone] : pairs) {
+        // First match wins, a bone is never driven twice
+        if (!usedSource.insert(sourceBone.get()).second) continue;
+        if (!usedTarget.insert(targetBone.get()).second) continue;
+
+        Correction correction;
+        correction.sourceName = sourceBone->getName();
+        correction.target = targetBone;
+        correction.sourceRest = sourceBone->getLocalTransform();
+        correction.targetRest = targetBone->getLocalTransform();
+
+        // A child's offset is measured along its parent, so it scales with the parent
+        auto sourceParent = sourceBone->getParent();
+        auto targetParent = targetBone->getParent();
+        if (sourceParent && targetParent && sourceParent->getLength() > 0.0f) {
+            correction.positionScale = targetParent->getLength() / sourceParent->getLength();
+        } else {
+            correction.positionScale = rigScale;
+        }
+
+        m_mapNames.emplace_back(sourceBone->getName(), targetBone->getName());
+        m_map.push_back(std::move(correction));
+    }
+
+    for (const auto& bone : source.getAllBones()) {
+        if (usedSource.find(bone.get()) == usedSource.end()) {
+            m_unmapped.push_back(bone->getName());
+        }
+    }
+
+    if (m_map.empty()) {
+        m_lastError = "No bones of '" + source.getName() + "' could be mapped to '" + target.getName() + "'";
+        std::cout << "Retargeter: " << m_lastError << std::endl;
+        return false;
+    }
+
+    m_lastError.clear();
+    std::cout << "Retargeter: mapped " << m_map.size() << " bones, "
+              << m_unmapped.size() << " source bones unmapped" << std::endl;
+    return true;
+}
+
+void Retargeter::bind(const Animation& animation) {
+    std::unordered_map<std::string, int> correctionByName;
+    for (size_t i = 0; i < m_map.size(); ++i) {
+        correctionByName.emplace(m_map[i].sourceName, static_cast<int>(i));
+    }
+
+    m_bindings.clear();
+    for (const auto& pair : animation.getTracks()) {
+        auto it = correctionByName.find(pair.first);
+        if (it == correctionByName.end()) continue;
+
+        Binding binding;
+        binding.track = pair.second.get();
+        binding.correction = it->second;
+        m_bindings.push_back(binding);
+    }
+
+    m_boundTrackSet = animation.getTrackSetVersion();
+}
+
+void Retargeter::apply(const Animation& animation, float time, Rig* target) {
+    if (!target || m_map.empty()) return;
+
+    // Tracks are resolved once per animation; adding or removing one re-binds
+    if (m_boundTrackSet != animation.getTrackSetVersion()) {
+        bind(animation);
+    }
+
+    for (const auto& binding : m_bindings) {
+        const Correction& correction = m_map[binding.correction];
+        Bone* bone = correction.target.get();
+        if (bone->isCollapsed()) continue; // Collapsed by skeleton LOD
+
+        const Transform key = binding.track->getTransformAtTime(time);
+        const Transform& sourceRest = correction.sourceRest;
+        const Transform& targetRest = correction.targetRest;
+
+        // Keys become offsets from the source rest pose, applied on the target rest pose
+        Transform transform = targetRest;
+        transform.position = targetRest.position + (key.position - sourceRest.position) * correction.positionScale;
+        transform.rotation = targetRest.rotation + wrapAngle(key.rotation - sourceRest.rotation);
+        transform.scale.x = sourceRest.scale.x != 0.0f ? targetRest.scale.x * key.scale.x / sourceRest.scale.x : key.scale.x;
+        transform.scale.y = sourceRest.scale.y != 0.0f ? targetRest.scale.y * key.scale.y / sourceRest.scale.y : key.scale.y;
+        bone->setLocalTransform(transform);
+    }
+
+    target->forceUpdateWorldTransforms();
+}
+
+std::string Retargeter::normalizeName(const std::string& name) const {
+    std::string lower = toLower(name);
+    for (const auto& prefix : m_ignoredPrefixes) {
+        std::string lowerPrefix = toLower(prefix);
+        if (!lowerPrefix.empty() && lower.compare(0, lowerPrefix.size(), lowerPrefix) == 0) {
+            lower.erase(0, lowerPrefix.size());
+            break;
+        }
+    }
+
+    // Side tokens: "LeftArm", "arm_left", "arm.L" and "l_arm" all end up as "arml"
+    std::string side;
+    if (replaceToken(lower, "left", "")) side = "l";
+    else if (replaceToken(lower, "right", "")) side = "r";
+
+    std::string result;
+    std::string token;
+    auto flush = [&]() {
+        if ((token == "l" || token == "r") && side.empty()) {
+            side = token;
+        } else {
+            result += token;
+        }
+        token.clear();
+    };
+    for (char c : lower) {
+        if (std::isalnum(static_cast<unsigned char>(c))) {
+            token += c;
+        } else {
+            flush();
+        }
+    }
+    flush();
+    return result + side;
+}
+
+} // namespace Riggle
@@ -1,11 +1,24 @@
 #include "Riggle/Rig.h"
 #include "Riggle/Character.h"
 #include <algorithm>
+#include <atomic>
 #include <functional>
+#include <unordered_set>
+#include <cctype>
+#include <cmath>
 
 namespace Riggle {
 
-Rig::Rig(const std::string& name) : m_name(name) {
+namespace {
+std::atomic<unsigned int> s_nextLayoutVersion{1};
+}
+
+Rig::Rig(const std::string& name) : m_name(name), m_layoutVersion(s_nextLayoutVersion++) {
+}
+
+void Rig::markSetupChanged() {
+    ++m_setupVersion;
+    m_layoutVersion = s_nextLayoutVersion++;
 }
 
 std::shared_ptr<Bone> Rig::createBone(const std::string& name, float length) {
@@ -17,6 +30,7 @@ std::shared_ptr<Bone> Rig::createBone(const std::string& name, float length) {
     }
 
     m_rootBones.push_back(bone);
+    markSetupChanged();
     return bone;
 }
 
@@ -31,6 +45,12 @@ std::shared_ptr<Bone> Rig::createChildBone(std::shared_ptr<Bone> parent, const s
     }
 
     parent->addChild(child);
+    markSetupChanged();
+
+    // Keep the active LOD consistent with the new hierarchy
+    if (m_activeLOD > 0) {
+        applyLOD(m_activeLOD);
+    }
     return child;
 }
 
@@ -74,6 +94,35 @@ void Rig::removeBone(const std::string& name) {
         }
     }
     
+    // Constraints can't outlive the bones they reference
+    m_constraints.erase(std::remove_if(m_constraints.begin(), m_constraints.end(),
+        [&name](const BoneConstraint& constraint) {
+            return constraint.boneName == name || constraint.targetName == name;
+        }), m_constraints.end());
+    m_ikConstraints.erase(std::remove_if(m_ikConstraints.begin(), m_ikConstraints.end(),
+        [&name](const IKConstraint& constraint) {
+            return constraint.endEffector == name || constraint.targetBone == name;
+        }), m_ikConstraints.end());
+    for (auto& constraint : m_ikConstraints) {
+        auto& extras = constraint.extraEffectors;
+        extras.erase(std::remove_if(extras.begin(), extras.end(),
+            [&name](const IKExtraEffector& extra) {
+                return extra.endEffector == name || extra.targetBone == name;
+            }), extras.end());
+    }
+    m_proceduralChannels.erase(std::remove_if(m_proceduralChannels.begin(), m_proceduralChannels.end(),
+        [&name](const ProceduralChannel& channel) {
+            return channel.boneName == name || channel.sourceName == name;
+        }), m_proceduralChannels.end());
+
+    markSetupChanged();
+
+    // Bone may have been a LOD proxy for others
+    bone->clearLODProxy();
+    if (m_activeLOD > 0) {
+        applyLOD(m_activeLOD);
+    }
+
     // Update world transforms
     updateWorldTransforms();
 }
@@ -109,9 +158,9 @@ std::vector<std::shared_ptr<Bone>> Rig::getAllBones() const {
 }
 
 void Rig::updateWorldTransforms() {
-    // Update world transforms for all root bones (and their children recursively)
-    for (auto& rootBone : m_rootBones) {
-        updateBoneHierarchy(rootBone);
+    // Parents come first, so each bone's lazy update finds its parent already current
+    for (const auto& bone : getEvaluatedBones()) {
+        bone->getWorldTransform();
     }
 }
 
@@ -119,16 +168,262 @@ void Rig::forceUpdateWorldTransforms() {
     updateWorldTransforms(); // Force immediate update
 }
 
-void Rig::updateBoneHierarchy(std::shared_ptr<Bone> bone) {
-    if (!bone) return;
-    
-    // The Bone class should automatically calculate world transform when requested
-    bone->getWorldTransform();
-    
-    // Recursively update all children
-    for (auto& child : bone->getChildren()) {
-        updateBoneHierarchy(child);
+const std::vector<std::shared_ptr<Bone>>& Rig::getEvaluatedBones() const {
+    if (m_evaluatedLayout == m_layoutVersion) return m_evaluatedBones;
+
+    // Collapsed subtrees are resolved lazily from their LOD proxy
+    m_evaluatedBones.clear();
+    std::function<void(const std::shared_ptr<Bone>&)> collect = [&](const std::shared_ptr<Bone>& bone) {
+        if (!bone || bone->isCollapsed()) return;
+        m_evaluatedBones.push_back(bone);
+        for (const auto& child : bone->getChildren()) {
+            collect(child);
+        }
+    };
+    for (const auto& root : m_rootBones) {
+        collect(root);
+    }
+    m_evaluatedLayout = m_layoutVersion;
+    return m_evaluatedBones;
+}
+
+int Rig::addConstraint(const BoneConstraint& constraint) {
+    m_constraints.push_back(constraint);
+    markSetupChanged();
+    return static_cast<int>(m_constraints.size()) - 1;
+}
+
+void Rig::setConstraint(int index, const BoneConstraint& constraint) {
+    if (index < 0 || index >= static_cast<int>(m_constraints.size())) return;
+
+    // Only changes to the dependency graph need a reschedule, weights are picked up live
+    const BoneConstraint& old = m_constraints[index];
+    bool graphChanged = old.type != constraint.type || old.boneName != constraint.boneName ||
+                        old.targetName != constraint.targetName || old.enabled != constraint.enabled;
+
+    m_constraints[index] = constraint;
+    if (graphChanged) {
+        markSetupChanged();
+    }
+}
+
+void Rig::removeConstraint(int index) {
+    if (index < 0 || index >= static_cast<int>(m_constraints.size())) return;
+    m_constraints.erase(m_constraints.begin() + index);
+    markSetupChanged();
+}
+
+void Rig::clearConstraints() {
+    m_constraints.clear();
+    markSetupChanged();
+}
+
+int Rig::addIKConstraint(const IKConstraint& constraint) {
+    m_ikConstraints.push_back(constraint);
+    markSetupChanged();
+    return static_cast<int>(m_ikConstraints.size()) - 1;
+}
+
+void Rig::setIKConstraint(int index, const IKConstraint& constraint) {
+    if (index < 0 || index >= static_cast<int>(m_ikConstraints.size())) return;
+
+    // Chains and targets define the schedule, solver settings, target points and weights are picked up live
+    const IKConstraint& old = m_ikConstraints[index];
+    bool graphChanged = old.endEffector != constraint.endEffector || old.targetBone != constraint.targetBone ||
+                        old.chainLength != constraint.chainLength || old.enabled != constraint.enabled ||
+                        old.extraEffectors.size() != constraint.extraEffectors.size();
+    for (size_t i = 0; i < constraint.extraEffectors.size() && !graphChanged; ++i) {
+        graphChanged = old.extraEffectors[i].endEffector != constraint.extraEffectors[i].endEffector ||
+                       old.extraEffectors[i].targetBone != constraint.extraEffectors[i].targetBone;
+    }
+
+    m_ikConstraints[index] = constraint;
+    if (graphChanged) {
+        markSetupChanged();
+    }
+}
+
+void Rig::removeIKConstraint(int index) {
+    if (index < 0 || index >= static_cast<int>(m_ikConstraints.size())) return;
+    m_ikConstraints.erase(m_ikConstraints.begin() + index);
+    markSetupChanged();
+}
+
+void Rig::clearIKConstraints() {
+    m_ikConstraints.clear();
+    markSetupChanged();
+}
+
+int Rig::addProceduralChannel(const ProceduralChannel& channel) {
+    m_proceduralChannels.push_back(channel);
+    markSetupChanged();
+    return static_cast<int>(m_proceduralChannels.size()) - 1;
+}
+
+void Rig::setProceduralChannel(int index, const ProceduralChannel& channel) {
+    if (index < 0 || index >= static_cast<int>(m_proceduralChannels.size())) return;
+
+    // Generator, bones and channel define the layout, the numbers are picked up live
+    const ProceduralChannel& old = m_proceduralChannels[index];
+    bool layoutChanged = old.generator != channel.generator || old.target != channel.target ||
+                         old.boneName != channel.boneName || old.sourceName != channel.sourceName ||
+                         old.enabled != channel.enabled;
+
+    m_proceduralChannels[index] = channel;
+    if (layoutChanged) {
+        markSetupChanged();
+    }
+}
+
+void Rig::removeProceduralChannel(int index) {
+    if (index < 0 || index >= static_cast<int>(m_proceduralChannels.size())) return;
+    m_proceduralChannels.erase(m_proceduralChannels.begin() + index);
+    markSetupChanged();
+}
+
+void Rig::clearProceduralChannels() {
+    m_proceduralChannels.clear();
+    markSetupChanged();
+}
+
+int Rig::addLODLevel(const SkeletonLOD& lod) {
+    m_lodLevels.push_back(lod);
+    return static_cast<int>(m_lodLevels.size());
+}
+
+void Rig::removeLODLevel(int level) {
+    if (level <= 0 || level > static_cast<int>(m_lodLevels.size())) return;
+
+    m_lodLevels.erase(m_lodLevels.begin() + (level - 1));
+    if (m_activeLOD >= level) {
+        setActiveLOD(0);
+    }
+}
+
+void Rig::clearLODLevels() {
+    m_lodLevels.clear();
+    setActiveLOD(0);
+}
+
+int Rig::generateLODLevels(int levelCount, float minBoneLength) {
+    // Name fragments of bones that only add secondary detail
+    static const char* helperKeywords[] = {
+        "finger", "thumb", "hair", "cloth", "skirt", "cape", "helper", "twist"
+    };
+
+    auto isHelperBone = [](const std::string& name) {
+        std::string lower = name;
+        std::transform(lower.begin(), lower.end(), lower.begin(),
+            [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        for (const char* keyword : helperKeywords) {
+            if (lower.find(keyword) != std::string::npos) return true;
+        }
+        return false;
+    };
+
+    m_lodLevels.clear();
+    setActiveLOD(0);
+
+    auto allBones = getAllBones();
+    std::unordered_set<Bone*> collapsed;
+
+    for (int level = 1; level <= levelCount; ++level) {
+        std::vector<Bone*> newlyCollapsed;
+
+        for (const auto& bone : allBones) {
+            if (bone->isRoot() || collapsed.count(bone.get())) continue;
+
+            // A bone is a leaf at this level once all its children are collapsed
+            bool isLeaf = std::all_of(bone->getChildren().begin(), bone->getChildren().end(),
+                [&collapsed](const std::shared_ptr<Bone>& child) { return collapsed.count(child.get()) > 0; });
+
+            bool collapse = false;
+            if (level == 1) {
+                collapse = isHelperBone(bone->getName()) || (isLeaf && bone->getLength() < minBoneLength);
+            } else {
+                collapse = isLeaf;
+            }
+
+            if (collapse) {
+                newlyCollapsed.push_back(bone.get());
+            }
+        }
+
+        if (newlyCollapsed.empty()) break;
+        collapsed.insert(newlyCollapsed.begin(), newlyCollapsed.end());
+
+        SkeletonLOD lod;
+        lod.name = "LOD" + std::to_string(level);
+        lod.screenScaleThreshold = std::pow(0.5f, static_cast<float>(level));
+        for (const auto& bone : allBones) {
+            if (collapsed.count(bone.get())) {
+                lod.collapsedBones.push_back(bone->getName());
+            }
+        }
+        m_lodLevels.push_back(std::move(lod));
+    }
+
+    return static_cast<int>(m_lodLevels.size());
+}
+
+void Rig::setActiveLOD(int level) {
+    level = std::max(0, std::min(level, static_cast<int>(m_lodLevels.size())));
+    if (level == m_activeLOD) return;
+
+    m_activeLOD = level;
+    applyLOD(level);
+}
+
+int Rig::selectLODForScreenScale(float screenScale) const {
+    int level = 0;
+    for (size_t i = 0; i < m_lodLevels.size(); ++i) {
+        if (screenScale < m_lodLevels[i].screenScaleThreshold) {
+            level = static_cast<int>(i) + 1;
+        }
     }
+    return level;
+}
+
+size_t Rig::getEvaluatedBoneCount() const {
+    return getEvaluatedBones().size();
+}
+
+void Rig::applyLOD(int level) {
+    std::unordered_set<std::string> collapsedNames;
+    if (level > 0 && level <= static_cast<int>(m_lodLevels.size())) {
+        const auto& names = m_lodLevels[level - 1].collapsedBones;
+        collapsedNames.insert(names.begin(), names.end());
+    }
+
+    // Walk the hierarchy carrying the nearest surviving ancestor and the offset
+    // pre-composed from the collapsed bones' local transforms
+    std::function<void(std::shared_ptr<Bone>, std::shared_ptr<Bone>, const Transform&)> visit =
+        [&](std::shared_ptr<Bone> bone, std::shared_ptr<Bone> proxy, const Transform& proxyOffset) {
+            bool collapse = proxy != nullptr && (proxy != bone->getParent() || collapsedNames.count(bone->getName()));
+
+            if (collapse) {
+                Transform offset = (proxy == bone->getParent())
+                    ? bone->getLocalTransform()
+                    : combineTransforms(proxyOffset, bone->getLocalTransform());
+                bone->setLODProxy(proxy, offset);
+
+                for (auto& child : bone->getChildren()) {
+                    visit(child, proxy, offset);
+                }
+            } else {
+                bone->clearLODProxy();
+                for (auto& child : bone->getChildren()) {
+                    visit(child, bone, Transform());
+                }
+            }
+        };
+
+    for (auto& root : m_rootBones) {
+        visit(root, nullptr, Transform());
+    }
+
+    m_layoutVersion = s_nextLayoutVersion++;
+    updateWorldTransforms();
 }
 
-} // namespace Riggle
\ No newline at end of file
+} // namespace Riggle
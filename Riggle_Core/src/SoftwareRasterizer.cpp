@@ -0,0 +1,370 @@
+#include "Riggle/SoftwareRasterizer.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RIGGLE_RASTER_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace Riggle {
+
+namespace {
+
+// Vertices snap to 1/256 pixel like a GPU's sub-pixel grid
+const std::int64_t SUBPIXEL = 256;
+
+int fastFloor(float value) {
+    int i = static_cast<int>(value);
+    return value < static_cast<float>(i) ? i - 1 : i;
+}
+
+const std::uint8_t* texel(const RasterImage& texture, int x, int y) {
+    x = std::clamp(x, 0, texture.width - 1);
+    y = std::clamp(y, 0, texture.height - 1);
+    return &texture.pixels[(static_cast<size_t>(y) * texture.width + x) * 4];
+}
+
+#ifdef RIGGLE_RASTER_SSE2
+
+__m128 loadTexel(const std::uint8_t* p) {
+    int packed;
+    std::memcpy(&packed, p, 4);
+    __m128i bytes = _mm_cvtsi32_si128(packed);
+    __m128i zero = _mm_setzero_si128();
+    return _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(bytes, zero), zero));
+}
+
+// Texel colour in 0..255 per channel (RGBA order)
+void sampleNearest(const RasterImage& texture, float u, float v, float* out) {
+    _mm_storeu_ps(out, loadTexel(texel(texture, fastFloor(u), fastFloor(v))));
+}
+
+// Linear filtering samples around texel centres
+void sampleBilinear(const RasterImage& texture, float u, float v, float* out) {
+    float fu = u - 0.5f;
+    float fv = v - 0.5f;
+    int x = fastFloor(fu);
+    int y = fastFloor(fv);
+    float cu = static_cast<float>(x);
+    float cv = static_cast<float>(y);
+    __m128 tx = _mm_set1_ps(fu - cu);
+    __m128 ty = _mm_set1_ps(fv - cv);
+
+    __m128 c00 = loadTexel(texel(texture, x, y));
+    __m128 c10 = loadTexel(texel(texture, x + 1, y));
+    __m128 c01 = loadTexel(texel(texture, x, y + 1));
+    __m128 c11 = loadTexel(texel(texture, x + 1, y + 1));
+    __m128 top = _mm_add_ps(c00, _mm_mul_ps(_mm_sub_ps(c10, c00), tx));
+    __m128 bottom = _mm_add_ps(c01, _mm_mul_ps(_mm_sub_ps(c11, c01), tx));
+    _mm_storeu_ps(out, _mm_add_ps(top, _mm_mul_ps(_mm_sub_ps(bottom, top), ty)));
+}
+
+// SFML's BlendAlpha: rgb = src * srcA + dst * (1 - srcA), a = srcA + dstA * (1 - srcA)
+void blendSpan(const float* source, std::uint8_t* destination, int count) {
+    const __m128 inv255 = _mm_set1_ps(1.0f / 255.0f);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 alphaMask = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+    const __m128i zero = _mm_setzero_si128();
+
+    for (int i = 0; i < count; ++i) {
+        float alpha = source[i * 4 + 3];
+        if (alpha <= 0.0f) continue;
+
+        __m128 src = _mm_loadu_ps(source + i * 4);
+        __m128 sa = _mm_mul_ps(_mm_set1_ps(alpha), inv255);
+        __m128 weight = _mm_or_ps(_mm_andnot_ps(alphaMask, sa), _mm_and_ps(alphaMask, one)); // (sa, sa, sa, 1)
+        __m128 dst = loadTexel(destination + i * 4);
+        __m128 result = _mm_add_ps(_mm_mul_ps(src, weight), _mm_mul_ps(dst, _mm_sub_ps(one, sa)));
+
+        __m128i rounded = _mm_cvtps_epi32(result);
+        __m128i packed = _mm_packus_epi16(_mm_packs_epi32(rounded, zero), zero);
+        int value = _mm_cvtsi128_si32(packed);
+        std::memcpy(destination + i * 4, &value, 4);
+    }
+}
+
+#else
+
+void sampleNearest(const RasterImage& texture, float u, float v, float* out) {
+    const std::uint8_t* c = texel(texture, fastFloor(u), fastFloor(v));
+    for (int k = 0; k < 4; ++k) out[k] = c[k];
+}
+
+void sampleBilinear(const RasterImage& texture, float u, float v, float* out) {
+    float fu = u - 0.5f;
+    float fv = v - 0.5f;
+    int x = fastFloor(fu);
+    int y = fastFloor(fv);
+    float cu = static_cast<float>(x);
+    float cv = static_cast<float>(y);
+    float tx = fu - cu;
+    float ty = fv - cv;
+
+    const std::uint8_t* c00 = texel(texture, x, y);
+    const std::uint8_t* c10 = texel(texture, x + 1, y);
+    const std::uint8_t* c01 = texel(texture, x, y + 1);
+    const std::uint8_t* c11 = texel(texture, x + 1, y + 1);
+    for (int k = 0; k < 4; ++k) {
+        float top = c00[k] + (c10[k] - c00[k]) * tx;
+        float bottom = c01[k] + (c11[k] - c01[k]) * tx;
+        out[k] = top + (bottom - top) * ty;
+    }
+}
+
+void blendSpan(const float* source, std::uint8_t* destination, int count) {
+    for (int i = 0; i < count; ++i) {
+        const float* src = source + i * 4;
+        if (src[3] <= 0.0f) continue;
+
+        std::uint8_t* dst = destination + i * 4;
+        float sa = src[3] * (1.0f / 255.0f);
+        for (int k = 0; k < 3; ++k) {
+            dst[k] = static_cast<std::uint8_t>(std::clamp(std::nearbyint(src[k] * sa + dst[k] * (1.0f - sa)), 0.0f, 255.0f));
+        }
+        dst[3] = static_cast<std::uint8_t>(std::clamp(std::nearbyint(src[3] + dst[3] * (1.0f - sa)), 0.0f, 255.0f));
+    }
+}
+
+#endif
+
+} // namespace
+
+void RasterImage::resize(int newWidth, int newHeight) {
+    width = std::max(newWidth, 0);
+    height = std::max(newHeight, 0);
+    pixels.assign(static_cast<size_t>(width) * height * 4, 0);
+}
+
+SoftwareRasterizer::SoftwareRasterizer() {
+}
+
+void SoftwareRasterizer::begin(int width, int height, std::uint8_t r, std::uint8_t g, std::uint8_t b, std::uint8_t a) {
+    if (m_image.width != width || m_image.height != height) {
+        m_image.resize(width, height);
+    }
+    const std::uint8_t color[4] = {r, g, b, a};
+    std::uint32_t packed;
+    std::memcpy(&packed, color, 4);
+    std::uint32_t* pixels = reinterpret_cast<std::uint32_t*>(m_image.pixels.data());
+    std::fill(pixels, pixels + static_cast<size_t>(m_image.width) * m_image.height, packed);
+    m_triangles.clear();
+}
+
+void SoftwareRasterizer::addTriangle(const RasterVertex& a, const RasterVertex& b, const RasterVertex& c,
+                                     const RasterImage& texture, RasterFilter filter) {
+    if (texture.isEmpty()) return;
+
+    Triangle triangle;
+    triangle.v[0] = a;
+    triangle.v[1] = b;
+    triangle.v[2] = c;
+
+    // Snap to the sub-pixel grid; far off-screen geometry is dropped before it can overflow
+    const float limit = 1048576.0f;
+    for (const RasterVertex* vertex : {&a, &b, &c}) {
+        if (!(std::abs(vertex->position.x) < limit && std::abs(vertex->position.y) < limit)) return;
+    }
+    for (int i = 0; i < 3; ++i) {
+        triangle.fx[i] = static_cast<std::int64_t>(std::llround(triangle.v[i].position.x * SUBPIXEL));
+        triangle.fy[i] = static_cast<std::int64_t>(std::llround(triangle.v[i].position.y * SUBPIXEL));
+    }
+
+    // Keep the interior on the positive side of every edge; flipped sprites arrive mirrored
+    triangle.area = (triangle.fx[1] - triangle.fx[0]) * (triangle.fy[2] - triangle.fy[0]) -
+                    (triangle.fy[1] - triangle.fy[0]) * (triangle.fx[2] - triangle.fx[0]);
+    if (triangle.area == 0) return;
+    if (triangle.area < 0) {
+        std::swap(triangle.v[1], triangle.v[2]);
+        std::swap(triangle.fx[1], triangle.fx[2]);
+        std::swap(triangle.fy[1], triangle.fy[2]);
+        triangle.area = -triangle.area;
+    }
+
+    float minX = std::min({a.position.x, b.position.x, c.position.x});
+    float maxX = std::max({a.position.x, b.position.x, c.position.x});
+    float minY = std::min({a.position.y, b.position.y, c.position.y});
+    float maxY = std::max({a.position.y, b.position.y, c.position.y});
+    // Clamp in float first, far off-screen geometry would overflow an int
+    triangle.minX = static_cast<int>(std::max(0.0f, std::floor(minX)));
+    triangle.minY = static_cast<int>(std::max(0.0f, std::floor(minY)));
+    triangle.maxX = static_cast<int>(std::min(static_cast<float>(m_image.width - 1), std::ceil(maxX)));
+    triangle.maxY = static_cast<int>(std::min(static_cast<float>(m_image.height - 1), std::ceil(maxY)));
+    if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY) return;
+
+    triangle.texture = &texture;
+    triangle.filter = filter;
+    m_triangles.push_back(triangle);
+}
+
+void SoftwareRasterizer::drawTriangles(const std::vector<RasterVertex>& vertices, const RasterImage& texture,
+                                       RasterFilter filter) {
+    for (size_t i = 0; i + 2 < vertices.size(); i += 3) {
+        addTriangle(vertices[i], vertices[i + 1], vertices[i + 2], texture, filter);
+    }
+}
+
+void SoftwareRasterizer::drawQuad(const Vector2 corners[4], const RasterImage& texture, RasterFilter filter) {
+    // Corners clockwise from top-left; split along the same diagonal as sf::Sprite's triangle strip
+    const float w = static_cast<float>(texture.width);
+    const float h = static_cast<float>(texture.height);
+    RasterVertex topLeft{corners[0], Vector2(0.0f, 0.0f)};
+    RasterVertex topRight{corners[1], Vector2(w, 0.0f)};
+    RasterVertex bottomRight{corners[2], Vector2(w, h)};
+    RasterVertex bottomLeft{corners[3], Vector2(0.0f, h)};
+    addTriangle(topLeft, bottomLeft, topRight, texture, filter);
+    addTriangle(bottomLeft, topRight, bottomRight, texture, filter);
+}
+
+void SoftwareRasterizer::binTriangles() {
+    m_tilesX = (m_image.width + m_tileSize - 1) / m_tileSize;
+    m_tilesY = (m_image.height + m_tileSize - 1) / m_tileSize;
+    const int tileCount = m_tilesX * m_tilesY;
+
+    // Count, prefix sum, fill - bins stay in draw order
+    m_binBegin.assign(tileCount + 1, 0);
+    for (const auto& triangle : m_triangles) {
+        for (int ty = triangle.minY / m_tileSize; ty <= triangle.maxY / m_tileSize; ++ty) {
+            for (int tx = triangle.minX / m_tileSize; tx <= triangle.maxX / m_tileSize; ++tx) {
+                ++m_binBegin[ty * m_tilesX + tx + 1];
+            }
+        }
+    }
+    for (int t = 0; t < tileCount; ++t) {
+        m_binBegin[t + 1] += m_binBegin[t];
+    }
+
+    m_binTriangles.assign(m_binBegin[tileCount], 0);
+    std::vector<int> cursor(m_binBegin.begin(), m_binBegin.end() - 1);
+    for (size_t i = 0; i < m_triangles.size(); ++i) {
+        const Triangle& triangle = m_triangles[i];
+        for (int ty = triangle.minY / m_tileSize; ty <= triangle.maxY / m_tileSize; ++ty) {
+            for (int tx = triangle.minX / m_tileSize; tx <= triangle.maxX / m_tileSize; ++tx) {
+                m_binTriangles[cursor[ty * m_tilesX + tx]++] = static_cast<int>(i);
+            }
+        }
+    }
+}
+
+void SoftwareRasterizer::finish() {
+    if (m_image.isEmpty() || m_triangles.empty()) return;
+
+    binTriangles();
+    const int tileCount = m_tilesX * m_tilesY;
+
+    // Tiles share no pixels, so workers just pull the next tile
+    std::atomic<int> nextTile(0);
+    auto worker = [this, &nextTile, tileCount]() {
+        std::vector<float> span;
+        for (int tile = nextTile++; tile < tileCount; tile = nextTile++) {
+            renderTile(tile, span);
+        }
+    };
+
+    const unsigned int hardware = std::max(1u, std::thread::hardware_concurrency());
+    const unsigned int threads = m_threadCount > 0 ? m_threadCount : hardware;
+    m_workers.setHelperThreadCount(threads - 1);
+    m_workers.run(std::min<size_t>(threads, static_cast<size_t>(tileCount)), [&worker](size_t) { worker(); });
+    m_triangles.clear();
+}
+
+void SoftwareRasterizer::renderTile(int tile, std::vector<float>& span) {
+    const int x0 = (tile % m_tilesX) * m_tileSize;
+    const int y0 = (tile / m_tilesX) * m_tileSize;
+    const int x1 = std::min(x0 + m_tileSize, m_image.width);
+    const int y1 = std::min(y0 + m_tileSize, m_image.height);
+
+    for (int i = m_binBegin[tile]; i < m_binBegin[tile + 1]; ++i) {
+        rasterizeTriangle(m_triangles[m_binTriangles[i]], x0, y0, x1, y1, span);
+    }
+}
+
+void SoftwareRasterizer::rasterizeTriangle(const Triangle& triangle, int x0, int y0, int x1, int y1,
+                                           std::vector<float>& span) {
+    const int startX = std::max(x0, triangle.minX);
+    const int endX = std::min(x1 - 1, triangle.maxX);
+    const int startY = std::max(y0, triangle.minY);
+    const int endY = std::min(y1 - 1, triangle.maxY);
+    if (startX > endX || startY > endY) return;
+
+    // Edge e is opposite vertex e; its value is that vertex's barycentric weight * area.
+    // Integer edge values make shared edges exact: every pixel goes to exactly one side.
+    const std::int64_t* fx = triangle.fx;
+    const std::int64_t* fy = triangle.fy;
+    const int from[3] = {1, 2, 0};
+    const int to[3] = {2, 0, 1};
+    std::int64_t stepX[3];
+    std::int64_t bias[3];
+    for (int e = 0; e < 3; ++e) {
+        std::int64_t dx = fx[to[e]] - fx[from[e]];
+        std::int64_t dy = fy[to[e]] - fy[from[e]];
+        stepX[e] = -dy * SUBPIXEL;
+        bias[e] = (dy < 0 || (dy == 0 && dx > 0)) ? 0 : -1; // Top-left edges keep their pixels
+    }
+    auto edgeAt = [&](int e, std::int64_t px, std::int64_t py) {
+        return (fx[to[e]] - fx[from[e]]) * (py - fy[from[e]]) - (fy[to[e]] - fy[from[e]]) * (px - fx[from[e]]);
+    };
+
+    const Vector2& uvA = triangle.v[0].uv;
+    const Vector2& uvB = triangle.v[1].uv;
+    const Vector2& uvC = triangle.v[2].uv;
+    const double invArea = 1.0 / static_cast<double>(triangle.area);
+    const float duDx = static_cast<float>((stepX[0] * uvA.x + stepX[1] * uvB.x + stepX[2] * uvC.x) * invArea);
+    const float dvDx = static_cast<float>((stepX[0] * uvA.y + stepX[1] * uvB.y + stepX[2] * uvC.y) * invArea);
+
+    span.resize(static_cast<size_t>(endX - startX + 1) * 4);
+    const int rowStride = m_image.width * 4;
+    std::uint8_t* pixels = m_image.pixels.data();
+    const std::int64_t last = endX - startX;
+
+    for (int y = startY; y <= endY; ++y) {
+        const std::int64_t py = static_cast<std::int64_t>(y) * SUBPIXEL + SUBPIXEL / 2;
+        const std::int64_t px = static_cast<std::int64_t>(startX) * SUBPIXEL + SUBPIXEL / 2;
+
+        // Convex, so the covered pixels of a row are one run: solve w + bias + k * step >= 0 per edge
+        std::int64_t w[3];
+        std::int64_t first = 0;
+        std::int64_t final = last;
+        for (int e = 0; e < 3; ++e) {
+            w[e] = edgeAt(e, px, py);
+            std::int64_t value = w[e] + bias[e];
+            if (stepX[e] > 0) {
+                if (value < 0) first = std::max(first, (-value + stepX[e] - 1) / stepX[e]);
+            } else if (stepX[e] < 0) {
+                if (value < 0) { final = -1; break; }
+                final = std::min(final, value / -stepX[e]);
+            } else if (value < 0) {
+                final = -1;
+                break;
+            }
+        }
+        if (first > final) continue;
+
+        // Texture coordinates from the exact weights at the run start, then stepped
+        double w0 = static_cast<double>(w[0] + stepX[0] * first);
+        double w1 = static_cast<double>(w[1] + stepX[1] * first);
+        double w2 = static_cast<double>(w[2] + stepX[2] * first);
+        float u = static_cast<float>((w0 * uvA.x + w1 * uvB.x + w2 * uvC.x) * invArea);
+        float v = static_cast<float>((w0 * uvA.y + w1 * uvB.y + w2 * uvC.y) * invArea);
+
+        const int count = static_cast<int>(final - first + 1);
+        float* out = span.data();
+        if (triangle.filter == RasterFilter::Nearest) {
+            for (int i = 0; i < count; ++i, out += 4, u += duDx, v += dvDx) {
+                sampleNearest(*triangle.texture, u, v, out);
+            }
+        } else {
+            for (int i = 0; i < count; ++i, out += 4, u += duDx, v += dvDx) {
+                sampleBilinear(*triangle.texture, u, v, out);
+            }
+        }
+
+        const int runStart = startX + static_cast<int>(first);
+        blendSpan(span.data(), pixels + static_cast<size_t>(y) * rowStride + runStart * 4, count);
+    }
+}
+
+} // namespace Riggle
@@ -0,0 +1,384 @@
+#include "Riggle/SpringBoneSolver.h"
+#include "Riggle/Rig.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <unordered_map>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RIGGLE_SPRING_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace Riggle {
+
+namespace {
+
+float wrapAngle(float angle) {
+    const float PI = 3.14159265f;
+    while (angle > PI) angle -= 2.0f * PI;
+    while (angle < -PI) angle += 2.0f * PI;
+    return angle;
+}
+
+} // namespace
+
+SpringBoneSolver::SpringBoneSolver() {
+}
+
+void SpringBoneSolver::clear() {
+    m_pendingParent.clear();
+    m_pendingParams.clear();
+    m_slotOf.clear();
+    m_parentSlot.clear();
+    m_layerStart.clear();
+
+    for (auto* array : {&m_length, &m_stiffness, &m_damping, &m_gravity,
+                        &m_localX, &m_localY, &m_localRot, &m_localSX, &m_localSY,
+                        &m_anchorX, &m_anchorY, &m_anchorRot, &m_anchorSX, &m_anchorSY,
+                        &m_headX, &m_headY, &m_simRot, &m_restRot,
+                        &m_tailX, &m_tailY, &m_prevX, &m_prevY, &m_tipX, &m_tipY}) {
+        array->clear();
+    }
+
+    m_rig = nullptr;
+    m_bones.clear();
+    m_inputRot.clear();
+    m_writtenRot.clear();
+    m_hasWritten.clear();
+    reset();
+}
+
+int SpringBoneSolver::addBone(int parentIndex, const SpringBoneParams& params) {
+    int index = static_cast<int>(m_pendingParent.size());
+    m_pendingParent.push_back(parentIndex >= 0 && parentIndex < index ? parentIndex : -1);
+    m_pendingParams.push_back(params);
+    return index;
+}
+
+void SpringBoneSolver::finalize() {
+    const int count = static_cast<int>(m_pendingParent.size());
+
+    // Depth in chain - parents are always added first
+    std::vector<int> depth(count, 0);
+    int maxDepth = 0;
+    for (int i = 0; i < count; ++i) {
+        if (m_pendingParent[i] >= 0) depth[i] = depth[m_pendingParent[i]] + 1;
+        maxDepth = std::max(maxDepth, depth[i]);
+    }
+
+    // Slots ordered by depth so every layer is a contiguous range
+    std::vector<int> order(count);
+    for (int i = 0; i < count; ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&depth](int a, int b) { return depth[a] < depth[b]; });
+
+    m_slotOf.assign(count, 0);
+    for (int slot = 0; slot < count; ++slot) {
+        m_slotOf[order[slot]] = slot;
+    }
+
+    m_layerStart.assign(1, 0);
+    for (int slot = 1; slot < count; ++slot) {
+        if (depth[order[slot]] != depth[order[slot - 1]]) m_layerStart.push_back(slot);
+    }
+    m_layerStart.push_back(count);
+
+    for (auto* array : {&m_length, &m_stiffness, &m_damping, &m_gravity,
+                        &m_localX, &m_localY, &m_localRot,
+                        &m_anchorX, &m_anchorY, &m_anchorRot,
+                        &m_headX, &m_headY, &m_simRot, &m_restRot,
+                        &m_tailX, &m_tailY, &m_prevX, &m_prevY, &m_tipX, &m_tipY}) {
+        array->assign(count, 0.0f);
+    }
+    for (auto* array : {&m_localSX, &m_localSY, &m_anchorSX, &m_anchorSY}) {
+        array->assign(count, 1.0f);
+    }
+
+    m_parentSlot.assign(count, -1);
+    for (int i = 0; i < count; ++i) {
+        int slot = m_slotOf[i];
+        if (m_pendingParent[i] >= 0) m_parentSlot[slot] = m_slotOf[m_pendingParent[i]];
+        setParams(i, m_pendingParams[i]);
+    }
+
+    reset();
+}
+
+void SpringBoneSolver::setParams(int index, const SpringBoneParams& params) {
+    int slot = m_slotOf[index];
+    m_stiffness[slot] = std::clamp(params.stiffness, 0.0f, 1.0f);
+    m_damping[slot] = std::clamp(params.damping, 0.0f, 1.0f);
+    m_gravity[slot] = params.gravity;
+}
+
+void SpringBoneSolver::setAnimatedPose(int index, const Transform& local) {
+    int slot = m_slotOf[index];
+    m_localX[slot] = local.position.x;
+    m_localY[slot] = local.position.y;
+    m_localRot[slot] = local.rotation;
+    m_localSX[slot] = local.scale.x;
+    m_localSY[slot] = local.scale.y;
+    m_length[slot] = local.length;
+}
+
+void SpringBoneSolver::setAnchor(int index, const Transform& parentWorld) {
+    int slot = m_slotOf[index];
+    m_anchorX[slot] = parentWorld.position.x;
+    m_anchorY[slot] = parentWorld.position.y;
+    m_anchorRot[slot] = parentWorld.rotation;
+    m_anchorSX[slot] = parentWorld.scale.x;
+    m_anchorSY[slot] = parentWorld.scale.y;
+}
+
+void SpringBoneSolver::reset() {
+    m_accumulator = 0.0f;
+    m_needsSeat = true;
+}
+
+void SpringBoneSolver::step(float deltaTime) {
+    if (!m_enabled || m_slotOf.empty()) return;
+
+    if (m_needsSeat) {
+        simulate(0.0f, true);
+        m_needsSeat = false;
+        return;
+    }
+
+    m_accumulator += std::max(0.0f, deltaTime);
+
+    int steps = 0;
+    while (m_accumulator + 1e-6f >= m_fixedTimeStep && steps < m_maxSubsteps) {
+        simulate(m_fixedTimeStep, false);
+        m_accumulator -= m_fixedTimeStep;
+        ++steps;
+    }
+
+    // Drop backlog after a long hitch instead of spiralling
+    if (steps == m_maxSubsteps) {
+        m_accumulator = std::min(m_accumulator, m_fixedTimeStep);
+    }
+    m_accumulator = std::max(0.0f, m_accumulator);
+}
+
+float SpringBoneSolver::getLocalRotation(int index) const {
+    int slot = m_slotOf[index];
+    return m_localRot[slot] + wrapAngle(m_simRot[slot] - m_restRot[slot]);
+}
+
+void SpringBoneSolver::simulate(float dt, bool seatOnly) {
+    const float gravityStep = dt * dt;
+
+    for (size_t layer = 0; layer + 1 < m_layerStart.size(); ++layer) {
+        const int begin = m_layerStart[layer];
+        const int end = m_layerStart[layer + 1];
+
+        // Chain children hang off their simulated parent (layer 0 roots keep the animated anchor)
+        if (layer > 0) {
+            for (int i = begin; i < end; ++i) {
+                const int p = m_parentSlot[i];
+                m_anchorX[i] = m_headX[p];
+                m_anchorY[i] = m_headY[p];
+                m_anchorRot[i] = m_simRot[p];
+                m_anchorSX[i] = m_anchorSX[p] * m_localSX[p];
+                m_anchorSY[i] = m_anchorSY[p] * m_localSY[p];
+            }
+        }
+
+        // Animated head and tip; the trig stays scalar
+        for (int i = begin; i < end; ++i) {
+            const float cosA = std::cos(m_anchorRot[i]);
+            const float sinA = std::sin(m_anchorRot[i]);
+            const float headX = m_anchorX[i] + (cosA * m_localX[i] - sinA * m_localY[i]) * m_anchorSX[i];
+            const float headY = m_anchorY[i] + (sinA * m_localX[i] + cosA * m_localY[i]) * m_anchorSY[i];
+
+            const float restRot = m_anchorRot[i] + m_localRot[i];
+            const float scaleX = m_anchorSX[i] * m_localSX[i];
+            const float scaleY = m_anchorSY[i] * m_localSY[i];
+            m_headX[i] = headX;
+            m_headY[i] = headY;
+            m_restRot[i] = restRot;
+            m_tipX[i] = headX + std::cos(restRot) * m_length[i] * scaleX;
+            m_tipY[i] = headY + std::sin(restRot) * m_length[i] * scaleY;
+
+            if (seatOnly) {
+                m_tailX[i] = m_prevX[i] = m_tipX[i];
+                m_tailY[i] = m_prevY[i] = m_tipY[i];
+                m_simRot[i] = restRot;
+            }
+        }
+        if (seatOnly) continue;
+
+        integrate(begin, end, gravityStep);
+
+        // Back to a bone rotation (undo non-uniform scale on the direction)
+        for (int i = begin; i < end; ++i) {
+            const float scaleX = m_anchorSX[i] * m_localSX[i];
+            const float scaleY = m_anchorSY[i] * m_localSY[i];
+            const float safeSX = std::abs(scaleX) > 1e-6f ? scaleX : 1.0f;
+            const float safeSY = std::abs(scaleY) > 1e-6f ? scaleY : 1.0f;
+            m_simRot[i] = std::atan2((m_tailY[i] - m_headY[i]) / safeSY, (m_tailX[i] - m_headX[i]) / safeSX);
+        }
+    }
+}
+
+void SpringBoneSolver::integrate(int begin, int end, float gravityStep) {
+    // Verlet: inertia + spring toward the animated tip + gravity, then back to the bone length.
+    // Pure arithmetic over the layer's arrays; SSE2 takes four bones per step.
+    int i = begin;
+
+#ifdef RIGGLE_SPRING_SSE2
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 minDistance = _mm_set1_ps(1e-6f);
+    const __m128 gravity = _mm_set1_ps(gravityStep);
+    for (; i + 4 <= end; i += 4) {
+        const __m128 tailX = _mm_loadu_ps(&m_tailX[i]);
+        const __m128 tailY = _mm_loadu_ps(&m_tailY[i]);
+        const __m128 tipX = _mm_loadu_ps(&m_tipX[i]);
+        const __m128 tipY = _mm_loadu_ps(&m_tipY[i]);
+        const __m128 headX = _mm_loadu_ps(&m_headX[i]);
+        const __m128 headY = _mm_loadu_ps(&m_headY[i]);
+        const __m128 keep = _mm_sub_ps(one, _mm_loadu_ps(&m_damping[i]));
+        const __m128 stiffness = _mm_loadu_ps(&m_stiffness[i]);
+
+        __m128 nextX = _mm_add_ps(_mm_add_ps(tailX, _mm_mul_ps(_mm_sub_ps(tailX, _mm_loadu_ps(&m_prevX[i])), keep)),
+                                  _mm_mul_ps(_mm_sub_ps(tipX, tailX), stiffness));
+        __m128 nextY = _mm_add_ps(_mm_add_ps(tailY, _mm_mul_ps(_mm_sub_ps(tailY, _mm_loadu_ps(&m_prevY[i])), keep)),
+                                  _mm_mul_ps(_mm_sub_ps(tipY, tailY), stiffness));
+        nextY = _mm_add_ps(nextY, _mm_mul_ps(_mm_loadu_ps(&m_gravity[i]), gravity));
+
+        const __m128 restX = _mm_sub_ps(tipX, headX);
+        const __m128 restY = _mm_sub_ps(tipY, headY);
+        const __m128 restLength = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(restX, restX), _mm_mul_ps(restY, restY)));
+        const __m128 dx = _mm_sub_ps(nextX, headX);
+        const __m128 dy = _mm_sub_ps(nextY, headY);
+        const __m128 distance = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+
+        // Lanes at the head fall back to the animated tip (their ratio is never used)
+        const __m128 valid = _mm_cmpgt_ps(distance, minDistance);
+        const __m128 ratio = _mm_div_ps(restLength, distance);
+        nextX = _mm_or_ps(_mm_and_ps(valid, _mm_add_ps(headX, _mm_mul_ps(dx, ratio))), _mm_andnot_ps(valid, tipX));
+        nextY = _mm_or_ps(_mm_and_ps(valid, _mm_add_ps(headY, _mm_mul_ps(dy, ratio))), _mm_andnot_ps(valid, tipY));
+
+        _mm_storeu_ps(&m_prevX[i], tailX);
+        _mm_storeu_ps(&m_prevY[i], tailY);
+        _mm_storeu_ps(&m_tailX[i], nextX);
+        _mm_storeu_ps(&m_tailY[i], nextY);
+    }
+#endif
+
+    for (; i < end; ++i) {
+        const float keep = 1.0f - m_damping[i];
+        float nextX = m_tailX[i] + (m_tailX[i] - m_prevX[i]) * keep + (m_tipX[i] - m_tailX[i]) * m_stiffness[i];
+        float nextY = m_tailY[i] + (m_tailY[i] - m_prevY[i]) * keep + (m_tipY[i] - m_tailY[i]) * m_stiffness[i]
+                    + m_gravity[i] * gravityStep;
+
+        const float restX = m_tipX[i] - m_headX[i];
+        const float restY = m_tipY[i] - m_headY[i];
+        const float restLength = std::sqrt(restX * restX + restY * restY);
+        const float dx = nextX - m_headX[i];
+        const float dy = nextY - m_headY[i];
+        const float distance = std::sqrt(dx * dx + dy * dy);
+        const bool valid = distance > 1e-6f;
+        nextX = valid ? m_headX[i] + dx * (restLength / distance) : m_tipX[i];
+        nextY = valid ? m_headY[i] + dy * (restLength / distance) : m_tipY[i];
+
+        m_prevX[i] = m_tailX[i];
+        m_prevY[i] = m_tailY[i];
+        m_tailX[i] = nextX;
+        m_tailY[i] = nextY;
+    }
+}
+
+void SpringBoneSolver::rebuildFromRig(Rig* rig) {
+    clear();
+
+    // Hierarchy order guarantees parents are added before children
+    std::unordered_map<const Bone*, int> indexOf;
+    std::function<void(const std::shared_ptr<Bone>&)> visit = [&](const std::shared_ptr<Bone>& bone) {
+        if (!bone) return;
+        if (bone->isSpringBone()) {
+            auto parent = bone->getParent();
+            auto it = parent ? indexOf.find(parent.get()) : indexOf.end();
+            int parentIndex = it != indexOf.end() ? it->second : -1;
+
+            indexOf[bone.get()] = addBone(parentIndex, bone->getSpringParams());
+            m_bones.push_back(bone);
+        }
+        for (const auto& child : bone->getChildren()) {
+            visit(child);
+        }
+    };
+    for (const auto& root : rig->getRootBones()) {
+        visit(root);
+    }
+
+    finalize();
+    m_inputRot.assign(m_bones.size(), 0.0f);
+    m_writtenRot.assign(m_bones.size(), 0.0f);
+    m_hasWritten.assign(m_bones.size(), false);
+
+    m_rig = rig;
+    m_rigVersion = rig->getSetupVersion();
+}
+
+bool SpringBoneSolver::getAnimatedLocalRotation(const std::string& boneName, float& rotation) const {
+    for (size_t i = 0; i < m_bones.size(); ++i) {
+        auto bone = m_bones[i].lock();
+        if (!bone || bone->getName() != boneName || !m_hasWritten[i]) continue;
+
+        // Only if nothing re-posed the bone since our write-back
+        if (bone->getLocalTransform().rotation != m_writtenRot[i]) return false;
+        rotation = m_inputRot[i];
+        return true;
+    }
+    return false;
+}
+
+void SpringBoneSolver::update(Rig* rig, float deltaTime) {
+    if (!rig || !m_enabled) return;
+
+    if (rig != m_rig || rig->getSetupVersion() != m_rigVersion) {
+        rebuildFromRig(rig);
+    }
+    if (m_bones.empty()) return;
+
+    // Gather the animated pose
+    for (size_t i = 0; i < m_bones.size(); ++i) {
+        auto bone = m_bones[i].lock();
+        if (!bone) {
+            m_rig = nullptr; // Rebuild next frame
+            return;
+        }
+
+        const int index = static_cast<int>(i);
+        setParams(index, bone->getSpringParams());
+
+        // Unchanged since our write-back means nothing re-posed the bone this frame
+        Transform local = bone->getLocalTransform();
+        if (!(m_hasWritten[i] && local.rotation == m_writtenRot[i])) {
+            m_inputRot[i] = local.rotation;
+        }
+        local.rotation = m_inputRot[i];
+        setAnimatedPose(index, local);
+
+        if (m_parentSlot[m_slotOf[index]] < 0) {
+            auto parent = bone->getParent();
+            setAnchor(index, parent ? parent->getWorldTransform() : Transform());
+        }
+    }
+
+    step(deltaTime);
+
+    // Write back once per bone
+    for (size_t i = 0; i < m_bones.size(); ++i) {
+        auto bone = m_bones[i].lock();
+        Transform local = bone->getLocalTransform();
+        local.rotation = getLocalRotation(static_cast<int>(i));
+        bone->setLocalTransform(local);
+
+        m_writtenRot[i] = bone->getLocalTransform().rotation;
+        m_hasWritten[i] = true;
+    }
+}
+
+} // namespace Riggle
@@ -1,6 +1,7 @@
 #include "Riggle/Sprite.h"
 #include "Riggle/Bone.h"
 #include <cmath>
+#include <limits>
 
 namespace Riggle {
 
@@ -15,35 +16,9 @@ Sprite::Sprite(const std::string& name, const std::string& texturePath)
 
 Transform Sprite::getWorldTransform() const {
     if (isBoundToBone()) {
-        // Calculate transform based on bone
-        Transform boneWorld = m_binding.bone->getWorldTransform();
-        
-        // Apply binding offset and rotation
-        Transform result;
-        
-        // Position calculation using proper offset transformation
-        float cosRot = std::cos(boneWorld.rotation);
-        float sinRot = std::sin(boneWorld.rotation);
-        
-        // Transform binding offset by bone's rotation and scale
-        float rotatedOffsetX = m_binding.bindOffset.x * cosRot - m_binding.bindOffset.y * sinRot;
-        float rotatedOffsetY = m_binding.bindOffset.x * sinRot + m_binding.bindOffset.y * cosRot;
-        
-        // Apply bone scale to the rotated offset
-        result.position.x = boneWorld.position.x + (rotatedOffsetX * boneWorld.scale.x);
-        result.position.y = boneWorld.position.y + (rotatedOffsetY * boneWorld.scale.y);
-        
-        // Rotation: bone rotation + binding rotation
-        result.rotation = boneWorld.rotation + m_binding.bindRotation;
-        
-        // Scale: combine bone and sprite scale
-        result.scale.x = boneWorld.scale.x * m_localTransform.scale.x;
-        result.scale.y = boneWorld.scale.y * m_localTransform.scale.y;
-        
-        // Length (if applicable)
-        result.length = m_localTransform.length;
-        
-        return result;
+        // Same binding math as the export pose evaluator
+        return bindTransform(m_binding.bone->getWorldTransform(), m_binding.bindOffset,
+                             m_binding.bindRotation, m_localTransform);
     } else {
         // Use local transform as world transform
         return m_localTransform;
@@ -103,4 +78,166 @@ void Sprite::restoreBinding(std::shared_ptr<Bone> bone, const Vector2& localOffs
     bone->addBoundSprite(shared_from_this());
 }
 
+void Sprite::setMesh(const SpriteMesh& mesh) {
+    if (!isSkinned() || mesh.isEmpty()) {
+        clearSkin();
+        m_mesh = mesh;
+        return;
+    }
+
+    // Map mesh space to bind space with the old mesh's largest triangle
+    // (bind vertices are the mesh under the sprite's transform at bind time)
+    const std::vector<Vector2>& oldVertices = m_mesh.vertices;
+    size_t best = 0;
+    float bestArea = 0.0f;
+    for (size_t t = 0; t + 2 < m_mesh.indices.size(); t += 3) {
+        const Vector2& p0 = oldVertices[m_mesh.indices[t]];
+        const Vector2& p1 = oldVertices[m_mesh.indices[t + 1]];
+        const Vector2& p2 = oldVertices[m_mesh.indices[t + 2]];
+        float area = std::abs((p1.x - p0.x) * (p2.y - p0.y) - (p1.y - p0.y) * (p2.x - p0.x));
+        if (area > bestArea) {
+            bestArea = area;
+            best = t;
+        }
+    }
+    if (bestArea < 1e-4f) {
+        clearSkin();
+        m_mesh = mesh;
+        return;
+    }
+
+    const unsigned int i0 = m_mesh.indices[best], i1 = m_mesh.indices[best + 1], i2 = m_mesh.indices[best + 2];
+    Affine2 meshEdges;
+    meshEdges.a = oldVertices[i1].x - oldVertices[i0].x; meshEdges.b = oldVertices[i2].x - oldVertices[i0].x;
+    meshEdges.c = oldVertices[i1].y - oldVertices[i0].y; meshEdges.d = oldVertices[i2].y - oldVertices[i0].y;
+    Affine2 bindEdges;
+    bindEdges.a = m_skin.bindX[i1] - m_skin.bindX[i0]; bindEdges.b = m_skin.bindX[i2] - m_skin.bindX[i0];
+    bindEdges.c = m_skin.bindY[i1] - m_skin.bindY[i0]; bindEdges.d = m_skin.bindY[i2] - m_skin.bindY[i0];
+    Affine2 meshToBind = bindEdges * meshEdges.inverse();
+    Vector2 origin = meshToBind.apply(oldVertices[i0]);
+    meshToBind.tx = m_skin.bindX[i0] - origin.x;
+    meshToBind.ty = m_skin.bindY[i0] - origin.y;
+
+    // Each new vertex keeps the authored weights of the nearest old vertex
+    const std::vector<VertexWeights> oldWeights = m_skin.getVertexWeights();
+    std::vector<Vector2> bindVertices;
+    std::vector<VertexWeights> weights;
+    bindVertices.reserve(mesh.vertices.size());
+    weights.reserve(mesh.vertices.size());
+    for (const Vector2& vertex : mesh.vertices) {
+        size_t nearest = 0;
+        float nearestDistance = std::numeric_limits<float>::max();
+        for (size_t i = 0; i < oldVertices.size(); ++i) {
+            float dx = oldVertices[i].x - vertex.x;
+            float dy = oldVertices[i].y - vertex.y;
+            float distance = dx * dx + dy * dy;
+            if (distance < nearestDistance) {
+                nearestDistance = distance;
+                nearest = i;
+            }
+        }
+        bindVertices.push_back(meshToBind.apply(vertex));
+        weights.push_back(oldWeights[nearest]);
+    }
+
+    const std::vector<std::shared_ptr<Bone>> bones = m_skinBones;
+    const std::vector<Transform> bindPoses = m_skin.bindPoses;
+    m_mesh = mesh;
+    if (!restoreSkin(bones, bindPoses, bindVertices, weights)) {
+        clearSkin();
+    }
+}
+
+void Sprite::clearMesh() {
+    clearSkin();
+    m_mesh = SpriteMesh();
+}
+
+std::vector<Vector2> Sprite::getMeshWorldVertices() const {
+    Affine2 world = Affine2::fromTRS(getWorldTransform());
+
+    std::vector<Vector2> vertices;
+    vertices.reserve(m_mesh.vertices.size());
+    for (const auto& vertex : m_mesh.vertices) {
+        vertices.push_back(world.apply(vertex));
+    }
+    return vertices;
+}
+
+bool Sprite::bindSkin(const std::vector<std::shared_ptr<Bone>>& bones, const std::vector<VertexWeights>& weights) {
+    if (!hasMesh() || bones.empty() || weights.size() != m_mesh.getVertexCount()) {
+        return false;
+    }
+
+    std::vector<Transform> bindPoses;
+    bindPoses.reserve(bones.size());
+    for (const auto& bone : bones) {
+        if (!bone) return false;
+        bindPoses.push_back(bone->getWorldTransform());
+    }
+
+    return restoreSkin(bones, bindPoses, getMeshWorldVertices(), weights);
+}
+
+bool Sprite::bindSkinAutoWeights(const std::vector<std::shared_ptr<Bone>>& bones, float falloff) {
+    if (!hasMesh() || bones.empty()) return false;
+
+    std::vector<Transform> boneWorlds;
+    boneWorlds.reserve(bones.size());
+    for (const auto& bone : bones) {
+        if (!bone) return false;
+        boneWorlds.push_back(bone->getWorldTransform());
+    }
+
+    auto weights = computeAutoWeights(getMeshWorldVertices(), boneWorlds, MAX_BONE_INFLUENCES, falloff);
+    return bindSkin(bones, weights);
+}
+
+bool Sprite::restoreSkin(const std::vector<std::shared_ptr<Bone>>& bones, const std::vector<Transform>& bindPoses,
+                         const std::vector<Vector2>& bindVertices, const std::vector<VertexWeights>& weights) {
+    if (bones.empty() || bones.size() != bindPoses.size() ||
+        bindVertices.size() != m_mesh.getVertexCount() || weights.size() != bindVertices.size()) {
+        return false;
+    }
+
+    m_skinBones = bones;
+    m_skin.setBindPoses(bindPoses);
+    m_skin.setBindVertices(bindVertices);
+    m_skin.setVertexWeights(weights);
+    return true;
+}
+
+void Sprite::clearSkin() {
+    m_skinBones.clear();
+    m_skin.clear();
+    m_skinMatrices.clear();
+}
+
+bool Sprite::computeDeformedVertices(std::vector<float>& outX, std::vector<float>& outY) const {
+    if (!hasMesh()) return false;
+
+    const size_t count = m_mesh.getVertexCount();
+    outX.resize(count);
+    outY.resize(count);
+
+    if (!isSkinned()) {
+        Affine2 world = Affine2::fromTRS(getWorldTransform());
+        for (size_t i = 0; i < count; ++i) {
+            Vector2 p = world.apply(m_mesh.vertices[i]);
+            outX[i] = p.x;
+            outY[i] = p.y;
+        }
+        return true;
+    }
+
+    // Skin matrix = current bone world * inverse bind pose
+    m_skinMatrices.resize(m_skinBones.size());
+    for (size_t j = 0; j < m_skinBones.size(); ++j) {
+        m_skinMatrices[j] = Affine2::fromTransform(m_skinBones[j]->getWorldTransform()) * m_skin.inverseBindMatrices[j];
+    }
+
+    skinVertices(m_skin, m_skinMatrices, outX.data(), outY.data());
+    return true;
+}
+
 } // namespace Riggle
\ No newline at end of file
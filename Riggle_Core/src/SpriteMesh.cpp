@@ -0,0 +1,230 @@
+#include "Riggle/SpriteMesh.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RIGGLE_SKIN_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace Riggle {
+
+SpriteMesh SpriteMesh::createGrid(float width, float height, int columns, int rows) {
+    SpriteMesh mesh;
+    columns = std::max(1, columns);
+    rows = std::max(1, rows);
+
+    mesh.vertices.reserve((columns + 1) * (rows + 1));
+    mesh.uvs.reserve((columns + 1) * (rows + 1));
+    mesh.indices.reserve(columns * rows * 6);
+
+    for (int y = 0; y <= rows; ++y) {
+        for (int x = 0; x <= columns; ++x) {
+            float u = width * x / columns;
+            float v = height * y / rows;
+            mesh.uvs.emplace_back(u, v);
+            mesh.vertices.emplace_back(u - width * 0.5f, v - height * 0.5f);
+        }
+    }
+
+    for (int y = 0; y < rows; ++y) {
+        for (int x = 0; x < columns; ++x) {
+            unsigned int i0 = y * (columns + 1) + x;
+            unsigned int i1 = i0 + 1;
+            unsigned int i2 = i0 + (columns + 1);
+            unsigned int i3 = i2 + 1;
+            mesh.indices.insert(mesh.indices.end(), {i0, i1, i2, i1, i3, i2});
+        }
+    }
+
+    return mesh;
+}
+
+void SkinData::clear() {
+    bindPoses.clear();
+    inverseBindMatrices.clear();
+    bindX.clear();
+    bindY.clear();
+    for (int k = 0; k < MAX_BONE_INFLUENCES; ++k) {
+        boneIndices[k].clear();
+        weights[k].clear();
+    }
+    influenceCount = 0;
+}
+
+void SkinData::setBindPoses(const std::vector<Transform>& poses) {
+    bindPoses = poses;
+    inverseBindMatrices.clear();
+    inverseBindMatrices.reserve(poses.size());
+    for (const auto& pose : poses) {
+        inverseBindMatrices.push_back(Affine2::fromTransform(pose).inverse());
+    }
+}
+
+void SkinData::setBindVertices(const std::vector<Vector2>& worldVertices) {
+    bindX.resize(worldVertices.size());
+    bindY.resize(worldVertices.size());
+    for (size_t i = 0; i < worldVertices.size(); ++i) {
+        bindX[i] = worldVertices[i].x;
+        bindY[i] = worldVertices[i].y;
+    }
+}
+
+void SkinData::setVertexWeights(const std::vector<VertexWeights>& vertexWeights) {
+    const size_t count = vertexWeights.size();
+    const int maxBone = std::max(0, static_cast<int>(bindPoses.size()) - 1);
+
+    for (int k = 0; k < MAX_BONE_INFLUENCES; ++k) {
+        boneIndices[k].assign(count, 0);
+        weights[k].assign(count, 0.0f);
+    }
+    influenceCount = 0;
+
+    for (size_t i = 0; i < count; ++i) {
+        const auto& vw = vertexWeights[i];
+
+        float total = 0.0f;
+        for (int k = 0; k < MAX_BONE_INFLUENCES; ++k) {
+            total += std::max(0.0f, vw.weights[k]);
+        }
+
+        // Unweighted vertices follow the first bone rigidly
+        if (total <= 0.0f) {
+            weights[0][i] = 1.0f;
+            influenceCount = std::max(influenceCount, 1);
+            continue;
+        }
+
+        for (int k = 0; k < MAX_BONE_INFLUENCES; ++k) {
+            float w = std::max(0.0f, vw.weights[k]) / total;
+            if (w <= 0.0f) continue;
+            boneIndices[k][i] = static_cast<uint16_t>(std::clamp(vw.boneIndices[k], 0, maxBone));
+            weights[k][i] = w;
+            influenceCount = std::max(influenceCount, k + 1);
+        }
+    }
+}
+
+std::vector<VertexWeights> SkinData::getVertexWeights() const {
+    std::vector<VertexWeights> result(getVertexCount());
+    for (size_t i = 0; i < result.size() && !weights[0].empty(); ++i) {
+        for (int k = 0; k < MAX_BONE_INFLUENCES; ++k) {
+            result[i].boneIndices[k] = boneIndices[k][i];
+            result[i].weights[k] = weights[k][i];
+        }
+    }
+    return result;
+}
+
+void skinVertices(const SkinData& skin, const std::vector<Affine2>& skinMatrices, float* outX, float* outY) {
+    const size_t count = skin.getVertexCount();
+    if (count == 0 || skinMatrices.empty() || skin.weights[0].size() != count) return;
+
+    const float* bindX = skin.bindX.data();
+    const float* bindY = skin.bindY.data();
+    const Affine2* matrices = skinMatrices.data();
+
+    std::fill(outX, outX + count, 0.0f);
+    std::fill(outY, outY + count, 0.0f);
+
+    // One pass per influence slot keeps the inner loop branch-free over flat arrays
+    for (int k = 0; k < skin.influenceCount; ++k) {
+        const uint16_t* bones = skin.boneIndices[k].data();
+        const float* w = skin.weights[k].data();
+        size_t i = 0;
+
+#ifdef RIGGLE_SKIN_SSE2
+        // Four vertices per step; the matrices are gathered by bone index into lanes,
+        // everything else is contiguous loads and stores
+        for (; i + 4 <= count; i += 4) {
+            const Affine2& m0 = matrices[bones[i]];
+            const Affine2& m1 = matrices[bones[i + 1]];
+            const Affine2& m2 = matrices[bones[i + 2]];
+            const Affine2& m3 = matrices[bones[i + 3]];
+            const __m128 ma = _mm_set_ps(m3.a, m2.a, m1.a, m0.a);
+            const __m128 mb = _mm_set_ps(m3.b, m2.b, m1.b, m0.b);
+            const __m128 mtx = _mm_set_ps(m3.tx, m2.tx, m1.tx, m0.tx);
+            const __m128 mc = _mm_set_ps(m3.c, m2.c, m1.c, m0.c);
+            const __m128 md = _mm_set_ps(m3.d, m2.d, m1.d, m0.d);
+            const __m128 mty = _mm_set_ps(m3.ty, m2.ty, m1.ty, m0.ty);
+
+            const __m128 x = _mm_loadu_ps(bindX + i);
+            const __m128 y = _mm_loadu_ps(bindY + i);
+            const __m128 weight = _mm_loadu_ps(w + i);
+            const __m128 px = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ma, x), _mm_mul_ps(mb, y)), mtx);
+            const __m128 py = _mm_add_ps(_mm_add_ps(_mm_mul_ps(mc, x), _mm_mul_ps(md, y)), mty);
+            _mm_storeu_ps(outX + i, _mm_add_ps(_mm_loadu_ps(outX + i), _mm_mul_ps(weight, px)));
+            _mm_storeu_ps(outY + i, _mm_add_ps(_mm_loadu_ps(outY + i), _mm_mul_ps(weight, py)));
+        }
+#endif
+
+        for (; i < count; ++i) {
+            const Affine2& m = matrices[bones[i]];
+            const float x = bindX[i];
+            const float y = bindY[i];
+            outX[i] += w[i] * (m.a * x + m.b * y + m.tx);
+            outY[i] += w[i] * (m.c * x + m.d * y + m.ty);
+        }
+    }
+}
+
+namespace {
+
+float distanceToSegment(const Vector2& p, const Vector2& a, const Vector2& b) {
+    Vector2 ab = b - a;
+    float lengthSq = ab.lengthSquared();
+    float t = lengthSq > 0.0f ? std::clamp((p - a).dot(ab) / lengthSq, 0.0f, 1.0f) : 0.0f;
+    return (p - (a + ab * t)).length();
+}
+
+} // namespace
+
+std::vector<VertexWeights> computeAutoWeights(const std::vector<Vector2>& worldVertices,
+                                              const std::vector<Transform>& boneWorlds,
+                                              int maxInfluences,
+                                              float falloff) {
+    std::vector<VertexWeights> result(worldVertices.size());
+    if (boneWorlds.empty()) return result;
+
+    maxInfluences = std::clamp(maxInfluences, 1, MAX_BONE_INFLUENCES);
+    const int boneCount = static_cast<int>(boneWorlds.size());
+
+    // Bone segments, same endpoints as Bone::getWorldEndpoints
+    std::vector<Vector2> starts(boneCount), ends(boneCount);
+    for (int j = 0; j < boneCount; ++j) {
+        const Transform& t = boneWorlds[j];
+        starts[j] = t.position;
+        ends[j] = Vector2(t.position.x + t.length * std::cos(t.rotation) * t.scale.x,
+                          t.position.y + t.length * std::sin(t.rotation) * t.scale.y);
+    }
+
+    std::vector<float> influence(boneCount);
+    std::vector<int> order(boneCount);
+
+    for (size_t i = 0; i < worldVertices.size(); ++i) {
+        for (int j = 0; j < boneCount; ++j) {
+            float distance = distanceToSegment(worldVertices[i], starts[j], ends[j]);
+            influence[j] = 1.0f / std::pow(distance + 1.0f, falloff);
+        }
+
+        std::iota(order.begin(), order.end(), 0);
+        int used = std::min(maxInfluences, boneCount);
+        std::partial_sort(order.begin(), order.begin() + used, order.end(),
+            [&influence](int lhs, int rhs) { return influence[lhs] > influence[rhs]; });
+
+        float total = 0.0f;
+        for (int k = 0; k < used; ++k) {
+            total += influence[order[k]];
+        }
+
+        for (int k = 0; k < used; ++k) {
+            result[i].boneIndices[k] = order[k];
+            result[i].weights[k] = total > 0.0f ? influence[order[k]] / total : (k == 0 ? 1.0f : 0.0f);
+        }
+    }
+
+    return result;
+}
+
+} // namespace Riggle
@@ -0,0 +1,96 @@
+#include "Riggle/WorkerPool.h"
+#include <algorithm>
+
+namespace Riggle {
+
+WorkerPool::WorkerPool(unsigned int helperThreads) {
+    start(helperThreads);
+}
+
+WorkerPool::~WorkerPool() {
+    stop();
+}
+
+WorkerPool& WorkerPool::shared() {
+    static WorkerPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+    return pool;
+}
+
+void WorkerPool::setHelperThreadCount(unsigned int count) {
+    std::lock_guard<std::mutex> runLock(m_runMutex);
+    if (count == m_threads.size()) return;
+    stop();
+    start(count);
+}
+
+void WorkerPool::start(unsigned int count) {
+    // Helpers start from the current generation, so a run() issued before
+    // they first take the lock still counts as new work for them
+    m_stopping = false;
+    for (unsigned int i = 0; i < count; ++i) {
+        m_threads.emplace_back(&WorkerPool::workerLoop, this, m_generation);
+    }
+}
+
+void WorkerPool::stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (auto& thread : m_threads) {
+        thread.join();
+    }
+    m_threads.clear();
+}
+
+void WorkerPool::run(size_t count, const std::function<void(size_t)>& task) {
+    if (count == 0) return;
+
+    std::unique_lock<std::mutex> runLock(m_runMutex, std::try_to_lock);
+    if (!runLock.owns_lock() || m_threads.empty() || count == 1) {
+        for (size_t i = 0; i < count; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_task = &task;
+        m_count = count;
+        m_next = 0;
+        m_busy = m_threads.size();
+        ++m_generation;
+    }
+    m_wake.notify_all();
+    work();
+
+    // The job fields must stay valid until every helper has left work()
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this] { return m_busy == 0; });
+    m_task = nullptr;
+}
+
+void WorkerPool::workerLoop(unsigned long long seen) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        m_wake.wait(lock, [&] { return m_stopping || m_generation != seen; });
+        if (m_stopping) return;
+        seen = m_generation;
+
+        lock.unlock();
+        work();
+        lock.lock();
+        if (--m_busy == 0) m_done.notify_one();
+    }
+}
+
+void WorkerPool::work() {
+    const std::function<void(size_t)>& task = *m_task;
+    for (size_t i = m_next++; i < m_count; i = m_next++) {
+        task(i);
+    }
+}
+
+} // namespace Riggle
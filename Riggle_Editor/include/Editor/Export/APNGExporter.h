@@ -0,0 +1,28 @@
+#pragma once
+#include "PNGExporter.h"
+#include <fstream>
+
+namespace Riggle {
+
+// Animated PNG in a single file. Frames are deflated on the encoder threads and
+// streamed out as fcTL/fdAT chunks, so memory stays flat for any length.
+class APNGExporter : public PNGSequenceExporter {
+public:
+    std::string getFileExtension() const override { return ".png"; }
+    std::string getFormatName() const override { return "Animated PNG"; }
+
+protected:
+    bool beginOutput(const std::string& outputPath, int frameCount) override;
+    bool encodeFrame(FrameEncoder& encoder, const sf::Image& image, std::vector<std::uint8_t>& bytes) override;
+    bool writeFrame(int frame, const std::vector<std::uint8_t>& bytes) override;
+    bool endOutput(bool completed) override;
+
+private:
+    std::ofstream m_file;
+    std::uint32_t m_sequence = 0;  // Shared by fcTL and fdAT chunks
+
+    void writeChunk(const char* type, const std::uint8_t* header, std::uint32_t headerSize,
+                    const std::uint8_t* data, std::uint32_t dataSize);
+};
+
+}
@@ -1,6 +1,7 @@
 #pragma once
 #include <Riggle/Export/IExporter.h>
 #include <Riggle/Character.h>
+#include "Editor/Export/PNGExporter.h"
 #include <memory>
 #include <vector>
 
@@ -25,6 +26,10 @@ public:
     bool exportAnimation(const Character& character, const std::string& animationName,
                         IAnimationExporter* exporter, const std::string& outputPath);
 
+    // Renders an animation through both PNG backends and compares the frames
+    bool compareRenderBackends(const Character& character, const std::string& animationName,
+                               PNGSequenceExporter* exporter, PNGSequenceExporter::BackendComparison& result);
+
     // Get last error from any operation
     std::string getLastError() const { return m_lastError; }
 
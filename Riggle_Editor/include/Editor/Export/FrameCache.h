@@ -0,0 +1,45 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Riggle {
+
+// On-disk store of encoded frames shared between export runs. A frame is found
+// by its draw key (the posed transforms, see PNGSequenceExporter) combined with
+// a hash of everything else that affects the output: format, encoder settings,
+// frame size and framing, textures and meshes. Re-exporting after a small edit
+// then only renders the frames whose pose actually changed.
+//
+// load() and store() touch one file per frame and may run on different threads;
+// files are written under a temporary name and renamed into place. Cache I/O
+// errors never fail an export, the frame is just rendered again.
+class FrameCache {
+public:
+    void setDirectory(const std::string& directory) { m_directory = directory; }  // Empty disables the cache
+    const std::string& getDirectory() const { return m_directory; }
+    bool isEnabled() const { return !m_directory.empty(); }
+
+    void setMaxSize(std::uint64_t bytes) { m_maxSize = bytes; }  // prune() drops least recently used files beyond this
+
+    // Starts an export whose output depends on 'settingsHash' besides the draw key
+    bool begin(std::uint64_t settingsHash);
+    // 'variant' tells apart several encodings of the same frame (one per output scale)
+    bool load(const std::vector<float>& drawKey, int variant, std::vector<std::uint8_t>& bytes) const;
+    void store(const std::vector<float>& drawKey, int variant, const std::vector<std::uint8_t>& bytes, int frame) const;
+    void prune() const;
+
+    // FNV-1a, for settings hashes and the sprite sheet's duplicate-frame check
+    static std::uint64_t hash(const void* data, size_t size, std::uint64_t seed = 0xCBF29CE484222325ull);
+    static std::uint64_t hash(const std::string& text, std::uint64_t seed = 0xCBF29CE484222325ull) { return hash(text.data(), text.size(), seed); }
+
+private:
+    std::string m_directory;
+    std::uint64_t m_maxSize = 1024ull * 1024 * 1024;
+    std::uint64_t m_settingsHash = 0;
+
+    std::string getEntryPath(const std::vector<float>& drawKey, int variant) const;
+};
+
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Riggle {
+
+enum class FrameFormat {
+    PNG,   // Lossless, deflate level and filter selectable
+    QOI,   // Lossless, much faster to encode than PNG at a somewhat larger size
+    TGA    // Uncompressed, for intermediate renders fed into other tools
+};
+
+// PNG scanline filters; Adaptive picks the best per row (minimum sum of absolute differences)
+enum class PNGFilter { None, Sub, Up, Paeth, Adaptive };
+
+struct FrameEncoderSettings {
+    FrameFormat format = FrameFormat::PNG;
+    int compressionLevel = 6;  // PNG deflate level, 0 (stored) to 9 (smallest)
+    PNGFilter filter = PNGFilter::Adaptive;
+};
+
+// Encodes exported frames straight from an RGBA8 buffer (rows top to bottom,
+// the layout of sf::Image) into a file image in memory. Holds its compressor
+// and scanline buffers between frames, so use one encoder per thread.
+class FrameEncoder {
+public:
+    explicit FrameEncoder(const FrameEncoderSettings& settings = FrameEncoderSettings());
+    ~FrameEncoder();
+
+    FrameEncoder(const FrameEncoder&) = delete;
+    FrameEncoder& operator=(const FrameEncoder&) = delete;
+
+    // Replaces 'output' with the encoded file
+    bool encode(const std::uint8_t* pixels, unsigned int width, unsigned int height, std::vector<std::uint8_t>& output);
+
+    // Building blocks for single-file animations; each appends to 'output'
+    // Zlib stream of the filtered scanlines (the IDAT/fdAT payload of a PNG)
+    bool deflatePNGImage(const std::uint8_t* pixels, unsigned int width, unsigned int height, std::vector<std::uint8_t>& output);
+    // Graphic control extension (delay left 0 at offset 4) + image descriptor + local palette + LZW data.
+    // Median-cut palette on a 15-bit histogram; alpha below 128 becomes the transparent index
+    bool encodeGIFImage(const std::uint8_t* pixels, unsigned int width, unsigned int height, std::vector<std::uint8_t>& output);
+    // Planar BT.601 studio-range Y, Cb, Cr with 2x2 chroma averaging; alpha is composited over black
+    void convertToYUV420(const std::uint8_t* pixels, unsigned int width, unsigned int height, std::vector<std::uint8_t>& output);
+
+    const FrameEncoderSettings& getSettings() const { return m_settings; }
+    static std::string getFileExtension(FrameFormat format);
+    // Big-endian field as PNG chunks and headers store them
+    static void writeU32BE(std::uint8_t* out, std::uint32_t value);
+
+private:
+    struct DeflateState;
+
+    FrameEncoderSettings m_settings;
+    std::unique_ptr<DeflateState> m_deflate;  // Created on the first PNG frame
+    std::vector<std::uint8_t> m_filterRows;   // One filtered scanline per filter type
+    std::vector<std::uint32_t> m_qoiIndex;
+
+    // GIF state: histogram per 5:5:5 colour bucket, then the palette index for each
+    struct GIFBucket {
+        std::uint32_t count = 0;
+        std::uint64_t sum[3] = {0, 0, 0};
+        std::uint8_t mean[3] = {0, 0, 0};
+    };
+    std::vector<GIFBucket> m_gifBuckets;
+    std::vector<int> m_gifUsed;               // Occupied buckets, regrouped into palette boxes
+    std::vector<std::uint8_t> m_gifLookup;    // Palette index per bucket
+    std::vector<std::uint8_t> m_gifPalette;
+    std::vector<std::uint16_t> m_gifPixelBuckets;  // 0xFFFF marks transparent pixels
+    std::vector<std::uint8_t> m_gifIndices;
+    std::vector<std::int32_t> m_lzwKeys;
+    std::vector<std::uint16_t> m_lzwCodes;
+
+    void buildGIFPalette(int maxColors);
+    void writeGIFLZW(std::vector<std::uint8_t>& output);
+
+    bool encodePNG(const std::uint8_t* pixels, unsigned int width, unsigned int height, std::vector<std::uint8_t>& output);
+    bool encodeQOI(const std::uint8_t* pixels, unsigned int width, unsigned int height, std::vector<std::uint8_t>& output);
+    bool encodeTGA(const std::uint8_t* pixels, unsigned int width, unsigned int height, std::vector<std::uint8_t>& output);
+};
+
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include "PNGExporter.h"
+#include <fstream>
+
+namespace Riggle {
+
+// Looping GIF in a single file. Each frame gets its own median-cut palette on the
+// encoder threads; the writer only adds frame delays and streams the blocks out.
+class GIFExporter : public PNGSequenceExporter {
+public:
+    std::string getFileExtension() const override { return ".gif"; }
+    std::string getFormatName() const override { return "GIF"; }
+
+protected:
+    bool beginOutput(const std::string& outputPath, int frameCount) override;
+    bool encodeFrame(FrameEncoder& encoder, const sf::Image& image, std::vector<std::uint8_t>& bytes) override;
+    bool writeFrame(int frame, const std::vector<std::uint8_t>& bytes) override;
+    bool endOutput(bool completed) override;
+
+private:
+    std::ofstream m_file;
+};
+
+}
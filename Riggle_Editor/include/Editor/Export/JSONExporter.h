@@ -15,6 +15,12 @@ private:
     std::string serializeBones(const std::vector<ExportBone>& bones);
     std::string serializeSprites(const std::vector<ExportSprite>& sprites);
     std::string serializeAnimations(const std::vector<ExportAnimation>& animations);
+    std::string serializeLODLevels(const std::vector<ExportLODLevel>& lodLevels);
+    std::string serializeConstraints(const std::vector<BoneConstraint>& constraints);
+    std::string serializeIKConstraints(const std::vector<IKConstraint>& constraints);
+    std::string serializeProceduralChannels(const std::vector<ProceduralChannel>& channels);
+    std::string serializeSpriteMesh(const SpriteMesh& mesh);
+    std::string serializeSpriteSkin(const ExportSprite& sprite);
     std::string serializeTransform(const Transform& transform);
     std::string serializeVector2(const Vector2& vec);
     std::string escapeJsonString(const std::string& str);
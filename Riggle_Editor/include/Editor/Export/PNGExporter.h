@@ -1,12 +1,23 @@
 #pragma once
+#include "FrameCache.h"
+#include "FrameEncoder.h"
 #include <Riggle/Export/IExporter.h>
+#include <Riggle/PoseEvaluator.h>
+#include <Riggle/SpringBoneSolver.h>
+#include <Riggle/ConstraintSystem.h>
+#include <Riggle/ProceduralChannelSystem.h>
+#include <Riggle/SoftwareRasterizer.h>
 #include <SFML/Graphics.hpp>
+#include <fstream>
 #include <map>
 
 namespace Riggle {
 
 class PNGSequenceExporter : public IAnimationExporter {
 public:
+    // SFML renders through an OpenGL context; Software renders on the CPU for headless machines
+    enum class RenderBackend { SFML, Software };
+
     PNGSequenceExporter();
     
     bool exportAnimation(const ExportAnimation& animation, 
@@ -18,43 +29,206 @@ public:
 
     // Configuration
     void setFrameRate(int fps) { m_frameRate = fps; }
-    void setResolution(int width, int height) { m_width = width; m_height = height; }
+    void setResolution(int width, int height) { m_width = m_frameWidth = width; m_height = m_frameHeight = height; }
+    int getFrameRate() const { return m_frameRate; }
+    int getWidth() const { return m_frameWidth; }   // Size of the exported frames; with auto-crop,
+    int getHeight() const { return m_frameHeight; } // set once the export has measured the poses
 
     void setZoom(float zoom) { m_zoom = zoom; }
     void setBackgroundColor(const sf::Color& color) { m_backgroundColor = color; }
     void setResolutionPreset(int presetIdx) { m_resolutionPreset = presetIdx; updateResolution(); }
     void setAspectRatioIndex(int idx) { m_aspectRatioIndex = idx; updateResolution(); }
 
+    // Auto-crop replaces the preset canvas with the union of every exported pose
+    // (sprite quads, deformed meshes and bones) plus padding, at the current zoom
+    void setAutoCrop(bool autoCrop) { m_autoCrop = autoCrop; }
+    bool isAutoCrop() const { return m_autoCrop; }
+    void setAutoCropPadding(int padding) { m_autoCropPadding = padding; }
+
+    // Several output sizes from one pass, e.g. {1, 0.5, 0.25}: poses are evaluated and
+    // rasterised once at the largest scale, the others are box-filtered from it.
+    // With more than one scale each goes to its own folder ("1x", "0.5x", ...) next to the output
+    void setOutputScales(const std::vector<float>& scales) { m_outputScales = scales; }
+    const std::vector<float>& getOutputScales() const { return m_outputScales; }
+
+    // Pipelined export encodes and writes frames on worker threads while the next
+    // frames render; the files are identical to the serial path
+    void setPipelined(bool pipelined) { m_pipelined = pipelined; }
+    bool isPipelined() const { return m_pipelined; }
+    // 0 = one per spare core, or half the cores when the software backend rasterises on the rest
+    void setEncoderThreadCount(unsigned int count) { m_encoderThreads = count; }
+
+    void setRenderBackend(RenderBackend backend) { m_backend = backend; }
+    RenderBackend getRenderBackend() const { return m_backend; }
+    void setSmoothTextures(bool smooth) { m_smoothTextures = smooth; } // Bilinear filtering on both backends
+
+    // Renders every frame of the animation on both backends with the current settings
+    // and compares them per channel; no files are written
+    struct BackendComparison {
+        int frames = 0;
+        int maxChannelDifference = 0;   // Largest |SFML - Software| of any R, G, B or A value
+        int worstFrame = -1;
+        int tolerance = 2;              // Rounding differences between GPU and CPU filtering
+        size_t totalPixels = 0;         // Summed over all frames
+        size_t differingPixels = 0;
+        size_t pixelsOverTolerance = 0;
+    };
+    bool compareBackends(const ExportAnimation& animation, const std::vector<ExportSprite>& sprites,
+                         const std::vector<ExportBone>& bones, BackendComparison& result);
+
+    // Frame file format (PNG, QOI or TGA) and PNG compression
+    void setEncoderSettings(const FrameEncoderSettings& settings) { m_encoderSettings = settings; }
+    const FrameEncoderSettings& getEncoderSettings() const { return m_encoderSettings; }
+
+    // Encoded frames are kept on disk between runs, so re-exporting after an edit
+    // only renders frames whose pose changed. An empty directory disables the cache
+    void setFrameCacheDirectory(const std::string& directory) { m_frameCache.setDirectory(directory); }
+    const std::string& getFrameCacheDirectory() const { return m_frameCache.getDirectory(); }
+    static std::string getDefaultFrameCacheDirectory();
+
+protected:
+    // Output stages; the defaults write one numbered file per frame into a directory.
+    // encodeFrame runs on the encoder threads, each with its own FrameEncoder;
+    // beginOutput, writeFrame and endOutput run on one thread in frame order.
+    virtual bool beginOutput(const std::string& outputPath, int frameCount);
+    virtual bool encodeFrame(FrameEncoder& encoder, const sf::Image& image, std::vector<std::uint8_t>& bytes);
+    virtual bool writeFrame(int frame, const std::vector<std::uint8_t>& bytes);
+    virtual bool endOutput(bool completed);  // 'completed' is false after a failed frame
+    
+    // For single-file exporters: creates the parent directory and opens 'path' for writing
+    bool openOutputFile(const std::string& path, std::ofstream& file);
+    static bool writeFile(const std::string& path, const std::vector<std::uint8_t>& bytes);
+
 private:
+    std::string m_outputPath;
     int m_frameRate;
     int m_width;
     int m_height;
 
     float m_zoom = 1.0f;
+    bool m_autoCrop = false;
+    int m_autoCropPadding = 8;
+
+    std::vector<float> m_outputScales;
+
+    // Frame size, screen position of the world origin and zoom for the current export
+    int m_frameWidth;
+    int m_frameHeight;
+    Vector2 m_frameOrigin;
+    float m_frameZoom = 1.0f;
+
+    // Smaller output scales: encoded frames are spooled to a temporary file during the
+    // pass, then replayed through the output stages once the main output is finished
+    struct ScaledOutput {
+        int width = 0;
+        int height = 0;
+        std::string outputPath;
+        std::string spoolPath;
+        std::ofstream spool;
+    };
+    std::vector<ScaledOutput> m_scaledOutputs;
     sf::Color m_backgroundColor = sf::Color::Transparent;
     int m_resolutionPreset = 1;
     int m_aspectRatioIndex = 0;
+    bool m_pipelined = true;
+    unsigned int m_encoderThreads = 0;
+    RenderBackend m_backend = RenderBackend::SFML;
+    bool m_smoothTextures = false;
+    FrameEncoderSettings m_encoderSettings;
     void updateResolution();
+    void prepareSequence(const ExportAnimation& animation, const std::vector<ExportSprite>& sprites,
+                         const std::vector<ExportBone>& bones, int totalFrames);
+
+    // Reused for every frame of an export
+    sf::RenderTexture m_renderTexture;
+    
+    // Software backend state: CPU copies of the textures and a reused vertex buffer
+    SoftwareRasterizer m_rasterizer;
+    std::map<std::string, RasterImage> m_rasterTextureCache;
+    std::vector<RasterVertex> m_rasterVertices;
+
+    // Compiled skeleton and animation; poses every frame without copies or name lookups
+    PoseEvaluator m_pose;
+
+    // Everything that moves in the posed draw list; an unchanged key means the
+    // frame would render identically, so the previous frame's file is reused
+    std::vector<float> m_drawKey;
+    std::vector<float> m_previousDrawKey;
+
+    // Encoded frames from earlier runs, looked up by draw key
+    FrameCache m_frameCache;
+    bool m_frameCacheActive = false;
 
     // Texture cache for performance
     mutable std::map<std::string, sf::Texture> m_textureCache;
     
-    bool renderFrame(float time, const ExportAnimation& animation,
-                    const std::vector<ExportSprite>& sprites, 
-                    const std::vector<ExportBone>& bones, 
-                    const std::string& framePath);
-    
-    Transform interpolateTransform(const std::vector<ExportKeyframe>& keyframes, float time);
-    void applyAnimationToBones(std::vector<ExportBone>& animatedBones, 
-                              const ExportAnimation& animation, float time);
-    void calculateAllWorldTransforms(std::vector<ExportBone>& bones);
-    Transform calculateBoneWorldTransform(const ExportBone& bone, 
-                                         const std::vector<ExportBone>& bones,
-                                         std::map<std::string, Transform>& worldTransforms);
-    Transform combineTransforms(const Transform& parent, const Transform& local);
-    Transform calculateSpriteWorldTransform(const ExportSprite& sprite, 
-                                           const std::vector<ExportBone>& animatedBones);
-    const ExportBone* findBone(const std::vector<ExportBone>& bones, const std::string& name);
+    // Skin data per sprite (built once per export) and reused mesh buffers
+    std::map<std::string, SkinData> m_skinCache;
+    std::vector<Affine2> m_skinMatrices;
+    std::vector<float> m_deformX;
+    std::vector<float> m_deformY;
+    sf::VertexArray m_meshVertices;
+    
+    // Procedural channels added to each sampled frame, before IK and constraints
+    ProceduralChannelSystem m_proceduralChannels;
+    
+    // IK constraints solved on each sampled frame, in rig order
+    struct IKJob {
+        std::vector<int> chain;        // Bone indices, parent-first (a tree with extra effectors)
+        std::vector<int> parents;      // Workspace parent per chain bone
+        IKSolveSettings settings;
+        std::vector<BoneRotationLimits> limits;
+        // Per end effector, the constraint's own first, then its extra effectors
+        std::vector<int> effectorJoints;   // Workspace index of the bone whose tip is pulled
+        std::vector<int> targetBones;      // -1 uses targetPositions
+        std::vector<Vector2> targetPositions;
+        std::vector<float> weights;
+    };
+    std::vector<IKJob> m_ikJobs;
+    std::vector<Vector2> m_ikTargets;
+    std::vector<Transform> m_ikLocals;
+    std::vector<Transform> m_ikParentWorlds;
+    IKSolver m_ikSolver;
+    IKChainWorkspace m_ikWorkspace;
+    
+    // Constraints evaluated on each sampled frame
+    ConstraintSystem m_constraints;
+    
+    // Spring bones are simulated frame by frame in export order
+    SpringBoneSolver m_springSolver;
+    std::vector<int> m_springBones;    // Index into the bone list per simulated bone
+    std::vector<int> m_springAnchors;  // Parent bone index for chain roots, -1 otherwise
+    float m_springTime = 0.0f;
+    
+    bool exportFramesSerial(const ExportAnimation& animation, const std::vector<ExportSprite>& sprites, int totalFrames);
+    bool exportFramesPipelined(const ExportAnimation& animation, const std::vector<ExportSprite>& sprites, int totalFrames);
+    std::string getFramePath(const std::string& outputPath, int frame) const;
+    sf::Texture* getTexture(const std::string& path);
+    bool rasterizeFrame(const std::vector<ExportSprite>& sprites, sf::Image& image);
+    const RasterImage* getRasterTexture(const std::string& path);
+    void poseFrame(float time, const ExportAnimation& animation);
+    void setupFrameBounds(const ExportAnimation& animation, const std::vector<ExportSprite>& sprites,
+                          const std::vector<ExportBone>& bones, int totalFrames);
+    bool updateDrawKey(const std::vector<ExportSprite>& sprites);
+    std::string setupScaledOutputs(const std::string& outputPath);
+    bool encodeOutputs(FrameEncoder& encoder, const sf::Image& image, std::vector<std::vector<std::uint8_t>>& outputs);
+    bool writeOutputs(int frame, const std::vector<std::vector<std::uint8_t>>& outputs);
+    bool writeScaledOutputs(int frameCount);
+    void closeScaledOutputs();
+    bool loadCachedFrame(std::vector<std::vector<std::uint8_t>>& outputs) const;
+    void storeCachedFrame(const std::vector<float>& drawKey, const std::vector<std::vector<std::uint8_t>>& outputs, int frame) const;
+    std::uint64_t computeFrameCacheHash(const std::vector<ExportSprite>& sprites) const;
+    bool renderFrame(const std::vector<ExportSprite>& sprites, sf::Image& image);
+    
+    void setupProceduralChannels(const std::vector<ExportBone>& bones);
+    void applyProceduralChannels(float time, float duration);
+    void setupIKConstraints(const std::vector<ExportBone>& bones);
+    void applyIKConstraints();
+    void setupConstraints(const std::vector<ExportBone>& bones);
+    void applyConstraints();
+    void setupSpringBones(const std::vector<ExportBone>& bones);
+    void applySpringBones(float time);
+    bool deformSpriteMesh(const ExportSprite& sprite, int spriteIndex, const Transform& spriteWorldTransform);
     bool createDirectory(const std::string& path);
 };
 
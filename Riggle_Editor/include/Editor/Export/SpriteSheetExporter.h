@@ -0,0 +1,62 @@
+#pragma once
+#include "PNGExporter.h"
+#include <unordered_map>
+
+namespace Riggle {
+
+// Sprite sheet for game engines: a JSON file plus one or more PNG atlas pages
+// next to it. Frames are trimmed to their opaque bounds on the encoder threads,
+// identical images are stored once, and the rest are packed with stb_rect_pack.
+// Consecutive identical frames are merged into one entry with a longer duration.
+class SpriteSheetExporter : public PNGSequenceExporter {
+public:
+    std::string getFileExtension() const override { return ".json"; }
+    std::string getFormatName() const override { return "Sprite Sheet"; }
+
+    void setMaxPageSize(int size) { m_maxPageSize = size; }  // Grown if a single frame is larger
+    int getMaxPageSize() const { return m_maxPageSize; }
+    void setPadding(int padding) { m_padding = padding; }   // Empty pixels between packed images
+    int getPadding() const { return m_padding; }
+
+protected:
+    bool beginOutput(const std::string& outputPath, int frameCount) override;
+    bool encodeFrame(FrameEncoder& encoder, const sf::Image& image, std::vector<std::uint8_t>& bytes) override;
+    bool writeFrame(int frame, const std::vector<std::uint8_t>& bytes) override;
+    bool endOutput(bool completed) override;
+
+private:
+    // A unique trimmed image and where it ended up in the atlas
+    struct SheetImage {
+        int width = 0;
+        int height = 0;
+        std::vector<std::uint8_t> pixels;
+        int page = 0;
+        int x = 0;
+        int y = 0;
+    };
+
+    // A run of consecutive frames showing the same image at the same offset
+    struct SheetFrame {
+        int image = 0;
+        int offsetX = 0;  // Trimmed image position inside the full frame
+        int offsetY = 0;
+        int firstFrame = 0;
+        int lastFrame = 0;
+    };
+
+    int m_maxPageSize = 2048;
+    int m_padding = 1;
+
+    std::ofstream m_file;
+    std::string m_metadataPath;
+    std::vector<SheetImage> m_images;
+    std::vector<SheetFrame> m_frames;
+    std::unordered_multimap<std::uint64_t, int> m_imagesByHash;
+
+    int findOrAddImage(std::uint64_t hash, int width, int height, const std::uint8_t* pixels);
+    bool packImages(std::vector<std::pair<int, int>>& pageSizes);
+    bool writePages(const std::vector<std::pair<int, int>>& pageSizes, std::vector<std::string>& pageFiles);
+    bool writeMetadata(const std::vector<std::pair<int, int>>& pageSizes, const std::vector<std::string>& pageFiles);
+};
+
+}
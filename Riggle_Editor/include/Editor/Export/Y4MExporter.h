@@ -0,0 +1,24 @@
+#pragma once
+#include "PNGExporter.h"
+#include <fstream>
+
+namespace Riggle {
+
+// Raw YUV4MPEG2 (4:2:0) video, readable by most video tools without an encoder
+// library. Colour conversion runs on the encoder threads; frames are streamed out.
+class Y4MExporter : public PNGSequenceExporter {
+public:
+    std::string getFileExtension() const override { return ".y4m"; }
+    std::string getFormatName() const override { return "Y4M Video"; }
+
+protected:
+    bool beginOutput(const std::string& outputPath, int frameCount) override;
+    bool encodeFrame(FrameEncoder& encoder, const sf::Image& image, std::vector<std::uint8_t>& bytes) override;
+    bool writeFrame(int frame, const std::vector<std::uint8_t>& bytes) override;
+    bool endOutput(bool completed) override;
+
+private:
+    std::ofstream m_file;
+};
+
+}
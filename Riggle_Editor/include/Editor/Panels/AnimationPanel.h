@@ -1,6 +1,7 @@
 #pragma once
 
 #include "BasePanel.h"
+#include <Riggle/MotionCapture.h>
 #include <imgui.h>
 #include <memory>
 #include <string>
@@ -20,6 +21,7 @@ struct TimelineState {
     float scrollX = 0.0f;
     bool isPlaying = false;
     bool isRecording = false;
+    bool isCapturing = false;  // Performance capture: edits recorded while playing
     float playbackSpeed = 1.0f;
     bool autoKeyframe = true;
     
@@ -59,11 +61,13 @@ public:
     void setRecording(bool recording) { m_state.isRecording = recording; }
     bool isRecording() const { return m_state.isRecording; }
     bool isAutoKeyEnabled() const { return m_state.autoKeyframe; }
+    bool isCapturing() const { return m_state.isCapturing; }
     void createKeyframeForBone(const std::string& boneName);
     
 private:
     Character* m_character;
     TimelineState m_state;
+    MotionCaptureSettings m_captureSettings;
     
     // UI Components
     void renderAnimationControls();
@@ -99,6 +103,7 @@ private:
     void updatePlayback(float deltaTime);
 
     void toggleRecording();
+    void toggleMotionCapture();
     void keyAllBones();
 };
 
@@ -7,6 +7,7 @@
 #include "../Tools/IKSolverTool.h"
 #include <functional>
 #include <chrono>
+#include <set>
 
 namespace Riggle {
 
@@ -59,6 +60,13 @@ private:
     float m_moveStep;
     int m_moveStepInt;
     
+    // Mesh skinning controls
+    int m_meshColumns = 4;
+    int m_meshRows = 4;
+    int m_meshVertexBudget = 32;
+    float m_skinFalloff = 2.0f;
+    std::set<std::string> m_skinBoneSelection;
+    
     // Helper functions
     void renderEmptyState();
     void renderSpriteProperties();
@@ -67,6 +75,7 @@ private:
     void renderTransformControls();
     void renderMovementButtons();
     void renderSpriteBindings();
+    void renderSpriteMeshControls();
     void moveSprite(float deltaX, float deltaY);
     void renderIKProperties();
 
@@ -77,6 +86,9 @@ private:
     void renderBoneTransformControls();
     void renderBoneHierarchyInfo();
     void renderBoneSpriteBindings();
+    void renderBoneConstraints();
+    void renderBoneIKConstraints();
+    void renderBoneProceduralChannels();
 };
 
 } // namespace Riggle
\ No newline at end of file
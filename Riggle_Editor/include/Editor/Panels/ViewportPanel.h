@@ -108,6 +108,7 @@ private:
     bool m_showGrid;
     bool m_showBones;
     bool m_showSprites;
+    bool m_autoLOD = false; // Pick skeleton LOD from zoom level every frame
 
     // Callbacks
     std::function<void(Sprite*)> m_onSpriteSelected;
@@ -118,6 +119,7 @@ private:
     
     // Rendering
     void renderToolButtons();
+    void renderLODControls();
     void renderViewport();
     void renderScene(sf::RenderTarget& target);
     void renderGrid(sf::RenderTarget& target);
@@ -59,6 +59,9 @@ private:
     bool reconstructRig(const json& bonesJson, Character* character);
     bool reconstructSprites(const json& spritesJson, Character* character, const std::string& assetsDir);
     bool reconstructAnimations(const json& animationsJson, Character* character);
+    void reconstructConstraints(const json& bonesJson, Rig* rig);
+    bool reconstructLODLevels(const json& lodLevelsJson, Character* character);
+    void reconstructSpriteMesh(const json& spriteJson, Sprite* sprite, Rig* rig);
     
     // Utility functions
     std::string getCurrentDateTime();
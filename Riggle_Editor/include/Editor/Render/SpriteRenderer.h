@@ -12,7 +12,7 @@ public:
     SpriteRenderer();
     ~SpriteRenderer() = default;
 
-    void setCharacter(Character* character) { m_character = character; }
+    void setCharacter(Character* character) { m_character = character; m_meshArrays.clear(); }
     
     void render(sf::RenderTarget& target);
     void renderSprite(sf::RenderTarget& target, Sprite* sprite);
@@ -26,11 +26,17 @@ private:
     Character* m_character;
     std::unordered_map<std::string, std::unique_ptr<sf::Texture>> m_textureCache;
     
+    // Reused vertex arrays for mesh sprites, plus deform scratch buffers
+    std::unordered_map<const Sprite*, sf::VertexArray> m_meshArrays;
+    std::vector<float> m_deformX;
+    std::vector<float> m_deformY;
+    
     // Default texture for missing files
     sf::Texture m_defaultTexture;
     
     void createDefaultTexture();
     sf::Texture* loadTexture(const std::string& path);
+    sf::VertexArray* buildMeshVertices(Sprite* sprite, const sf::Color& color);
 };
 
 } // namespace Riggle
\ No newline at end of file
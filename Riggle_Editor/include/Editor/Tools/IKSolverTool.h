@@ -29,6 +29,9 @@ public:
     void handleMouseMoved(const sf::Vector2f& worldPos);
     void handleMouseReleased(const sf::Vector2f& worldPos);
     
+    // Once per rendered frame: solves for the latest drag target (mouse moves only record it)
+    void update();
+    
     // Selection management
     void setEndEffector(std::shared_ptr<Bone> bone);
     std::shared_ptr<Bone> getEndEffector() const { return m_endEffector; }
@@ -38,6 +41,14 @@ public:
     void setChainLength(int length);
     int getChainLength() const { return m_chainLength; }
 
+    // Solver selection for this chain
+    void setSolverSettings(const IKSolveSettings& settings) { m_solverSettings = settings; }
+    const IKSolveSettings& getSolverSettings() const { return m_solverSettings; }
+    
+    // Solver time per frame while dragging; unfinished solves continue on the next frame
+    void setFrameBudget(float milliseconds) { m_frameBudgetMs = milliseconds; }
+    float getFrameBudget() const { return m_frameBudgetMs; }
+
     // State queries
     IKToolState getState() const { return m_state; }
     bool isConfigured() const { return m_state == IKToolState::Configured || m_state == IKToolState::Solving; }
@@ -69,12 +80,19 @@ private:
     IKToolState m_state;
     std::shared_ptr<Bone> m_endEffector;
     int m_chainLength;
+    IKSolveSettings m_solverSettings;
     Vector2 m_targetPosition;
     
     // Interaction state
     bool m_isDragging;
     sf::Vector2f m_lastMousePos;
     
+    // Drag solving: chain validated once per drag, warm-started from the last solution
+    std::vector<std::shared_ptr<Bone>> m_dragChain;
+    std::vector<float> m_warmRotations;
+    bool m_solvePending;
+    float m_frameBudgetMs;
+    
     // Visual settings
     sf::Color m_chainColor;
     sf::Color m_endEffectorColor;
@@ -86,6 +104,8 @@ private:
     // Helper methods
     void updateState();
     void solveIK(const Vector2& targetPos);
+    void beginDrag();
+    void endDrag();
     void renderChainHighlight(sf::RenderTarget& target, float zoomLevel);
     void renderTargetMarker(sf::RenderTarget& target, float zoomLevel);
     void renderEndEffectorMarker(sf::RenderTarget& target, float zoomLevel);
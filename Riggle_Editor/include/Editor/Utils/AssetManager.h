@@ -2,9 +2,12 @@
 #include <string>
 #include <vector>
 #include <filesystem>
+#include <Riggle/MeshGenerator.h>
 
 namespace Riggle {
 
+class Sprite;
+
 struct AssetInfo {
     std::string name;
     std::string path;
@@ -31,6 +34,9 @@ public:
     bool isImageFile(const std::string& path) const;
     std::string getAssetName(const std::string& path) const;
     
+    // Import step: replace the sprite's quad with a mesh traced from the texture alpha
+    static bool generateContourMesh(Sprite* sprite, const MeshGeneratorSettings& settings = MeshGeneratorSettings());
+    
 private:
     std::vector<AssetInfo> m_assets;
     std::vector<AssetInfo> m_imageAssets;
@@ -97,6 +97,7 @@ private:
     char m_projectName[256];
     std::string m_lastExportError;
     std::vector<bool> m_exportAnimationSelections;
+    std::string m_backendComparison;
 
     // Callbacks
     std::function<void()> m_onSaveAndExit;
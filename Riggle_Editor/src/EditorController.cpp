@@ -1,6 +1,11 @@
 #include "Editor/EditorController.h"
+#include "Editor/Export/APNGExporter.h"
+#include "Editor/Export/GIFExporter.h"
 #include "Editor/Export/JSONExporter.h"
 #include "Editor/Export/PNGExporter.h"
+#include "Editor/Export/SpriteSheetExporter.h"
+#include "Editor/Export/Y4MExporter.h"
+#include "Editor/Utils/AssetManager.h"
 #include <imgui.h>
 #include <imgui_internal.h>
 #include <filesystem>
@@ -28,9 +33,10 @@ EditorController::EditorController()
 void EditorController::update(sf::RenderWindow& window) {
     m_currentWindow = &window;
     
-    // Update character animation
+    // Update character animation, then deliver last frame's bone edits (auto-key) in one batch
     if (m_character) {
         m_character->update(ImGui::GetIO().DeltaTime);
+        m_character->flushTransformEvents();
     }
 
     // Update all panels
@@ -331,7 +337,9 @@ void EditorController::setupPanelCallbacks() {
     if (m_character) {
         m_character->addTransformEventHandler([this](const Character::TransformEvent& event) {
             // Check if we should auto-keyframe
-            if (m_animationPanel && m_animationPanel->isRecording() && m_animationPanel->isAutoKeyEnabled()) {
+            // Motion capture bakes its own keys when it stops
+            if (m_animationPanel && m_animationPanel->isRecording() && m_animationPanel->isAutoKeyEnabled() &&
+                !m_animationPanel->isCapturing()) {
                 
                 m_animationPanel->createKeyframeForBone(event.boneName);
                 std::cout << "Auto-keyed bone: " << event.boneName << " at time " << event.timestamp << std::endl;
@@ -360,6 +368,9 @@ void EditorController::onAssetSelected(const AssetInfo& asset) {
     initialTransform.scale = {1.0f, 1.0f};
     sprite->setTransform(initialTransform);
     
+    // Tight mesh from the texture alpha cuts transparent overdraw
+    AssetManager::generateContourMesh(sprite.get());
+    
     std::cout << "Created sprite: " << asset.name << " from " << asset.path << std::endl;
     
     // Add to character
@@ -391,6 +402,7 @@ void EditorController::onMultipleAssetsSelected(const std::vector<AssetInfo>& as
         initialTransform.rotation = 0.0f;
         initialTransform.scale = {1.0f, 1.0f};
         sprite->setTransform(initialTransform);
+        AssetManager::generateContourMesh(sprite.get());
         
         std::cout << "Created sprite: " << asset.name << " at (0, 0)" << std::endl;
         
@@ -853,6 +865,10 @@ void EditorController::initializeExportSystem() {
     // Register built-in exporters
     m_exportManager->registerProjectExporter(std::make_unique<JSONProjectExporter>());
     m_exportManager->registerAnimationExporter(std::make_unique<PNGSequenceExporter>());
+    m_exportManager->registerAnimationExporter(std::make_unique<APNGExporter>());
+    m_exportManager->registerAnimationExporter(std::make_unique<GIFExporter>());
+    m_exportManager->registerAnimationExporter(std::make_unique<SpriteSheetExporter>());
+    m_exportManager->registerAnimationExporter(std::make_unique<Y4MExporter>());
     
     // Initialize dialog manager with dependencies
     m_dialogManager->initialize(m_exportManager.get(), m_projectManager.get());
@@ -0,0 +1,96 @@
+#include "Editor/Export/APNGExporter.h"
+#include "Editor/Utils/miniz.h"
+
+namespace Riggle {
+
+namespace {
+
+void writeU16BE(std::uint8_t* out, std::uint16_t value) {
+    out[0] = static_cast<std::uint8_t>(value >> 8);
+    out[1] = static_cast<std::uint8_t>(value);
+}
+
+} // namespace
+
+bool APNGExporter::beginOutput(const std::string& outputPath, int frameCount) {
+    if (!openOutputFile(outputPath, m_file)) return false;
+    m_sequence = 0;
+
+    static const std::uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    m_file.write(reinterpret_cast<const char*>(signature), 8);
+
+    std::uint8_t header[13] = {};
+    FrameEncoder::writeU32BE(header, static_cast<std::uint32_t>(getWidth()));
+    FrameEncoder::writeU32BE(header + 4, static_cast<std::uint32_t>(getHeight()));
+    header[8] = 8;   // Bit depth
+    header[9] = 6;   // RGBA
+    writeChunk("IHDR", nullptr, 0, header, 13);
+
+    // Frame count and loop forever
+    std::uint8_t control[8] = {};
+    FrameEncoder::writeU32BE(control, static_cast<std::uint32_t>(frameCount));
+    writeChunk("acTL", nullptr, 0, control, 8);
+
+    if (!m_file) {
+        m_lastError = "Failed to write " + outputPath;
+        return false;
+    }
+    return true;
+}
+
+bool APNGExporter::encodeFrame(FrameEncoder& encoder, const sf::Image& image, std::vector<std::uint8_t>& bytes) {
+    bytes.clear();
+    return encoder.deflatePNGImage(image.getPixelsPtr(), image.getSize().x, image.getSize().y, bytes);
+}
+
+bool APNGExporter::writeFrame(int frame, const std::vector<std::uint8_t>& bytes) {
+    if (bytes.size() > 0x7FFFFFFBu) return false;  // Chunk length limit, minus the fdAT sequence number
+
+    // Full-size frame shown for 1/fps seconds, replacing the previous one (alpha included)
+    std::uint8_t control[26] = {};
+    FrameEncoder::writeU32BE(control, m_sequence++);
+    FrameEncoder::writeU32BE(control + 4, static_cast<std::uint32_t>(getWidth()));
+    FrameEncoder::writeU32BE(control + 8, static_cast<std::uint32_t>(getHeight()));
+    writeU16BE(control + 20, 1);
+    writeU16BE(control + 22, static_cast<std::uint16_t>(getFrameRate()));
+    control[24] = 0;  // APNG_DISPOSE_OP_NONE
+    control[25] = 0;  // APNG_BLEND_OP_SOURCE
+    writeChunk("fcTL", nullptr, 0, control, 26);
+
+    // The first frame doubles as the default image
+    const std::uint32_t size = static_cast<std::uint32_t>(bytes.size());
+    if (frame == 0) {
+        writeChunk("IDAT", nullptr, 0, bytes.data(), size);
+    } else {
+        std::uint8_t sequence[4];
+        FrameEncoder::writeU32BE(sequence, m_sequence++);
+        writeChunk("fdAT", sequence, 4, bytes.data(), size);
+    }
+    return static_cast<bool>(m_file);
+}
+
+bool APNGExporter::endOutput(bool completed) {
+    if (completed) writeChunk("IEND", nullptr, 0, nullptr, 0);
+    m_file.close();
+    return !m_file.fail();
+}
+
+void APNGExporter::writeChunk(const char* type, const std::uint8_t* header, std::uint32_t headerSize,
+                              const std::uint8_t* data, std::uint32_t dataSize) {
+    // CRC covers type + contents; the pieces are written as they are, without joining them
+    std::uint8_t length[4];
+    FrameEncoder::writeU32BE(length, headerSize + dataSize);
+    mz_ulong crc = mz_crc32(MZ_CRC32_INIT, reinterpret_cast<const std::uint8_t*>(type), 4);
+    if (headerSize > 0) crc = mz_crc32(crc, header, headerSize);
+    if (dataSize > 0) crc = mz_crc32(crc, data, dataSize);
+    std::uint8_t checksum[4];
+    FrameEncoder::writeU32BE(checksum, static_cast<std::uint32_t>(crc));
+
+    m_file.write(reinterpret_cast<const char*>(length), 4);
+    m_file.write(type, 4);
+    if (headerSize > 0) m_file.write(reinterpret_cast<const char*>(header), headerSize);
+    if (dataSize > 0) m_file.write(reinterpret_cast<const char*>(data), dataSize);
+    m_file.write(reinterpret_cast<const char*>(checksum), 4);
+}
+
+}
@@ -87,6 +87,7 @@ bool ExportManager::exportAnimation(const Character& character, const std::strin
         
         if (character.getRig()) {
             bones = ExportService::extractBoneData(*character.getRig());
+            ExportService::restoreAuthoredPose(character, bones);
         }
         
         // Export using the provided exporter
@@ -103,4 +104,41 @@ bool ExportManager::exportAnimation(const Character& character, const std::strin
     }
 }
 
+bool ExportManager::compareRenderBackends(const Character& character, const std::string& animationName,
+                                          PNGSequenceExporter* exporter, PNGSequenceExporter::BackendComparison& result) {
+    if (!exporter) {
+        m_lastError = "No exporter provided";
+        return false;
+    }
+
+    try {
+        Animation* targetAnimation = character.findAnimation(animationName);
+        if (!targetAnimation) {
+            m_lastError = "Animation '" + animationName + "' not found";
+            return false;
+        }
+
+        // Same data the export itself would see
+        ExportAnimation animationData = ExportService::extractAnimationData(*targetAnimation);
+        std::vector<ExportSprite> sprites = ExportService::extractSpriteData(character.getSprites());
+        std::vector<ExportBone> bones;
+
+        if (character.getRig()) {
+            bones = ExportService::extractBoneData(*character.getRig());
+            ExportService::restoreAuthoredPose(character, bones);
+        }
+
+        bool success = exporter->compareBackends(animationData, sprites, bones, result);
+        if (!success) {
+            m_lastError = "Comparison failed: " + exporter->getLastError();
+        }
+
+        return success;
+    }
+    catch (const std::exception& e) {
+        m_lastError = "Exception during backend comparison: " + std::string(e.what());
+        return false;
+    }
+}
+
 }
\ No newline at end of file
@@ -0,0 +1,166 @@
+#include "Editor/Export/FrameCache.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace Riggle {
+
+namespace {
+
+// Entry layout: magic, version, settings hash, variant, draw key (count + floats), encoded bytes (count + data)
+const char EntryMagic[4] = { 'R', 'G', 'F', 'C' };
+const std::uint32_t EntryVersion = 2;
+const char* EntryExtension = ".frame";
+
+template <typename T>
+void writeValue(std::ofstream& file, const T& value) {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+bool readValue(std::ifstream& file, T& value) {
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+} // namespace
+
+std::uint64_t FrameCache::hash(const void* data, size_t size, std::uint64_t seed) {
+    const std::uint8_t* bytes = static_cast<const std::uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        seed ^= bytes[i];
+        seed *= 0x100000001B3ull;
+    }
+    return seed;
+}
+
+bool FrameCache::begin(std::uint64_t settingsHash) {
+    m_settingsHash = settingsHash;
+    if (!isEnabled()) return false;
+
+    std::error_code error;
+    std::filesystem::create_directories(m_directory, error);
+    if (error) {
+        std::cout << "Warning: Export cache disabled, cannot create " << m_directory << ": " << error.message() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+std::string FrameCache::getEntryPath(const std::vector<float>& drawKey, int variant) const {
+    std::uint64_t key = hash(drawKey.data(), drawKey.size() * sizeof(float), m_settingsHash);
+    key = hash(&variant, sizeof(variant), key);
+    std::ostringstream path;
+    path << m_directory << "/" << std::hex << std::setfill('0') << std::setw(16) << key << EntryExtension;
+    return path.str();
+}
+
+bool FrameCache::load(const std::vector<float>& drawKey, int variant, std::vector<std::uint8_t>& bytes) const {
+    const std::string path = getEntryPath(drawKey, variant);
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+
+    // The file name is only a hash; the header has to match exactly
+    char magic[4];
+    std::uint32_t version = 0;
+    std::uint64_t settingsHash = 0;
+    std::int32_t storedVariant = 0;
+    std::uint32_t keyCount = 0;
+    if (!file.read(magic, 4) || std::memcmp(magic, EntryMagic, 4) != 0 ||
+        !readValue(file, version) || version != EntryVersion ||
+        !readValue(file, settingsHash) || settingsHash != m_settingsHash ||
+        !readValue(file, storedVariant) || storedVariant != variant ||
+        !readValue(file, keyCount) || keyCount != drawKey.size()) {
+        return false;
+    }
+
+    std::vector<float> storedKey(keyCount);
+    std::uint64_t byteCount = 0;
+    if (!file.read(reinterpret_cast<char*>(storedKey.data()), static_cast<std::streamsize>(keyCount * sizeof(float))) ||
+        (keyCount > 0 && std::memcmp(storedKey.data(), drawKey.data(), keyCount * sizeof(float)) != 0) ||
+        !readValue(file, byteCount) || byteCount > (1ull << 32)) {
+        return false;
+    }
+
+    bytes.resize(static_cast<size_t>(byteCount));
+    if (!file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(byteCount))) {
+        return false;
+    }
+
+    // Mark as recently used for prune()
+    std::error_code error;
+    std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), error);
+    return true;
+}
+
+void FrameCache::store(const std::vector<float>& drawKey, int variant, const std::vector<std::uint8_t>& bytes, int frame) const {
+    const std::string path = getEntryPath(drawKey, variant);
+
+    // Unique temporary name: the same pose can be encoded by two threads at once
+    const std::string temporaryPath = path + "." + std::to_string(frame) + ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        if (!file) return;
+
+        file.write(EntryMagic, 4);
+        writeValue(file, EntryVersion);
+        writeValue(file, m_settingsHash);
+        writeValue(file, static_cast<std::int32_t>(variant));
+        writeValue(file, static_cast<std::uint32_t>(drawKey.size()));
+        file.write(reinterpret_cast<const char*>(drawKey.data()), static_cast<std::streamsize>(drawKey.size() * sizeof(float)));
+        writeValue(file, static_cast<std::uint64_t>(bytes.size()));
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        if (!file) {
+            file.close();
+            std::error_code error;
+            std::filesystem::remove(temporaryPath, error);
+            return;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporaryPath, path, error);
+    if (error) {
+        std::filesystem::remove(temporaryPath, error);
+    }
+}
+
+void FrameCache::prune() const {
+    if (!isEnabled()) return;
+
+    struct Entry {
+        std::filesystem::path path;
+        std::filesystem::file_time_type time;
+        std::uint64_t size;
+    };
+    std::vector<Entry> entries;
+    std::uint64_t total = 0;
+
+    std::error_code error;
+    for (std::filesystem::directory_iterator it(m_directory, error), end; !error && it != end; it.increment(error)) {
+        if (it->path().extension() != EntryExtension) continue;
+        std::error_code entryError;
+        Entry entry;
+        entry.path = it->path();
+        entry.size = it->file_size(entryError);
+        entry.time = it->last_write_time(entryError);
+        if (entryError) continue;
+        total += entry.size;
+        entries.push_back(std::move(entry));
+    }
+    if (total <= m_maxSize) return;
+
+    // Oldest first
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.time < b.time; });
+    for (const Entry& entry : entries) {
+        if (total <= m_maxSize) break;
+        if (std::filesystem::remove(entry.path, error)) {
+            total -= entry.size;
+        }
+    }
+}
+
+}
@@ -0,0 +1,588 @@
+#include "Editor/Export/FrameEncoder.h"
+#include "Editor/Utils/miniz.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace Riggle {
+
+namespace {
+
+void appendU32BE(std::vector<std::uint8_t>& out, std::uint32_t value) {
+    out.resize(out.size() + 4);
+    FrameEncoder::writeU32BE(out.data() + out.size() - 4, value);
+}
+
+// Appends a complete chunk: length, type, data, CRC of type + data
+void appendPNGChunk(std::vector<std::uint8_t>& out, const char* type, const std::uint8_t* data, std::uint32_t length) {
+    appendU32BE(out, length);
+    const size_t crcStart = out.size();
+    out.insert(out.end(), type, type + 4);
+    if (length > 0) out.insert(out.end(), data, data + length);
+    appendU32BE(out, static_cast<std::uint32_t>(mz_crc32(MZ_CRC32_INIT, out.data() + crcStart, length + 4)));
+}
+
+mz_bool appendDeflated(const void* data, int length, void* user) {
+    auto* out = static_cast<std::vector<std::uint8_t>*>(user);
+    const auto* bytes = static_cast<const std::uint8_t*>(data);
+    out->insert(out->end(), bytes, bytes + length);
+    return MZ_TRUE;
+}
+
+inline std::uint8_t paeth(int left, int up, int upLeft) {
+    int p = left + up - upLeft;
+    int pa = std::abs(p - left);
+    int pb = std::abs(p - up);
+    int pc = std::abs(p - upLeft);
+    if (pa <= pb && pa <= pc) return static_cast<std::uint8_t>(left);
+    return static_cast<std::uint8_t>(pb <= pc ? up : upLeft);
+}
+
+// Writes filter byte + filtered scanline; 'prior' is the previous unfiltered row (zeros for the first)
+void filterRow(PNGFilter filter, const std::uint8_t* row, const std::uint8_t* prior, size_t rowBytes, std::uint8_t* out) {
+    const size_t bpp = 4;
+    std::uint8_t* dst = out + 1;
+    switch (filter) {
+        case PNGFilter::None:
+            out[0] = 0;
+            std::memcpy(dst, row, rowBytes);
+            break;
+        case PNGFilter::Sub:
+            out[0] = 1;
+            std::memcpy(dst, row, bpp);
+            for (size_t i = bpp; i < rowBytes; ++i) dst[i] = static_cast<std::uint8_t>(row[i] - row[i - bpp]);
+            break;
+        case PNGFilter::Up:
+            out[0] = 2;
+            for (size_t i = 0; i < rowBytes; ++i) dst[i] = static_cast<std::uint8_t>(row[i] - prior[i]);
+            break;
+        case PNGFilter::Paeth:
+        default:
+            out[0] = 4;
+            for (size_t i = 0; i < bpp; ++i) dst[i] = static_cast<std::uint8_t>(row[i] - prior[i]);
+            for (size_t i = bpp; i < rowBytes; ++i) {
+                dst[i] = static_cast<std::uint8_t>(row[i] - paeth(row[i - bpp], prior[i], prior[i - bpp]));
+            }
+            break;
+    }
+}
+
+// Heuristic from the PNG spec: smallest sum of filtered bytes taken as signed
+std::uint32_t filterCost(const std::uint8_t* filtered, size_t rowBytes) {
+    std::uint32_t cost = 0;
+    for (size_t i = 1; i <= rowBytes; ++i) {
+        cost += static_cast<std::uint32_t>(std::abs(static_cast<int>(static_cast<std::int8_t>(filtered[i]))));
+    }
+    return cost;
+}
+
+} // namespace
+
+struct FrameEncoder::DeflateState {
+    tdefl_compressor* compressor = tdefl_compressor_alloc();
+    ~DeflateState() { tdefl_compressor_free(compressor); }
+};
+
+FrameEncoder::FrameEncoder(const FrameEncoderSettings& settings)
+    : m_settings(settings) {
+    m_settings.compressionLevel = std::clamp(m_settings.compressionLevel, 0, 9);
+}
+
+FrameEncoder::~FrameEncoder() = default;
+
+bool FrameEncoder::encode(const std::uint8_t* pixels, unsigned int width, unsigned int height,
+                          std::vector<std::uint8_t>& output) {
+    output.clear();
+    if (!pixels || width == 0 || height == 0) return false;
+
+    switch (m_settings.format) {
+        case FrameFormat::QOI: return encodeQOI(pixels, width, height, output);
+        case FrameFormat::TGA: return encodeTGA(pixels, width, height, output);
+        case FrameFormat::PNG:
+        default: return encodePNG(pixels, width, height, output);
+    }
+}
+
+void FrameEncoder::writeU32BE(std::uint8_t* out, std::uint32_t value) {
+    out[0] = static_cast<std::uint8_t>(value >> 24);
+    out[1] = static_cast<std::uint8_t>(value >> 16);
+    out[2] = static_cast<std::uint8_t>(value >> 8);
+    out[3] = static_cast<std::uint8_t>(value);
+}
+
+std::string FrameEncoder::getFileExtension(FrameFormat format) {
+    switch (format) {
+        case FrameFormat::QOI: return ".qoi";
+        case FrameFormat::TGA: return ".tga";
+        case FrameFormat::PNG:
+        default: return ".png";
+    }
+}
+
+bool FrameEncoder::encodePNG(const std::uint8_t* pixels, unsigned int width, unsigned int height,
+                             std::vector<std::uint8_t>& output) {
+    static const std::uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    output.insert(output.end(), signature, signature + 8);
+
+    std::uint8_t header[13] = {};
+    writeU32BE(header, width);
+    writeU32BE(header + 4, height);
+    header[8] = 8;   // Bit depth
+    header[9] = 6;   // RGBA
+    appendPNGChunk(output, "IHDR", header, 13);
+
+    // Deflate straight into the IDAT chunk, then patch its length and CRC
+    const size_t idatStart = output.size();
+    appendU32BE(output, 0);
+    output.insert(output.end(), { 'I', 'D', 'A', 'T' });
+
+    if (!deflatePNGImage(pixels, width, height, output)) return false;
+
+    const size_t dataLength = output.size() - idatStart - 8;
+    if (dataLength > 0x7FFFFFFFu) return false;  // Chunk length limit
+    writeU32BE(output.data() + idatStart, static_cast<std::uint32_t>(dataLength));
+    appendU32BE(output, static_cast<std::uint32_t>(mz_crc32(MZ_CRC32_INIT, output.data() + idatStart + 4, dataLength + 4)));
+
+    appendPNGChunk(output, "IEND", nullptr, 0);
+    return true;
+}
+
+bool FrameEncoder::deflatePNGImage(const std::uint8_t* pixels, unsigned int width, unsigned int height,
+                                   std::vector<std::uint8_t>& output) {
+    if (!m_deflate) {
+        m_deflate = std::make_unique<DeflateState>();
+    }
+    if (!m_deflate->compressor) return false;
+
+    const int flags = static_cast<int>(tdefl_create_comp_flags_from_zip_params(m_settings.compressionLevel, 15, MZ_DEFAULT_STRATEGY));
+    if (tdefl_init(m_deflate->compressor, appendDeflated, &output, flags) != TDEFL_STATUS_OKAY) return false;
+
+    // Five filtered rows for the adaptive choice, then a zero row standing in for the row above the first
+    const size_t rowBytes = static_cast<size_t>(width) * 4;
+    const size_t slot = rowBytes + 1;
+    m_filterRows.assign(slot * 5 + rowBytes, 0);
+    const std::uint8_t* zeroRow = m_filterRows.data() + slot * 5;
+
+    for (unsigned int y = 0; y < height; ++y) {
+        const std::uint8_t* row = pixels + y * rowBytes;
+        const std::uint8_t* prior = y > 0 ? row - rowBytes : zeroRow;
+
+        const std::uint8_t* filtered = m_filterRows.data();
+        if (m_settings.filter == PNGFilter::Adaptive) {
+            std::uint32_t bestCost = 0;
+            for (int f = 0; f < 4; ++f) {
+                std::uint8_t* candidate = m_filterRows.data() + slot * (f + 1);
+                filterRow(static_cast<PNGFilter>(f), row, prior, rowBytes, candidate);
+                std::uint32_t cost = filterCost(candidate, rowBytes);
+                if (f == 0 || cost < bestCost) {
+                    bestCost = cost;
+                    filtered = candidate;
+                }
+            }
+        } else {
+            filterRow(m_settings.filter, row, prior, rowBytes, m_filterRows.data());
+        }
+
+        if (tdefl_compress_buffer(m_deflate->compressor, filtered, slot, TDEFL_NO_FLUSH) != TDEFL_STATUS_OKAY) return false;
+    }
+    return tdefl_compress_buffer(m_deflate->compressor, nullptr, 0, TDEFL_FINISH) == TDEFL_STATUS_DONE;
+}
+
+bool FrameEncoder::encodeGIFImage(const std::uint8_t* pixels, unsigned int width, unsigned int height,
+                                  std::vector<std::uint8_t>& output) {
+    if (width > 0xFFFF || height > 0xFFFF) return false;
+
+    // Histogram of opaque pixels; the bucket index is kept per pixel for the mapping pass
+    const size_t pixelCount = static_cast<size_t>(width) * height;
+    m_gifBuckets.assign(32768, GIFBucket());
+    m_gifIndices.resize(pixelCount);
+    bool hasTransparency = false;
+    std::vector<std::uint16_t>& bucketOf = m_gifPixelBuckets;
+    bucketOf.resize(pixelCount);
+    for (size_t i = 0; i < pixelCount; ++i) {
+        const std::uint8_t* px = pixels + i * 4;
+        if (px[3] < 128) {
+            hasTransparency = true;
+            bucketOf[i] = 0xFFFF;
+            continue;
+        }
+        int bucket = ((px[0] >> 3) << 10) | ((px[1] >> 3) << 5) | (px[2] >> 3);
+        GIFBucket& entry = m_gifBuckets[bucket];
+        ++entry.count;
+        entry.sum[0] += px[0];
+        entry.sum[1] += px[1];
+        entry.sum[2] += px[2];
+        bucketOf[i] = static_cast<std::uint16_t>(bucket);
+    }
+
+    m_gifUsed.clear();
+    for (int bucket = 0; bucket < 32768; ++bucket) {
+        GIFBucket& entry = m_gifBuckets[bucket];
+        if (entry.count == 0) continue;
+        for (int c = 0; c < 3; ++c) {
+            entry.mean[c] = static_cast<std::uint8_t>(entry.sum[c] / entry.count);
+        }
+        m_gifUsed.push_back(bucket);
+    }
+
+    // Index 255 is reserved for transparency when the frame needs it
+    const int transparentIndex = 255;
+    buildGIFPalette(hasTransparency ? 255 : 256);
+
+    for (size_t i = 0; i < pixelCount; ++i) {
+        m_gifIndices[i] = bucketOf[i] == 0xFFFF ? transparentIndex : m_gifLookup[bucketOf[i]];
+    }
+
+    // Graphic control extension: restore to background so transparent areas don't keep the previous frame
+    const std::uint8_t control[8] = {
+        0x21, 0xF9, 0x04, static_cast<std::uint8_t>((2 << 2) | (hasTransparency ? 1 : 0)),
+        0, 0, static_cast<std::uint8_t>(hasTransparency ? transparentIndex : 0), 0
+    };
+    output.insert(output.end(), control, control + 8);
+
+    // Image descriptor with a 256-entry local colour table
+    const std::uint8_t descriptor[10] = {
+        0x2C, 0, 0, 0, 0,
+        static_cast<std::uint8_t>(width & 0xFF), static_cast<std::uint8_t>(width >> 8),
+        static_cast<std::uint8_t>(height & 0xFF), static_cast<std::uint8_t>(height >> 8),
+        0x80 | 7
+    };
+    output.insert(output.end(), descriptor, descriptor + 10);
+    output.insert(output.end(), m_gifPalette.begin(), m_gifPalette.end());
+
+    writeGIFLZW(output);
+    return true;
+}
+
+void FrameEncoder::buildGIFPalette(int maxColors) {
+    // Median cut over the occupied buckets: split the box with the widest channel
+    // range at its population median until there are enough boxes
+    struct Box {
+        int begin = 0;
+        int end = 0;
+        int axis = 0;
+        int range = 0;
+    };
+    auto measure = [this](Box& box) {
+        int low[3] = { 255, 255, 255 };
+        int high[3] = { 0, 0, 0 };
+        for (int i = box.begin; i < box.end; ++i) {
+            const GIFBucket& entry = m_gifBuckets[m_gifUsed[i]];
+            for (int c = 0; c < 3; ++c) {
+                low[c] = std::min(low[c], static_cast<int>(entry.mean[c]));
+                high[c] = std::max(high[c], static_cast<int>(entry.mean[c]));
+            }
+        }
+        box.axis = 0;
+        box.range = box.end - box.begin > 1 ? high[0] - low[0] : 0;
+        for (int c = 1; c < 3 && box.end - box.begin > 1; ++c) {
+            if (high[c] - low[c] > box.range) {
+                box.axis = c;
+                box.range = high[c] - low[c];
+            }
+        }
+    };
+
+    std::vector<Box> boxes;
+    boxes.reserve(maxColors);
+    Box all;
+    all.end = static_cast<int>(m_gifUsed.size());
+    measure(all);
+    boxes.push_back(all);
+
+    while (static_cast<int>(boxes.size()) < maxColors) {
+        int best = -1;
+        for (int b = 0; b < static_cast<int>(boxes.size()); ++b) {
+            if (boxes[b].range > 0 && (best < 0 || boxes[b].range > boxes[best].range)) best = b;
+        }
+        if (best < 0) break;  // Every box is a single colour
+
+        Box box = boxes[best];
+        const int axis = box.axis;
+        std::sort(m_gifUsed.begin() + box.begin, m_gifUsed.begin() + box.end, [this, axis](int a, int b) {
+            return m_gifBuckets[a].mean[axis] < m_gifBuckets[b].mean[axis];
+        });
+
+        std::uint64_t total = 0;
+        for (int i = box.begin; i < box.end; ++i) total += m_gifBuckets[m_gifUsed[i]].count;
+        std::uint64_t running = 0;
+        int split = box.begin + 1;
+        for (int i = box.begin; i < box.end - 1; ++i) {
+            running += m_gifBuckets[m_gifUsed[i]].count;
+            split = i + 1;
+            if (running * 2 >= total) break;
+        }
+
+        Box upper = box;
+        box.end = split;
+        upper.begin = split;
+        measure(box);
+        measure(upper);
+        boxes[best] = box;
+        boxes.push_back(upper);
+    }
+
+    // Palette entry = population-weighted mean of each box
+    m_gifPalette.assign(256 * 3, 0);
+    m_gifLookup.resize(32768);
+    for (size_t b = 0; b < boxes.size(); ++b) {
+        std::uint64_t count = 0;
+        std::uint64_t sum[3] = { 0, 0, 0 };
+        for (int i = boxes[b].begin; i < boxes[b].end; ++i) {
+            const GIFBucket& entry = m_gifBuckets[m_gifUsed[i]];
+            count += entry.count;
+            for (int c = 0; c < 3; ++c) sum[c] += entry.sum[c];
+            m_gifLookup[m_gifUsed[i]] = static_cast<std::uint8_t>(b);
+        }
+        for (int c = 0; c < 3 && count > 0; ++c) {
+            m_gifPalette[b * 3 + c] = static_cast<std::uint8_t>(sum[c] / count);
+        }
+    }
+}
+
+void FrameEncoder::writeGIFLZW(std::vector<std::uint8_t>& output) {
+    const int minCodeSize = 8;
+    const int clearCode = 1 << minCodeSize;
+    const int endCode = clearCode + 1;
+    const int maxCode = 4096;
+    const int tableSize = 5003;  // Prime, comfortably above 4096 entries
+
+    output.push_back(minCodeSize);
+
+    // Data sub-blocks of up to 255 bytes, each preceded by its length
+    size_t blockStart = output.size();
+    output.push_back(0);
+    auto putByte = [&](std::uint8_t value) {
+        output.push_back(value);
+        if (output.size() - blockStart - 1 == 255) {
+            output[blockStart] = 255;
+            blockStart = output.size();
+            output.push_back(0);
+        }
+    };
+
+    std::uint32_t bitBuffer = 0;
+    int bitCount = 0;
+    int codeSize = minCodeSize + 1;
+    auto emit = [&](int code) {
+        bitBuffer |= static_cast<std::uint32_t>(code) << bitCount;
+        bitCount += codeSize;
+        while (bitCount >= 8) {
+            putByte(static_cast<std::uint8_t>(bitBuffer & 0xFF));
+            bitBuffer >>= 8;
+            bitCount -= 8;
+        }
+    };
+
+    // The decoder adds each entry one code later than we do, so widen once 'next' passes the limit
+    int nextCode = endCode + 1;
+    auto addEntry = [&]() {
+        ++nextCode;
+        if (nextCode > (1 << codeSize) && codeSize < 12) ++codeSize;
+    };
+
+    m_lzwKeys.assign(tableSize, -1);
+    m_lzwCodes.resize(tableSize);
+    emit(clearCode);
+
+    const size_t count = m_gifIndices.size();
+    int prefix = m_gifIndices[0];
+    for (size_t i = 1; i < count; ++i) {
+        const int value = m_gifIndices[i];
+        const std::int32_t key = (value << 12) | prefix;
+        int slot = ((value << 4) ^ prefix) % tableSize;
+        while (m_lzwKeys[slot] != -1 && m_lzwKeys[slot] != key) {
+            if (++slot == tableSize) slot = 0;
+        }
+        if (m_lzwKeys[slot] == key) {
+            prefix = m_lzwCodes[slot];
+            continue;
+        }
+
+        emit(prefix);
+        m_lzwKeys[slot] = key;
+        m_lzwCodes[slot] = static_cast<std::uint16_t>(nextCode);
+        addEntry();
+        if (nextCode == maxCode) {
+            emit(clearCode);
+            std::fill(m_lzwKeys.begin(), m_lzwKeys.end(), -1);
+            codeSize = minCodeSize + 1;
+            nextCode = endCode + 1;
+        }
+        prefix = value;
+    }
+    emit(prefix);
+    addEntry();
+    emit(endCode);
+    if (bitCount > 0) putByte(static_cast<std::uint8_t>(bitBuffer & 0xFF));
+
+    // Close the last sub-block and add the terminator
+    const size_t lastLength = output.size() - blockStart - 1;
+    output[blockStart] = static_cast<std::uint8_t>(lastLength);
+    if (lastLength > 0) output.push_back(0);
+}
+
+void FrameEncoder::convertToYUV420(const std::uint8_t* pixels, unsigned int width, unsigned int height,
+                                   std::vector<std::uint8_t>& output) {
+    const size_t lumaSize = static_cast<size_t>(width) * height;
+    const unsigned int chromaWidth = (width + 1) / 2;
+    const unsigned int chromaHeight = (height + 1) / 2;
+    const size_t chromaSize = static_cast<size_t>(chromaWidth) * chromaHeight;
+
+    const size_t start = output.size();
+    output.resize(start + lumaSize + chromaSize * 2);
+    std::uint8_t* lumaPlane = output.data() + start;
+    std::uint8_t* cbPlane = lumaPlane + lumaSize;
+    std::uint8_t* crPlane = cbPlane + chromaSize;
+
+    // Premultiplied colour = composited over black
+    auto load = [pixels](size_t index, int& r, int& g, int& b) {
+        const std::uint8_t* px = pixels + index * 4;
+        r = (px[0] * px[3] + 127) / 255;
+        g = (px[1] * px[3] + 127) / 255;
+        b = (px[2] * px[3] + 127) / 255;
+    };
+
+    for (size_t i = 0; i < lumaSize; ++i) {
+        int r, g, b;
+        load(i, r, g, b);
+        lumaPlane[i] = static_cast<std::uint8_t>(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+    }
+
+    for (unsigned int cy = 0; cy < chromaHeight; ++cy) {
+        const unsigned int y0 = cy * 2;
+        const unsigned int y1 = std::min(y0 + 1, height - 1);
+        for (unsigned int cx = 0; cx < chromaWidth; ++cx) {
+            const unsigned int x0 = cx * 2;
+            const unsigned int x1 = std::min(x0 + 1, width - 1);
+            int sumR = 0, sumG = 0, sumB = 0;
+            const size_t corners[4] = {
+                static_cast<size_t>(y0) * width + x0, static_cast<size_t>(y0) * width + x1,
+                static_cast<size_t>(y1) * width + x0, static_cast<size_t>(y1) * width + x1
+            };
+            for (size_t corner : corners) {
+                int r, g, b;
+                load(corner, r, g, b);
+                sumR += r;
+                sumG += g;
+                sumB += b;
+            }
+            const int r = (sumR + 2) >> 2;
+            const int g = (sumG + 2) >> 2;
+            const int b = (sumB + 2) >> 2;
+            const size_t index = static_cast<size_t>(cy) * chromaWidth + cx;
+            cbPlane[index] = static_cast<std::uint8_t>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+            crPlane[index] = static_cast<std::uint8_t>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+        }
+    }
+}
+
+bool FrameEncoder::encodeQOI(const std::uint8_t* pixels, unsigned int width, unsigned int height,
+                             std::vector<std::uint8_t>& output) {
+    // Worst case is 5 bytes per pixel, so write through a pointer and trim at the end
+    const size_t pixelCount = static_cast<size_t>(width) * height;
+    output.resize(14 + pixelCount * 5 + 8);
+    std::uint8_t* out = output.data();
+
+    std::memcpy(out, "qoif", 4);
+    writeU32BE(out + 4, width);
+    writeU32BE(out + 8, height);
+    out[12] = 4;  // RGBA
+    out[13] = 0;  // sRGB with linear alpha
+    out += 14;
+
+    m_qoiIndex.assign(64, 0);
+    std::uint8_t prev[4] = { 0, 0, 0, 255 };
+    std::uint32_t prevPacked;
+    std::memcpy(&prevPacked, prev, 4);
+    int run = 0;
+
+    for (size_t i = 0; i < pixelCount; ++i) {
+        const std::uint8_t* px = pixels + i * 4;
+        std::uint32_t packed;
+        std::memcpy(&packed, px, 4);
+
+        if (packed == prevPacked) {
+            ++run;
+            if (run == 62 || i + 1 == pixelCount) {
+                *out++ = static_cast<std::uint8_t>(0xC0 | (run - 1));
+                run = 0;
+            }
+            continue;
+        }
+
+        if (run > 0) {
+            *out++ = static_cast<std::uint8_t>(0xC0 | (run - 1));
+            run = 0;
+        }
+
+        const int hash = (px[0] * 3 + px[1] * 5 + px[2] * 7 + px[3] * 11) % 64;
+        if (m_qoiIndex[hash] == packed) {
+            *out++ = static_cast<std::uint8_t>(hash);
+        } else {
+            m_qoiIndex[hash] = packed;
+
+            if (px[3] == prev[3]) {
+                const int dr = static_cast<std::int8_t>(px[0] - prev[0]);
+                const int dg = static_cast<std::int8_t>(px[1] - prev[1]);
+                const int db = static_cast<std::int8_t>(px[2] - prev[2]);
+                const int drg = dr - dg;
+                const int dbg = db - dg;
+
+                if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1) {
+                    *out++ = static_cast<std::uint8_t>(0x40 | ((dr + 2) << 4) | ((dg + 2) << 2) | (db + 2));
+                } else if (dg >= -32 && dg <= 31 && drg >= -8 && drg <= 7 && dbg >= -8 && dbg <= 7) {
+                    *out++ = static_cast<std::uint8_t>(0x80 | (dg + 32));
+                    *out++ = static_cast<std::uint8_t>(((drg + 8) << 4) | (dbg + 8));
+                } else {
+                    *out++ = 0xFE;
+                    *out++ = px[0];
+                    *out++ = px[1];
+                    *out++ = px[2];
+                }
+            } else {
+                *out++ = 0xFF;
+                std::memcpy(out, px, 4);
+                out += 4;
+            }
+        }
+
+        std::memcpy(prev, px, 4);
+        prevPacked = packed;
+    }
+
+    static const std::uint8_t endMarker[8] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+    std::memcpy(out, endMarker, 8);
+    out += 8;
+    output.resize(static_cast<size_t>(out - output.data()));
+    return true;
+}
+
+bool FrameEncoder::encodeTGA(const std::uint8_t* pixels, unsigned int width, unsigned int height,
+                             std::vector<std::uint8_t>& output) {
+    if (width > 0xFFFF || height > 0xFFFF) return false;
+
+    const size_t pixelBytes = static_cast<size_t>(width) * height * 4;
+    output.assign(18 + pixelBytes, 0);
+    std::uint8_t* out = output.data();
+
+    out[2] = 2;  // Uncompressed true-colour
+    out[12] = static_cast<std::uint8_t>(width & 0xFF);
+    out[13] = static_cast<std::uint8_t>(width >> 8);
+    out[14] = static_cast<std::uint8_t>(height & 0xFF);
+    out[15] = static_cast<std::uint8_t>(height >> 8);
+    out[16] = 32;
+    out[17] = 0x28;  // 8 alpha bits, top-left origin, so rows stay in order
+    out += 18;
+
+    // TGA stores BGRA
+    for (size_t i = 0; i < pixelBytes; i += 4) {
+        out[i + 0] = pixels[i + 2];
+        out[i + 1] = pixels[i + 1];
+        out[i + 2] = pixels[i + 0];
+        out[i + 3] = pixels[i + 3];
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,59 @@
+#include "Editor/Export/GIFExporter.h"
+
+namespace Riggle {
+
+bool GIFExporter::beginOutput(const std::string& outputPath, int /*frameCount*/) {
+    if (getWidth() > 0xFFFF || getHeight() > 0xFFFF) {
+        m_lastError = "GIF frames are limited to 65535x65535";
+        return false;
+    }
+    if (!openOutputFile(outputPath, m_file)) return false;
+
+    // Header and logical screen without a global colour table; every frame has its own
+    const std::uint8_t screen[13] = {
+        'G', 'I', 'F', '8', '9', 'a',
+        static_cast<std::uint8_t>(getWidth() & 0xFF), static_cast<std::uint8_t>(getWidth() >> 8),
+        static_cast<std::uint8_t>(getHeight() & 0xFF), static_cast<std::uint8_t>(getHeight() >> 8),
+        0, 0, 0
+    };
+    m_file.write(reinterpret_cast<const char*>(screen), sizeof(screen));
+
+    // Loop forever
+    const std::uint8_t loop[19] = {
+        0x21, 0xFF, 0x0B, 'N', 'E', 'T', 'S', 'C', 'A', 'P', 'E', '2', '.', '0', 0x03, 0x01, 0, 0, 0
+    };
+    m_file.write(reinterpret_cast<const char*>(loop), sizeof(loop));
+
+    if (!m_file) {
+        m_lastError = "Failed to write " + outputPath;
+        return false;
+    }
+    return true;
+}
+
+bool GIFExporter::encodeFrame(FrameEncoder& encoder, const sf::Image& image, std::vector<std::uint8_t>& bytes) {
+    bytes.clear();
+    return encoder.encodeGIFImage(image.getPixelsPtr(), image.getSize().x, image.getSize().y, bytes);
+}
+
+bool GIFExporter::writeFrame(int frame, const std::vector<std::uint8_t>& bytes) {
+    if (bytes.size() < 8) return false;
+
+    // Delays are in 1/100 s; round the frame boundaries so the total length doesn't drift
+    const int fps = getFrameRate();
+    const int delay = ((frame + 1) * 100 + fps / 2) / fps - (frame * 100 + fps / 2) / fps;
+    const char delayBytes[2] = { static_cast<char>(delay & 0xFF), static_cast<char>(delay >> 8) };
+
+    m_file.write(reinterpret_cast<const char*>(bytes.data()), 4);
+    m_file.write(delayBytes, 2);
+    m_file.write(reinterpret_cast<const char*>(bytes.data()) + 6, static_cast<std::streamsize>(bytes.size() - 6));
+    return static_cast<bool>(m_file);
+}
+
+bool GIFExporter::endOutput(bool completed) {
+    if (completed) m_file.put(0x3B);  // Trailer
+    m_file.close();
+    return !m_file.fail();
+}
+
+}
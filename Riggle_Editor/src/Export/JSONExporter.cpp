@@ -38,7 +38,8 @@ std::string JSONProjectExporter::serializeProject(const ExportProject& project)
     json << "  \"version\": \"" << escapeJsonString(project.version) << "\",\n";
     json << "  \"bones\": " << serializeBones(project.bones) << ",\n";
     json << "  \"sprites\": " << serializeSprites(project.sprites) << ",\n";
-    json << "  \"animations\": " << serializeAnimations(project.animations) << "\n";
+    json << "  \"animations\": " << serializeAnimations(project.animations) << ",\n";
+    json << "  \"lodLevels\": " << serializeLODLevels(project.lodLevels) << "\n";
     json << "}";
     
     return json.str();
@@ -56,6 +57,16 @@ std::string JSONProjectExporter::serializeBones(const std::vector<ExportBone>& b
         json << "      \"parentName\": \"" << escapeJsonString(bone.parentName) << "\",\n";
         json << "      \"transform\": " << serializeTransform(bone.transform) << ",\n";
         json << "      \"length\": " << std::fixed << std::setprecision(6) << bone.length << ",\n";
+        json << "      \"spring\": { \"enabled\": " << (bone.spring.enabled ? "true" : "false")
+             << ", \"stiffness\": " << bone.spring.stiffness
+             << ", \"damping\": " << bone.spring.damping
+             << ", \"gravity\": " << bone.spring.gravity << " },\n";
+        json << "      \"rotationLimits\": { \"enabled\": " << (bone.rotationLimits.enabled ? "true" : "false")
+             << ", \"min\": " << bone.rotationLimits.minRotation
+             << ", \"max\": " << bone.rotationLimits.maxRotation << " },\n";
+        json << "      \"constraints\": " << serializeConstraints(bone.constraints) << ",\n";
+        json << "      \"ikConstraints\": " << serializeIKConstraints(bone.ikConstraints) << ",\n";
+        json << "      \"proceduralChannels\": " << serializeProceduralChannels(bone.proceduralChannels) << ",\n";
         json << "      \"childNames\": [";
         
         for (size_t j = 0; j < bone.childNames.size(); ++j) {
@@ -87,7 +98,9 @@ std::string JSONProjectExporter::serializeSprites(const std::vector<ExportSprite
         json << "      \"isVisible\": " << (sprite.isVisible ? "true" : "false") << ",\n";
         json << "      \"boundBoneName\": \"" << escapeJsonString(sprite.boundBoneName) << "\",\n";
         json << "      \"bindOffset\": " << serializeVector2(sprite.bindOffset) << ",\n";
-        json << "      \"bindRotation\": " << std::fixed << std::setprecision(6) << sprite.bindRotation << "\n";
+        json << "      \"bindRotation\": " << std::fixed << std::setprecision(6) << sprite.bindRotation << ",\n";
+        json << "      \"mesh\": " << serializeSpriteMesh(sprite.mesh) << ",\n";
+        json << "      \"skin\": " << serializeSpriteSkin(sprite) << "\n";
         json << "    }";
         if (i < sprites.size() - 1) json << ",";
         json << "\n";
@@ -143,6 +156,179 @@ std::string JSONProjectExporter::serializeAnimations(const std::vector<ExportAni
     return json.str();
 }
 
+std::string JSONProjectExporter::serializeLODLevels(const std::vector<ExportLODLevel>& lodLevels) {
+    std::ostringstream json;
+    
+    json << "[\n";
+    for (size_t i = 0; i < lodLevels.size(); ++i) {
+        const auto& lod = lodLevels[i];
+        
+        json << "    {\n";
+        json << "      \"name\": \"" << escapeJsonString(lod.name) << "\",\n";
+        json << "      \"screenScaleThreshold\": " << std::fixed << std::setprecision(6) << lod.screenScaleThreshold << ",\n";
+        json << "      \"collapsedBones\": [";
+        
+        for (size_t j = 0; j < lod.collapsedBones.size(); ++j) {
+            json << "\"" << escapeJsonString(lod.collapsedBones[j]) << "\"";
+            if (j < lod.collapsedBones.size() - 1) json << ", ";
+        }
+        
+        json << "]\n";
+        json << "    }";
+        if (i < lodLevels.size() - 1) json << ",";
+        json << "\n";
+    }
+    json << "  ]";
+    
+    return json.str();
+}
+
+std::string JSONProjectExporter::serializeSpriteMesh(const SpriteMesh& mesh) {
+    std::ostringstream json;
+    json << std::fixed << std::setprecision(3);
+    
+    // Flat [x0, y0, x1, y1, ...] arrays keep dense meshes compact
+    json << "{ \"vertices\": [";
+    for (size_t i = 0; i < mesh.vertices.size(); ++i) {
+        if (i > 0) json << ", ";
+        json << mesh.vertices[i].x << ", " << mesh.vertices[i].y;
+    }
+    json << "], \"uvs\": [";
+    for (size_t i = 0; i < mesh.uvs.size(); ++i) {
+        if (i > 0) json << ", ";
+        json << mesh.uvs[i].x << ", " << mesh.uvs[i].y;
+    }
+    json << "], \"indices\": [";
+    for (size_t i = 0; i < mesh.indices.size(); ++i) {
+        if (i > 0) json << ", ";
+        json << mesh.indices[i];
+    }
+    json << "] }";
+    
+    return json.str();
+}
+
+std::string JSONProjectExporter::serializeSpriteSkin(const ExportSprite& sprite) {
+    std::ostringstream json;
+    json << std::fixed << std::setprecision(6);
+    
+    json << "{ \"bones\": [";
+    for (size_t i = 0; i < sprite.skinBoneNames.size(); ++i) {
+        if (i > 0) json << ", ";
+        json << "\"" << escapeJsonString(sprite.skinBoneNames[i]) << "\"";
+    }
+    json << "], \"bindPoses\": [";
+    for (size_t i = 0; i < sprite.skinBindPoses.size(); ++i) {
+        if (i > 0) json << ", ";
+        json << serializeTransform(sprite.skinBindPoses[i]);
+    }
+    json << "], \"bindVertices\": [";
+    for (size_t i = 0; i < sprite.skinBindVertices.size(); ++i) {
+        if (i > 0) json << ", ";
+        json << sprite.skinBindVertices[i].x << ", " << sprite.skinBindVertices[i].y;
+    }
+    
+    // Four (bone, weight) pairs per vertex
+    json << "], \"weights\": [";
+    for (size_t i = 0; i < sprite.skinWeights.size(); ++i) {
+        const auto& vw = sprite.skinWeights[i];
+        for (int k = 0; k < MAX_BONE_INFLUENCES; ++k) {
+            if (i > 0 || k > 0) json << ", ";
+            json << vw.boneIndices[k] << ", " << vw.weights[k];
+        }
+    }
+    json << "] }";
+    
+    return json.str();
+}
+
+std::string JSONProjectExporter::serializeConstraints(const std::vector<BoneConstraint>& constraints) {
+    std::ostringstream json;
+    json << std::fixed << std::setprecision(6);
+    
+    json << "[";
+    for (size_t i = 0; i < constraints.size(); ++i) {
+        const auto& constraint = constraints[i];
+        
+        json << "\n        { \"type\": \"" << constraintTypeToString(constraint.type) << "\""
+             << ", \"target\": \"" << escapeJsonString(constraint.targetName) << "\""
+             << ", \"enabled\": " << (constraint.enabled ? "true" : "false")
+             << ", \"influence\": " << constraint.influence
+             << ", \"rotationOffset\": " << constraint.rotationOffset
+             << ", \"minRotation\": " << constraint.minRotation
+             << ", \"maxRotation\": " << constraint.maxRotation
+             << ", \"targetOffset\": " << serializeTransform(constraint.targetOffset) << " }";
+        if (i < constraints.size() - 1) json << ",";
+    }
+    if (!constraints.empty()) json << "\n      ";
+    json << "]";
+    
+    return json.str();
+}
+
+std::string JSONProjectExporter::serializeIKConstraints(const std::vector<IKConstraint>& constraints) {
+    std::ostringstream json;
+    json << std::fixed << std::setprecision(6);
+    
+    json << "[";
+    for (size_t i = 0; i < constraints.size(); ++i) {
+        const auto& constraint = constraints[i];
+        
+        json << "\n        { \"target\": \"" << escapeJsonString(constraint.targetBone) << "\""
+             << ", \"targetPosition\": " << serializeVector2(constraint.targetPosition)
+             << ", \"chainLength\": " << constraint.chainLength
+             << ", \"enabled\": " << (constraint.enabled ? "true" : "false")
+             << ", \"solver\": \"" << IKSolver::getSolverName(constraint.settings.type) << "\""
+             << ", \"maxIterations\": " << constraint.settings.maxIterations
+             << ", \"tolerance\": " << constraint.settings.tolerance
+             << ", \"bendDirection\": " << constraint.settings.bendDirection
+             << ", \"damping\": " << constraint.settings.damping;
+        if (!constraint.extraEffectors.empty()) {
+            json << ", \"extraEffectors\": [";
+            for (size_t e = 0; e < constraint.extraEffectors.size(); ++e) {
+                const auto& extra = constraint.extraEffectors[e];
+                json << (e > 0 ? ", " : "") << "{ \"bone\": \"" << escapeJsonString(extra.endEffector) << "\""
+                     << ", \"target\": \"" << escapeJsonString(extra.targetBone) << "\""
+                     << ", \"targetPosition\": " << serializeVector2(extra.targetPosition)
+                     << ", \"weight\": " << extra.weight << " }";
+            }
+            json << "]";
+        }
+        json << " }";
+        if (i < constraints.size() - 1) json << ",";
+    }
+    if (!constraints.empty()) json << "\n      ";
+    json << "]";
+    
+    return json.str();
+}
+
+std::string JSONProjectExporter::serializeProceduralChannels(const std::vector<ProceduralChannel>& channels) {
+    std::ostringstream json;
+    json << std::fixed << std::setprecision(6);
+    
+    json << "[";
+    for (size_t i = 0; i < channels.size(); ++i) {
+        const auto& channel = channels[i];
+        
+        json << "\n        { \"generator\": \"" << proceduralGeneratorToString(channel.generator) << "\""
+             << ", \"channel\": \"" << proceduralTargetToString(channel.target) << "\""
+             << ", \"source\": \"" << escapeJsonString(channel.sourceName) << "\""
+             << ", \"enabled\": " << (channel.enabled ? "true" : "false")
+             << ", \"amplitude\": " << channel.amplitude
+             << ", \"frequency\": " << channel.frequency
+             << ", \"phase\": " << channel.phase
+             << ", \"seed\": " << channel.seed
+             << ", \"octaves\": " << channel.octaves
+             << ", \"delay\": " << channel.delay << " }";
+        if (i < channels.size() - 1) json << ",";
+    }
+    if (!channels.empty()) json << "\n      ";
+    json << "]";
+    
+    return json.str();
+}
+
 std::string JSONProjectExporter::serializeTransform(const Transform& transform) {
     std::ostringstream json;
     json << std::fixed << std::setprecision(6);
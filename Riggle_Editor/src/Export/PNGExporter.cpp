@@ -1,14 +1,78 @@
 #include "Editor/Export/PNGExporter.h"
+#include <Riggle/BoundedQueue.h>
 #include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <thread>
 #include <iomanip>
 #include <sstream>
 #include <algorithm>
+#include <chrono>
+#include <functional>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <limits>
 
 namespace Riggle {
 
+namespace {
+
+// Area-average resize to a smaller size, in premultiplied alpha so transparent
+// pixels don't darken the edges. Each source pixel lands in exactly one output pixel
+void downsampleImage(const std::uint8_t* source, unsigned int sourceWidth, unsigned int sourceHeight,
+                     int width, int height, std::vector<std::uint8_t>& pixels) {
+    pixels.resize(static_cast<size_t>(width) * height * 4);
+    std::vector<unsigned int> columns(width + 1);
+    for (int x = 0; x <= width; ++x) {
+        columns[x] = static_cast<unsigned int>(static_cast<std::uint64_t>(x) * sourceWidth / width);
+    }
+
+    std::uint8_t* out = pixels.data();
+    for (int y = 0; y < height; ++y) {
+        const unsigned int y0 = static_cast<unsigned int>(static_cast<std::uint64_t>(y) * sourceHeight / height);
+        const unsigned int y1 = std::max(y0 + 1, static_cast<unsigned int>(static_cast<std::uint64_t>(y + 1) * sourceHeight / height));
+        for (int x = 0; x < width; ++x, out += 4) {
+            const unsigned int x0 = columns[x];
+            const unsigned int x1 = std::max(x0 + 1, columns[x + 1]);
+
+            std::uint64_t r = 0, g = 0, b = 0, a = 0;
+            for (unsigned int sy = y0; sy < y1; ++sy) {
+                const std::uint8_t* p = source + (static_cast<size_t>(sy) * sourceWidth + x0) * 4;
+                for (unsigned int sx = x0; sx < x1; ++sx, p += 4) {
+                    r += p[0] * p[3];
+                    g += p[1] * p[3];
+                    b += p[2] * p[3];
+                    a += p[3];
+                }
+            }
+
+            const std::uint64_t count = static_cast<std::uint64_t>(x1 - x0) * (y1 - y0);
+            out[3] = static_cast<std::uint8_t>((a + count / 2) / count);
+            if (a == 0) {
+                out[0] = out[1] = out[2] = 0;
+            } else {
+                out[0] = static_cast<std::uint8_t>((r + a / 2) / a);
+                out[1] = static_cast<std::uint8_t>((g + a / 2) / a);
+                out[2] = static_cast<std::uint8_t>((b + a / 2) / a);
+            }
+        }
+    }
+}
+
+} // namespace
+
 PNGSequenceExporter::PNGSequenceExporter() 
-    : m_frameRate(30), m_width(1920), m_height(1080) {
+    : m_frameRate(30), m_width(1920), m_height(1080), m_frameWidth(1920), m_frameHeight(1080) {
+    m_frameCache.setDirectory(getDefaultFrameCacheDirectory());
+}
+
+std::string PNGSequenceExporter::getDefaultFrameCacheDirectory() {
+    std::error_code error;
+    std::filesystem::path temp = std::filesystem::temp_directory_path(error);
+    if (error) return "";
+    return (temp / "Riggle" / "ExportCache").string();
 }
 
 bool PNGSequenceExporter::exportAnimation(const ExportAnimation& animation, 
@@ -16,95 +80,454 @@ bool PNGSequenceExporter::exportAnimation(const ExportAnimation& animation,
                                          const std::vector<ExportBone>& bones,
                                          const std::string& outputPath) {
     try {
-        // Create output directory
-        if (!createDirectory(outputPath)) {
-            m_lastError = "Failed to create output directory: " + outputPath;
+        int totalFrames = static_cast<int>(animation.duration * m_frameRate);
+        prepareSequence(animation, sprites, bones, totalFrames);
+        
+        // Render at the largest output scale; the smaller ones are spooled until the end
+        const std::string mainOutputPath = setupScaledOutputs(outputPath);
+        
+        // Frames from earlier runs are only valid for the same output settings and assets
+        m_frameCacheActive = m_frameCache.isEnabled() && m_frameCache.begin(computeFrameCacheHash(sprites));
+        
+        // Create the output directory or open the output file
+        if (!beginOutput(mainOutputPath, totalFrames + 1)) {
+            closeScaledOutputs();
             return false;
         }
 
-        // Clear texture cache
-        m_textureCache.clear();
+        std::cout << "Exporting " << totalFrames + 1 << " frames at " << m_frameRate << " FPS" << std::endl;
+        std::cout << "Animation duration: " << animation.duration << " seconds" << std::endl;
+
+        // One render target for the whole sequence (the software backend needs no GPU context)
+        const sf::Vector2u size(static_cast<unsigned>(m_frameWidth), static_cast<unsigned>(m_frameHeight));
+        if (m_backend == RenderBackend::SFML && m_renderTexture.getSize() != size && !m_renderTexture.resize(size)) {
+            m_lastError = "Failed to create render target";
+            endOutput(false);
+            closeScaledOutputs();
+            return false;
+        }
+
+        bool exported = m_pipelined ? exportFramesPipelined(animation, sprites, totalFrames)
+                                    : exportFramesSerial(animation, sprites, totalFrames);
+        bool finished = endOutput(exported);
+        bool scaled = exported && finished && writeScaledOutputs(totalFrames + 1);
+        closeScaledOutputs();
+        if (m_frameCacheActive) {
+            m_frameCache.prune();
+        }
+        if (!exported) {
+            return false;
+        }
+        if (!finished) {
+            m_lastError = "Failed to finish writing " + mainOutputPath;
+            return false;
+        }
+        if (!scaled) {
+            return false;
+        }
+
+        std::cout << getFormatName() << " export completed successfully!" << std::endl;
+        return true;
+    }
+    catch (const std::exception& e) {
+        closeScaledOutputs();
+        m_lastError = "Exception during " + getFormatName() + " export: " + std::string(e.what());
+        return false;
+    }
+}
 
-        // Calculate total frames
+bool PNGSequenceExporter::compareBackends(const ExportAnimation& animation,
+                                          const std::vector<ExportSprite>& sprites,
+                                          const std::vector<ExportBone>& bones,
+                                          BackendComparison& result) {
+    result = BackendComparison();
+    const RenderBackend backend = m_backend;
+    try {
         int totalFrames = static_cast<int>(animation.duration * m_frameRate);
-        float frameTime = 1.0f / m_frameRate;
+        prepareSequence(animation, sprites, bones, totalFrames);
 
-        std::cout << "Exporting " << totalFrames + 1 << " frames at " << m_frameRate << " FPS" << std::endl;
-        std::cout << "Animation duration: " << animation.duration << " seconds" << std::endl;
+        const sf::Vector2u size(static_cast<unsigned>(m_frameWidth), static_cast<unsigned>(m_frameHeight));
+        if (m_renderTexture.getSize() != size && !m_renderTexture.resize(size)) {
+            m_lastError = "Failed to create render target";
+            return false;
+        }
 
-        // Export each frame
-        for (int frame = 0; frame <= totalFrames; ++frame) {
-            float currentTime = frame * frameTime;
-            
-            // Generate frame filename
-            std::ostringstream filename;
-            filename << outputPath << "/frame_" << std::setfill('0') << std::setw(6) << frame << ".png";
-            
-            if (!renderFrame(currentTime, animation, sprites, bones, filename.str())) {
-                m_lastError = "Failed to render frame " + std::to_string(frame);
-                return false;
+        // Every frame in order (spring bones carry state), each posed once and drawn twice
+        const float frameTime = 1.0f / m_frameRate;
+        sf::Image gpuImage;
+        sf::Image cpuImage;
+        bool rendered = true;
+        for (int frame = 0; frame <= totalFrames && rendered; ++frame) {
+            poseFrame(frame * frameTime, animation);
+            m_backend = RenderBackend::SFML;
+            rendered = renderFrame(sprites, gpuImage);
+            m_backend = RenderBackend::Software;
+            rendered = rendered && renderFrame(sprites, cpuImage);
+            if (!rendered || gpuImage.getSize() != cpuImage.getSize()) {
+                m_lastError = "Failed to render frame " + std::to_string(frame) + " on both backends";
+                rendered = false;
+                break;
             }
-            
-            // Progress feedback
-            if (frame % 10 == 0 || frame == totalFrames) {
-                std::cout << "Rendered frame " << frame << "/" << totalFrames << std::endl;
+
+            const std::uint8_t* gpu = gpuImage.getPixelsPtr();
+            const std::uint8_t* cpu = cpuImage.getPixelsPtr();
+            const size_t pixelCount = static_cast<size_t>(size.x) * size.y;
+            int frameMax = 0;
+            for (size_t i = 0; i < pixelCount; ++i) {
+                int pixelMax = 0;
+                for (int channel = 0; channel < 4; ++channel) {
+                    pixelMax = std::max(pixelMax, std::abs(gpu[i * 4 + channel] - cpu[i * 4 + channel]));
+                }
+                if (pixelMax > 0) ++result.differingPixels;
+                if (pixelMax > result.tolerance) ++result.pixelsOverTolerance;
+                frameMax = std::max(frameMax, pixelMax);
+            }
+            if (frameMax > result.maxChannelDifference) {
+                result.maxChannelDifference = frameMax;
+                result.worstFrame = frame;
             }
+            result.totalPixels += pixelCount;
+            ++result.frames;
         }
+        m_backend = backend;
+        if (!rendered) return false;
 
-        std::cout << "PNG sequence export completed successfully!" << std::endl;
+        std::cout << "Backend comparison: " << result.frames << " frames, max channel difference "
+                  << result.maxChannelDifference << " (frame " << result.worstFrame << "), "
+                  << result.differingPixels << " of " << result.totalPixels << " pixels differ, "
+                  << result.pixelsOverTolerance << " by more than " << result.tolerance << std::endl;
         return true;
     }
     catch (const std::exception& e) {
-        m_lastError = "Exception during PNG sequence export: " + std::string(e.what());
+        m_backend = backend;
+        m_lastError = "Exception during backend comparison: " + std::string(e.what());
         return false;
     }
 }
 
-bool PNGSequenceExporter::renderFrame(float time, const ExportAnimation& animation,
-                                     const std::vector<ExportSprite>& sprites, 
-                                     const std::vector<ExportBone>& bones, 
-                                     const std::string& framePath) {
-    // Create render target
-    sf::RenderTexture renderTexture;
-    if (!renderTexture.resize({ static_cast<unsigned>(m_width), static_cast<unsigned>(m_height) })) {
+void PNGSequenceExporter::prepareSequence(const ExportAnimation& animation, const std::vector<ExportSprite>& sprites,
+                                          const std::vector<ExportBone>& bones, int totalFrames) {
+    // Clear texture cache
+    m_textureCache.clear();
+    m_rasterTextureCache.clear();
+
+    // Without encoder threads the rasteriser may use every core
+    m_rasterizer.setThreadCount(0);
+    
+    // Bones, sprites and tracks are resolved to indices once for the whole sequence
+    m_pose.compile(bones, sprites);
+    m_pose.bindAnimation(animation);
+    
+    // Channels, IK chains and the constraint schedule are built once too
+    setupProceduralChannels(bones);
+    setupIKConstraints(bones);
+    setupConstraints(bones);
+    
+    // Spring chains restart from the first frame so every export matches
+    setupSpringBones(bones);
+    
+    // Build skin data once for all frames
+    m_skinCache.clear();
+    for (const auto& sprite : sprites) {
+        if (sprite.mesh.isEmpty() || sprite.skinBoneNames.empty()) continue;
+        if (sprite.skinBindVertices.size() != sprite.mesh.getVertexCount()) continue;
+        
+        SkinData& skin = m_skinCache[sprite.name];
+        skin.setBindPoses(sprite.skinBindPoses);
+        skin.setBindVertices(sprite.skinBindVertices);
+        skin.setVertexWeights(sprite.skinWeights);
+    }
+
+    // Preset canvas, or the bounds of every pose when auto-cropping
+    setupFrameBounds(animation, sprites, bones, totalFrames);
+}
+
+bool PNGSequenceExporter::exportFramesSerial(const ExportAnimation& animation,
+                                            const std::vector<ExportSprite>& sprites, int totalFrames) {
+    const float frameTime = 1.0f / m_frameRate;
+    FrameEncoder encoder(m_encoderSettings);
+    sf::Image image;
+    std::vector<std::vector<std::uint8_t>> outputs(m_scaledOutputs.size() + 1);  // Main output first
+    int repeated = 0;
+    int cached = 0;
+    for (int frame = 0; frame <= totalFrames; ++frame) {
+        // Held poses write the previous frame's bytes again without rendering
+        poseFrame(frame * frameTime, animation);
+        if (updateDrawKey(sprites) && frame > 0) {
+            ++repeated;
+        } else if (m_frameCacheActive && loadCachedFrame(outputs)) {
+            ++cached;
+        } else {
+            if (!renderFrame(sprites, image) || !encodeOutputs(encoder, image, outputs)) {
+                m_lastError = "Failed to render frame " + std::to_string(frame);
+                return false;
+            }
+            if (m_frameCacheActive) {
+                storeCachedFrame(m_drawKey, outputs, frame);
+            }
+        }
+        if (!writeOutputs(frame, outputs)) {
+            m_lastError = "Failed to write frame " + std::to_string(frame);
+            return false;
+        }
+        
+        // Progress feedback
+        if (frame % 10 == 0 || frame == totalFrames) {
+            std::cout << "Rendered frame " << frame << "/" << totalFrames << std::endl;
+        }
+    }
+    if (repeated > 0 || cached > 0) {
+        std::cout << "Reused " << repeated << " held and " << cached << " cached frame(s)" << std::endl;
+    }
+    return true;
+}
+
+bool PNGSequenceExporter::exportFramesPipelined(const ExportAnimation& animation,
+                                               const std::vector<ExportSprite>& sprites, int totalFrames) {
+    // Cores are split between encoders and, on the software backend, the tile threads
+    // of the render loop (this thread included), so the two stages don't oversubscribe
+    const unsigned int hardware = std::max(2u, std::thread::hardware_concurrency());
+    const bool software = m_backend == RenderBackend::Software;
+    const unsigned int encoderCount = m_encoderThreads > 0 ? m_encoderThreads
+                                    : software ? std::max(1u, hardware / 2) : hardware - 1;
+    if (software) {
+        m_rasterizer.setThreadCount(hardware > encoderCount ? hardware - encoderCount : 1u);
+    }
+    
+    // Rendered images are large, so only a couple per encoder may wait
+    // A repeated frame carries no image or bytes; the writer reuses the previous frame's.
+    // A cached frame carries its bytes from the frame cache instead of an image
+    struct RenderedFrame {
+        int index = 0;
+        bool repeat = false;
+        bool cached = false;
+        sf::Image image;
+        std::vector<std::vector<std::uint8_t>> outputs;  // One per output scale, main first
+        std::vector<float> drawKey;  // For storing newly encoded frames in the cache
+    };
+    struct EncodedFrame {
+        int index = 0;
+        bool repeat = false;
+        std::vector<std::vector<std::uint8_t>> outputs;
+    };
+    const size_t outputCount = m_scaledOutputs.size() + 1;
+    BoundedQueue<RenderedFrame> rendered(encoderCount * 2);
+    BoundedQueue<EncodedFrame> encoded(encoderCount * 2);
+    
+    std::mutex errorMutex;
+    std::string error;
+    auto fail = [&](const std::string& message) {
+        {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (error.empty()) error = message;
+        }
+        rendered.close();
+        encoded.close();
+    };
+    
+    // Same encoder settings as the serial path, so files match byte for byte
+    std::vector<std::thread> encoders;
+    for (unsigned int i = 0; i < encoderCount; ++i) {
+        encoders.emplace_back([&]() {
+            try {
+                FrameEncoder encoder(m_encoderSettings);
+                RenderedFrame frame;
+                while (rendered.pop(frame)) {
+                    EncodedFrame result;
+                    result.index = frame.index;
+                    result.repeat = frame.repeat;
+                    if (frame.cached) {
+                        result.outputs = std::move(frame.outputs);
+                    } else if (!frame.repeat) {
+                        result.outputs.resize(outputCount);
+                        if (!encodeOutputs(encoder, frame.image, result.outputs)) {
+                            fail("Failed to encode frame " + std::to_string(frame.index));
+                            return;
+                        }
+                        if (m_frameCacheActive) {
+                            storeCachedFrame(frame.drawKey, result.outputs, frame.index);
+                        }
+                    }
+                    if (!encoded.push(std::move(result))) return;
+                }
+            } catch (const std::exception& e) {
+                fail("Exception while encoding: " + std::string(e.what()));
+            }
+        });
+    }
+    
+    // Frames finish encoding in any order, files are written in frame order
+    std::thread writer([&]() {
+        try {
+            std::map<int, EncodedFrame> pending;
+            std::vector<std::vector<std::uint8_t>> previous(outputCount);
+            int next = 0;
+            EncodedFrame frame;
+            while (encoded.pop(frame)) {
+                pending.emplace(frame.index, std::move(frame));
+                for (auto it = pending.find(next); it != pending.end(); it = pending.find(next)) {
+                    if (!it->second.repeat) {
+                        previous.swap(it->second.outputs);
+                    }
+                    if (!writeOutputs(next, previous)) {
+                        fail("Failed to write frame " + std::to_string(next));
+                        return;
+                    }
+                    pending.erase(it);
+                    
+                    // Progress feedback
+                    if (next % 10 == 0 || next == totalFrames) {
+                        std::cout << "Wrote frame " << next << "/" << totalFrames << std::endl;
+                    }
+                    ++next;
+                }
+            }
+        } catch (const std::exception& e) {
+            fail("Exception while writing: " + std::string(e.what()));
+        }
+    });
+    
+    // Posing and rasterising stay on this thread: spring bones step frame by frame
+    // and the render target belongs to this thread's context
+    const float frameTime = 1.0f / m_frameRate;
+    int repeated = 0;
+    int cached = 0;
+    for (int frame = 0; frame <= totalFrames; ++frame) {
+        RenderedFrame item;
+        item.index = frame;
+        poseFrame(frame * frameTime, animation);
+        item.repeat = updateDrawKey(sprites) && frame > 0;
+        if (item.repeat) {
+            ++repeated;
+        } else if (m_frameCacheActive && loadCachedFrame(item.outputs)) {
+            item.cached = true;
+            ++cached;
+        } else {
+            item.outputs.clear();
+            if (!renderFrame(sprites, item.image)) {
+                fail("Failed to render frame " + std::to_string(frame));
+                break;
+            }
+            if (m_frameCacheActive) {
+                item.drawKey = m_drawKey;
+            }
+        }
+        if (!rendered.push(std::move(item))) break;
+    }
+    if (repeated > 0 || cached > 0) {
+        std::cout << "Reused " << repeated << " held and " << cached << " cached frame(s)" << std::endl;
+    }
+    
+    rendered.close();
+    for (auto& encoder : encoders) {
+        encoder.join();
+    }
+    encoded.close();
+    writer.join();
+    
+    if (!error.empty()) {
+        m_lastError = error;
         return false;
     }
+    return true;
+}
 
-    // Clear with background color
-    renderTexture.clear(m_backgroundColor);
+bool PNGSequenceExporter::beginOutput(const std::string& outputPath, int /*frameCount*/) {
+    if (!createDirectory(outputPath)) {
+        m_lastError = "Failed to create output directory: " + outputPath;
+        return false;
+    }
+    m_outputPath = outputPath;
+    return true;
+}
 
-    // Step 1: Apply animation to bones (replicate Animation::applyAtTime)
-    std::vector<ExportBone> animatedBones = bones;
-    applyAnimationToBones(animatedBones, animation, time);
+bool PNGSequenceExporter::encodeFrame(FrameEncoder& encoder, const sf::Image& image, std::vector<std::uint8_t>& bytes) {
+    return encoder.encode(image.getPixelsPtr(), image.getSize().x, image.getSize().y, bytes);
+}
 
-    // Step 2: Calculate world transforms for all bones (replicate Rig::forceUpdateWorldTransforms)
-    calculateAllWorldTransforms(animatedBones);
+bool PNGSequenceExporter::writeFrame(int frame, const std::vector<std::uint8_t>& bytes) {
+    return writeFile(getFramePath(m_outputPath, frame), bytes);
+}
+
+bool PNGSequenceExporter::endOutput(bool /*completed*/) {
+    return true;
+}
+
+bool PNGSequenceExporter::openOutputFile(const std::string& path, std::ofstream& file) {
+    std::filesystem::path parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty() && !createDirectory(parent.string())) {
+        m_lastError = "Failed to create output directory: " + parent.string();
+        return false;
+    }
+    
+    file.close();
+    file.clear();
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        m_lastError = "Failed to open " + path + " for writing";
+        return false;
+    }
+    return true;
+}
+
+std::string PNGSequenceExporter::getFramePath(const std::string& outputPath, int frame) const {
+    std::ostringstream filename;
+    filename << outputPath << "/frame_" << std::setfill('0') << std::setw(6) << frame
+             << FrameEncoder::getFileExtension(m_encoderSettings.format);
+    return filename.str();
+}
+
+bool PNGSequenceExporter::writeFile(const std::string& path, const std::vector<std::uint8_t>& bytes) {
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return static_cast<bool>(file);
+}
+
+bool PNGSequenceExporter::renderFrame(const std::vector<ExportSprite>& sprites, sf::Image& image) {
+    // The skeleton is already posed (poseFrame)
+    if (m_backend == RenderBackend::Software) {
+        return rasterizeFrame(sprites, image);
+    }
+
+    // Clear with background color
+    sf::RenderTexture& renderTexture = m_renderTexture;
+    renderTexture.clear(m_backgroundColor);
 
     // Step 3: Render sprites with proper world transforms
-    for (const auto& sprite : sprites) {
+    for (size_t spriteIndex = 0; spriteIndex < sprites.size(); ++spriteIndex) {
+        const ExportSprite& sprite = sprites[spriteIndex];
         if (!sprite.isVisible) continue;
 
-        // Load or get cached texture
-        sf::Texture* texture = nullptr;
-        auto it = m_textureCache.find(sprite.texturePath);
-        if (it != m_textureCache.end()) {
-            texture = &it->second;
-        } else {
-            // Load and cache texture
-            sf::Texture newTexture;
-            if (newTexture.loadFromFile(sprite.texturePath)) {
-                m_textureCache[sprite.texturePath] = std::move(newTexture);
-                texture = &m_textureCache[sprite.texturePath];
-            } else {
-                std::cout << "Warning: Failed to load texture: " << sprite.texturePath << std::endl;
-                continue;
+        sf::Texture* texture = getTexture(sprite.texturePath);
+        if (!texture) continue;
+
+        // Calculate sprite's world transform
+        Transform spriteWorldTransform = m_pose.getSpriteWorldTransform(static_cast<int>(spriteIndex));
+        
+        // Mesh sprites: deform, then center and zoom like the quad path below
+        if (!sprite.mesh.isEmpty()) {
+            if (!deformSpriteMesh(sprite, static_cast<int>(spriteIndex), spriteWorldTransform)) continue;
+            
+            const auto& mesh = sprite.mesh;
+            m_meshVertices.setPrimitiveType(sf::PrimitiveType::Triangles);
+            m_meshVertices.resize(mesh.indices.size());
+            for (size_t i = 0; i < mesh.indices.size(); ++i) {
+                unsigned int index = mesh.indices[i];
+                m_meshVertices[i].position = {
+                    m_deformX[index] * m_frameZoom + m_frameOrigin.x,
+                    m_deformY[index] * m_frameZoom + m_frameOrigin.y
+                };
+                m_meshVertices[i].texCoords = { mesh.uvs[index].x, mesh.uvs[index].y };
+                m_meshVertices[i].color = sf::Color::White;
             }
+            
+            sf::RenderStates states;
+            states.texture = texture;
+            renderTexture.draw(m_meshVertices, states);
+            continue;
         }
-
-        sf::Sprite sfSprite(*texture);
         
-        // Calculate sprite's world transform
-        Transform spriteWorldTransform = calculateSpriteWorldTransform(sprite, animatedBones);
+        sf::Sprite sfSprite(*texture);
         
         // Set sprite origin to center for proper rotation
         sf::Vector2u textureSize = texture->getSize();
@@ -112,13 +535,13 @@ bool PNGSequenceExporter::renderFrame(float time, const ExportAnimation& animati
         
         // Center character in frame, apply zoom
         sfSprite.setPosition({
-            spriteWorldTransform.position.x * m_zoom + m_width * 0.5f,
-            spriteWorldTransform.position.y * m_zoom + m_height * 0.5f
+            spriteWorldTransform.position.x * m_frameZoom + m_frameOrigin.x,
+            spriteWorldTransform.position.y * m_frameZoom + m_frameOrigin.y
         });
         
         sfSprite.setScale({
-            spriteWorldTransform.scale.x * m_zoom,
-            spriteWorldTransform.scale.y * m_zoom
+            spriteWorldTransform.scale.x * m_frameZoom,
+            spriteWorldTransform.scale.y * m_frameZoom
         });
 
         sfSprite.setRotation(sf::degrees(spriteWorldTransform.rotation * 180.f / 3.14159265f));
@@ -126,11 +549,428 @@ bool PNGSequenceExporter::renderFrame(float time, const ExportAnimation& animati
         renderTexture.draw(sfSprite);
     }
 
-    // Finalize and save
+    // Finalize and read back
     renderTexture.display();
-    sf::Image image = renderTexture.getTexture().copyToImage();
+    image = renderTexture.getTexture().copyToImage();
+    return true;
+}
+
+void PNGSequenceExporter::poseFrame(float time, const ExportAnimation& animation) {
+    // Sample the animation and layer procedural motion, IK and constraints on top
+    m_pose.sampleAnimation(time);
+    applyProceduralChannels(time, animation.duration);
+    applyIKConstraints();
+    applyConstraints();
+
+    // World transforms, same hierarchy rules as the rig
+    m_pose.updateWorldTransforms();
     
-    return image.saveToFile(framePath);
+    // Secondary motion on top of the sampled pose
+    if (m_springSolver.getBoneCount() > 0) {
+        applySpringBones(time);
+        m_pose.updateWorldTransforms();
+    }
+}
+
+bool PNGSequenceExporter::updateDrawKey(const std::vector<ExportSprite>& sprites) {
+    // Textures, visibility, zoom and framing are fixed for the export, so only the
+    // transforms that place each drawn sprite can change between frames
+    m_previousDrawKey.swap(m_drawKey);
+    m_drawKey.clear();
+    auto append = [this](const Transform& transform) {
+        const float values[5] = { transform.position.x, transform.position.y, transform.rotation,
+                                  transform.scale.x, transform.scale.y };
+        m_drawKey.insert(m_drawKey.end(), values, values + 5);
+    };
+
+    for (size_t spriteIndex = 0; spriteIndex < sprites.size(); ++spriteIndex) {
+        if (!sprites[spriteIndex].isVisible) continue;
+        append(m_pose.getSpriteWorldTransform(static_cast<int>(spriteIndex)));
+        for (int bone : m_pose.getSpriteSkinBones(static_cast<int>(spriteIndex))) {
+            append(m_pose.getWorldTransform(bone));
+        }
+    }
+
+    // Bitwise, so only poses that would rasterise identically match
+    return m_drawKey.size() == m_previousDrawKey.size() &&
+           (m_drawKey.empty() || std::memcmp(m_drawKey.data(), m_previousDrawKey.data(), m_drawKey.size() * sizeof(float)) == 0);
+}
+
+std::string PNGSequenceExporter::setupScaledOutputs(const std::string& outputPath) {
+    closeScaledOutputs();
+    if (m_outputScales.empty()) return outputPath;
+
+    std::vector<float> scales;
+    for (float scale : m_outputScales) {
+        if (scale > 0.0f && std::find(scales.begin(), scales.end(), scale) == scales.end()) {
+            scales.push_back(scale);
+        }
+    }
+    if (scales.empty()) return outputPath;
+    std::sort(scales.begin(), scales.end(), std::greater<float>());
+
+    // Each scale in its own folder next to the output: <parent>/0.5x/<name>
+    const std::filesystem::path path(outputPath);
+    auto scaledPath = [&path](float scale) {
+        std::ostringstream folder;
+        folder << scale << "x";
+        return (path.parent_path() / folder.str() / path.filename()).string();
+    };
+
+    // The largest scale is rendered: everything that maps the world to pixels grows with it
+    const int baseWidth = m_frameWidth;
+    const int baseHeight = m_frameHeight;
+    const float mainScale = scales.front();
+    m_frameWidth = std::max(1, static_cast<int>(std::lround(baseWidth * mainScale)));
+    m_frameHeight = std::max(1, static_cast<int>(std::lround(baseHeight * mainScale)));
+    m_frameOrigin = m_frameOrigin * mainScale;
+    m_frameZoom *= mainScale;
+    if (scales.size() == 1) return outputPath;
+
+    std::error_code error;
+    std::filesystem::path spoolDirectory = std::filesystem::temp_directory_path(error) / "Riggle";
+    std::filesystem::create_directories(spoolDirectory, error);
+    const auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+
+    m_scaledOutputs.resize(scales.size() - 1);
+    for (size_t i = 1; i < scales.size(); ++i) {
+        ScaledOutput& output = m_scaledOutputs[i - 1];
+        output.width = std::max(1, static_cast<int>(std::lround(baseWidth * scales[i])));
+        output.height = std::max(1, static_cast<int>(std::lround(baseHeight * scales[i])));
+        output.outputPath = scaledPath(scales[i]);
+
+        std::ostringstream spoolName;
+        spoolName << "spool_" << stamp << "_" << i << ".tmp";
+        output.spoolPath = (spoolDirectory / spoolName.str()).string();
+        output.spool.open(output.spoolPath, std::ios::binary | std::ios::trunc);
+    }
+    return scaledPath(mainScale);
+}
+
+bool PNGSequenceExporter::encodeOutputs(FrameEncoder& encoder, const sf::Image& image,
+                                        std::vector<std::vector<std::uint8_t>>& outputs) {
+    if (!encodeFrame(encoder, image, outputs[0])) return false;
+
+    // Box-filter the rendered frame down to each smaller scale
+    std::vector<std::uint8_t> pixels;
+    for (size_t i = 0; i < m_scaledOutputs.size(); ++i) {
+        const ScaledOutput& output = m_scaledOutputs[i];
+        downsampleImage(image.getPixelsPtr(), image.getSize().x, image.getSize().y,
+                        output.width, output.height, pixels);
+        const sf::Image scaled({static_cast<unsigned>(output.width), static_cast<unsigned>(output.height)}, pixels.data());
+        if (!encodeFrame(encoder, scaled, outputs[i + 1])) return false;
+    }
+    return true;
+}
+
+bool PNGSequenceExporter::writeOutputs(int frame, const std::vector<std::vector<std::uint8_t>>& outputs) {
+    if (!writeFrame(frame, outputs[0])) return false;
+
+    // Smaller scales go to their spool as [size][bytes] until the main output is done
+    for (size_t i = 0; i < m_scaledOutputs.size(); ++i) {
+        std::ofstream& spool = m_scaledOutputs[i].spool;
+        const std::vector<std::uint8_t>& bytes = outputs[i + 1];
+        const std::uint64_t size = bytes.size();
+        spool.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        spool.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        if (!spool) return false;
+    }
+    return true;
+}
+
+bool PNGSequenceExporter::writeScaledOutputs(int frameCount) {
+    // The output stages hold one file at a time, so each scale is written out in turn
+    const int mainWidth = m_frameWidth;
+    const int mainHeight = m_frameHeight;
+    bool written = true;
+    std::vector<std::uint8_t> bytes;
+    for (ScaledOutput& output : m_scaledOutputs) {
+        output.spool.close();
+        std::ifstream spool(output.spoolPath, std::ios::binary);
+        if (!spool) {
+            m_lastError = "Failed to read back frames for " + output.outputPath;
+            written = false;
+            break;
+        }
+
+        m_frameWidth = output.width;
+        m_frameHeight = output.height;
+        if (!beginOutput(output.outputPath, frameCount)) {
+            written = false;
+            break;
+        }
+
+        bool complete = true;
+        for (int frame = 0; frame < frameCount && complete; ++frame) {
+            std::uint64_t size = 0;
+            complete = static_cast<bool>(spool.read(reinterpret_cast<char*>(&size), sizeof(size)));
+            if (complete) {
+                bytes.resize(static_cast<size_t>(size));
+                complete = spool.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(size)) &&
+                           writeFrame(frame, bytes);
+            }
+        }
+        if (!endOutput(complete) || !complete) {
+            m_lastError = "Failed to write " + output.outputPath;
+            written = false;
+            break;
+        }
+        std::cout << "Wrote " << output.width << "x" << output.height << " output: " << output.outputPath << std::endl;
+    }
+
+    m_frameWidth = mainWidth;
+    m_frameHeight = mainHeight;
+    return written;
+}
+
+void PNGSequenceExporter::closeScaledOutputs() {
+    for (ScaledOutput& output : m_scaledOutputs) {
+        output.spool.close();
+        std::error_code error;
+        std::filesystem::remove(output.spoolPath, error);
+    }
+    m_scaledOutputs.clear();
+}
+
+bool PNGSequenceExporter::loadCachedFrame(std::vector<std::vector<std::uint8_t>>& outputs) const {
+    // A hit needs every scale; variant 0 is the main output
+    outputs.resize(m_scaledOutputs.size() + 1);
+    for (size_t i = 0; i < outputs.size(); ++i) {
+        if (!m_frameCache.load(m_drawKey, static_cast<int>(i), outputs[i])) return false;
+    }
+    return true;
+}
+
+void PNGSequenceExporter::storeCachedFrame(const std::vector<float>& drawKey,
+                                           const std::vector<std::vector<std::uint8_t>>& outputs, int frame) const {
+    for (size_t i = 0; i < outputs.size(); ++i) {
+        m_frameCache.store(drawKey, static_cast<int>(i), outputs[i], frame);
+    }
+}
+
+std::uint64_t PNGSequenceExporter::computeFrameCacheHash(const std::vector<ExportSprite>& sprites) const {
+    // Output format and how frames are framed, sampled and encoded; the frame rate
+    // only changes which poses are sampled, and those are in the draw key
+    std::uint64_t hash = FrameCache::hash(getFormatName());
+    const std::int32_t settings[8] = {
+        static_cast<std::int32_t>(m_encoderSettings.format), m_encoderSettings.compressionLevel,
+        static_cast<std::int32_t>(m_encoderSettings.filter), m_frameWidth, m_frameHeight,
+        static_cast<std::int32_t>(m_backend), m_smoothTextures ? 1 : 0,
+        static_cast<std::int32_t>(m_backgroundColor.toInteger())
+    };
+    const float framing[3] = { m_frameOrigin.x, m_frameOrigin.y, m_frameZoom };
+    hash = FrameCache::hash(settings, sizeof(settings), hash);
+    hash = FrameCache::hash(framing, sizeof(framing), hash);
+    for (const ScaledOutput& output : m_scaledOutputs) {
+        const std::int32_t scaledSize[2] = { output.width, output.height };
+        hash = FrameCache::hash(scaledSize, sizeof(scaledSize), hash);
+    }
+
+    // Drawn sprites: texture files (by path, size and modification time) and mesh/skin data
+    for (const ExportSprite& sprite : sprites) {
+        if (!sprite.isVisible) continue;
+        hash = FrameCache::hash(sprite.texturePath + '\n', hash);
+
+        std::error_code error;
+        const std::uint64_t textureSize = std::filesystem::file_size(sprite.texturePath, error);
+        const std::int64_t textureTime = error ? 0 : static_cast<std::int64_t>(
+            std::filesystem::last_write_time(sprite.texturePath, error).time_since_epoch().count());
+        hash = FrameCache::hash(&textureSize, sizeof(textureSize), hash);
+        hash = FrameCache::hash(&textureTime, sizeof(textureTime), hash);
+
+        const SpriteMesh& mesh = sprite.mesh;
+        hash = FrameCache::hash(mesh.vertices.data(), mesh.vertices.size() * sizeof(Vector2), hash);
+        hash = FrameCache::hash(mesh.uvs.data(), mesh.uvs.size() * sizeof(Vector2), hash);
+        hash = FrameCache::hash(mesh.indices.data(), mesh.indices.size() * sizeof(unsigned int), hash);
+        hash = FrameCache::hash(sprite.skinBindVertices.data(), sprite.skinBindVertices.size() * sizeof(Vector2), hash);
+        hash = FrameCache::hash(sprite.skinBindPoses.data(), sprite.skinBindPoses.size() * sizeof(Transform), hash);
+        hash = FrameCache::hash(sprite.skinWeights.data(), sprite.skinWeights.size() * sizeof(VertexWeights), hash);
+    }
+    return hash;
+}
+
+void PNGSequenceExporter::setupFrameBounds(const ExportAnimation& animation, const std::vector<ExportSprite>& sprites,
+                                           const std::vector<ExportBone>& bones, int totalFrames) {
+    // Preset canvas with the character centred
+    m_frameWidth = m_width;
+    m_frameHeight = m_height;
+    m_frameOrigin = Vector2(m_width * 0.5f, m_height * 0.5f);
+    m_frameZoom = m_zoom;
+    if (!m_autoCrop) return;
+
+    // World-space union of every frame that will be exported
+    float minX = std::numeric_limits<float>::max(), minY = minX;
+    float maxX = std::numeric_limits<float>::lowest(), maxY = maxX;
+    auto include = [&](float x, float y) {
+        minX = std::min(minX, x);
+        minY = std::min(minY, y);
+        maxX = std::max(maxX, x);
+        maxY = std::max(maxY, y);
+    };
+
+    const float frameTime = 1.0f / m_frameRate;
+    for (int frame = 0; frame <= totalFrames; ++frame) {
+        poseFrame(frame * frameTime, animation);
+
+        for (int bone = 0; bone < m_pose.getBoneCount(); ++bone) {
+            const Transform& world = m_pose.getWorldTransform(bone);
+            const float length = m_pose.getBoneLength(bone);
+            include(world.position.x, world.position.y);
+            include(world.position.x + length * std::cos(world.rotation) * world.scale.x,
+                    world.position.y + length * std::sin(world.rotation) * world.scale.y);
+        }
+
+        for (size_t spriteIndex = 0; spriteIndex < sprites.size(); ++spriteIndex) {
+            const ExportSprite& sprite = sprites[spriteIndex];
+            if (!sprite.isVisible) continue;
+
+            Transform spriteWorldTransform = m_pose.getSpriteWorldTransform(static_cast<int>(spriteIndex));
+            if (!sprite.mesh.isEmpty()) {
+                if (!deformSpriteMesh(sprite, static_cast<int>(spriteIndex), spriteWorldTransform)) continue;
+                for (size_t i = 0; i < m_deformX.size(); ++i) {
+                    include(m_deformX[i], m_deformY[i]);
+                }
+                continue;
+            }
+
+            // Texture size from whichever cache the backend renders with
+            float halfWidth = 0.0f, halfHeight = 0.0f;
+            if (m_backend == RenderBackend::Software) {
+                const RasterImage* texture = getRasterTexture(sprite.texturePath);
+                if (!texture) continue;
+                halfWidth = texture->width * 0.5f;
+                halfHeight = texture->height * 0.5f;
+            } else {
+                const sf::Texture* texture = getTexture(sprite.texturePath);
+                if (!texture) continue;
+                halfWidth = texture->getSize().x * 0.5f;
+                halfHeight = texture->getSize().y * 0.5f;
+            }
+
+            // Quad corners, as drawn by both backends
+            const float c = std::cos(spriteWorldTransform.rotation);
+            const float s = std::sin(spriteWorldTransform.rotation);
+            for (int corner = 0; corner < 4; ++corner) {
+                float x = (corner == 1 || corner == 2 ? halfWidth : -halfWidth) * spriteWorldTransform.scale.x;
+                float y = (corner >= 2 ? halfHeight : -halfHeight) * spriteWorldTransform.scale.y;
+                include(spriteWorldTransform.position.x + c * x - s * y,
+                        spriteWorldTransform.position.y + s * x + c * y);
+            }
+        }
+    }
+
+    // The springs were stepped through the whole animation; restart them for the real pass
+    setupSpringBones(bones);
+    if (minX > maxX) return;  // Nothing to measure, keep the preset
+
+    // Whole-pixel origin so cropped frames sample exactly like the full canvas.
+    // right/bottom are the last pixel column/row kept (inclusive, so edge pixels touched by
+    // filtering survive a padding of 0); sizes are rounded up to even for 4:2:0 video encoders
+    const int padding = std::max(0, m_autoCropPadding);
+    const int left = static_cast<int>(std::floor(minX * m_zoom)) - padding;
+    const int top = static_cast<int>(std::floor(minY * m_zoom)) - padding;
+    const int right = static_cast<int>(std::ceil(maxX * m_zoom)) + padding;
+    const int bottom = static_cast<int>(std::ceil(maxY * m_zoom)) + padding;
+    const int columns = right - left + 1;
+    const int rows = bottom - top + 1;
+    m_frameWidth = std::max(2, (columns + 1) & ~1);
+    m_frameHeight = std::max(2, (rows + 1) & ~1);
+    m_frameOrigin = Vector2(static_cast<float>(-left), static_cast<float>(-top));
+
+    std::cout << "Auto-crop: " << m_frameWidth << "x" << m_frameHeight << " (preset "
+              << m_width << "x" << m_height << ")" << std::endl;
+}
+
+sf::Texture* PNGSequenceExporter::getTexture(const std::string& path) {
+    auto it = m_textureCache.find(path);
+    if (it != m_textureCache.end()) {
+        return &it->second;
+    }
+
+    // Load and cache texture
+    sf::Texture newTexture;
+    if (!newTexture.loadFromFile(path)) {
+        std::cout << "Warning: Failed to load texture: " << path << std::endl;
+        return nullptr;
+    }
+    newTexture.setSmooth(m_smoothTextures);
+    return &(m_textureCache[path] = std::move(newTexture));
+}
+
+bool PNGSequenceExporter::rasterizeFrame(const std::vector<ExportSprite>& sprites, sf::Image& image) {
+    m_rasterizer.begin(m_frameWidth, m_frameHeight, m_backgroundColor.r, m_backgroundColor.g,
+                       m_backgroundColor.b, m_backgroundColor.a);
+    const RasterFilter filter = m_smoothTextures ? RasterFilter::Bilinear : RasterFilter::Nearest;
+    
+    // Same geometry as the SFML path, queued in the same draw order
+    for (size_t spriteIndex = 0; spriteIndex < sprites.size(); ++spriteIndex) {
+        const ExportSprite& sprite = sprites[spriteIndex];
+        if (!sprite.isVisible) continue;
+        
+        const RasterImage* texture = getRasterTexture(sprite.texturePath);
+        if (!texture) continue;
+        
+        Transform spriteWorldTransform = m_pose.getSpriteWorldTransform(static_cast<int>(spriteIndex));
+        
+        if (!sprite.mesh.isEmpty()) {
+            if (!deformSpriteMesh(sprite, static_cast<int>(spriteIndex), spriteWorldTransform)) continue;
+            
+            const auto& mesh = sprite.mesh;
+            m_rasterVertices.resize(mesh.indices.size());
+            for (size_t i = 0; i < mesh.indices.size(); ++i) {
+                unsigned int index = mesh.indices[i];
+                m_rasterVertices[i].position = Vector2(m_deformX[index] * m_frameZoom + m_frameOrigin.x,
+                                                       m_deformY[index] * m_frameZoom + m_frameOrigin.y);
+                m_rasterVertices[i].uv = mesh.uvs[index];
+            }
+            m_rasterizer.drawTriangles(m_rasterVertices, *texture, filter);
+            continue;
+        }
+        
+        // sf::Sprite with a centred origin: position + rotate(scale * corner)
+        const float halfWidth = texture->width * 0.5f;
+        const float halfHeight = texture->height * 0.5f;
+        const float scaleX = spriteWorldTransform.scale.x * m_frameZoom;
+        const float scaleY = spriteWorldTransform.scale.y * m_frameZoom;
+        const float c = std::cos(spriteWorldTransform.rotation);
+        const float s = std::sin(spriteWorldTransform.rotation);
+        const Vector2 center(spriteWorldTransform.position.x * m_frameZoom + m_frameOrigin.x,
+                             spriteWorldTransform.position.y * m_frameZoom + m_frameOrigin.y);
+        const Vector2 local[4] = {
+            {-halfWidth, -halfHeight}, {halfWidth, -halfHeight}, {halfWidth, halfHeight}, {-halfWidth, halfHeight}
+        };
+        Vector2 corners[4];
+        for (int i = 0; i < 4; ++i) {
+            float x = local[i].x * scaleX;
+            float y = local[i].y * scaleY;
+            corners[i] = Vector2(center.x + c * x - s * y, center.y + s * x + c * y);
+        }
+        m_rasterizer.drawQuad(corners, *texture, filter);
+    }
+    
+    m_rasterizer.finish();
+    const RasterImage& result = m_rasterizer.getImage();
+    image = sf::Image({static_cast<unsigned>(result.width), static_cast<unsigned>(result.height)}, result.pixels.data());
+    return true;
+}
+
+const RasterImage* PNGSequenceExporter::getRasterTexture(const std::string& path) {
+    auto it = m_rasterTextureCache.find(path);
+    if (it == m_rasterTextureCache.end()) {
+        // sf::Image decodes on the CPU, no context needed; failures are cached empty so we warn once
+        RasterImage& texture = m_rasterTextureCache[path];
+        sf::Image source;
+        if (source.loadFromFile(path)) {
+            const sf::Vector2u size = source.getSize();
+            texture.width = static_cast<int>(size.x);
+            texture.height = static_cast<int>(size.y);
+            texture.pixels.assign(source.getPixelsPtr(), source.getPixelsPtr() + static_cast<size_t>(size.x) * size.y * 4);
+        } else {
+            std::cout << "Warning: Failed to load texture: " << path << std::endl;
+        }
+        it = m_rasterTextureCache.find(path);
+    }
+    return it->second.isEmpty() ? nullptr : &it->second;
 }
 
 void PNGSequenceExporter::updateResolution() {
@@ -160,187 +1000,246 @@ void PNGSequenceExporter::updateResolution() {
             m_height = baseHeight;
             break;
     }
+    m_frameWidth = m_width;
+    m_frameHeight = m_height;
 }
 
-void PNGSequenceExporter::applyAnimationToBones(std::vector<ExportBone>& animatedBones, 
-                                                const ExportAnimation& animation, float time) {
-    // Apply animation transforms to each bone - exactly like Animation::applyAtTime
-    for (auto& bone : animatedBones) {
-        // Find the bone's track in the animation
-        bool foundTrack = false;
-        for (const auto& track : animation.tracks) {
-            if (track.boneName == bone.name) {
-                // Get interpolated transform at current time
-                Transform animatedTransform = interpolateTransform(track.keyframes, time);
-                bone.transform = animatedTransform; // This sets the LOCAL transform
-                foundTrack = true;
-                break;
-            }
-        }
-        
-        // If no track found, keep the original transform (rest pose)
-        if (!foundTrack) {
-            // bone.transform already contains the rest pose
+void PNGSequenceExporter::setupProceduralChannels(const std::vector<ExportBone>& bones) {
+    m_proceduralChannels.clear();
+    
+    // Bones come parent-first, matching the channel system's flat setup
+    for (int i = 0; i < m_pose.getBoneCount(); ++i) {
+        m_proceduralChannels.addBone(m_pose.getParent(i));
+    }
+    
+    for (size_t i = 0; i < bones.size(); ++i) {
+        for (const auto& channel : bones[i].proceduralChannels) {
+            m_proceduralChannels.addChannel(channel, static_cast<int>(i), m_pose.findBone(channel.sourceName));
         }
     }
+    m_proceduralChannels.finalize();
 }
 
-void PNGSequenceExporter::calculateAllWorldTransforms(std::vector<ExportBone>& bones) {
-    // First, mark all world transforms as needing calculation
-    std::map<std::string, Transform> worldTransforms;
+void PNGSequenceExporter::applyProceduralChannels(float time, float duration) {
+    if (m_proceduralChannels.getDrivenBoneCount() == 0) return;
     
-    // Calculate world transforms for all bones, respecting hierarchy
-    for (auto& bone : bones) {
-        if (worldTransforms.find(bone.name) == worldTransforms.end()) {
-            worldTransforms[bone.name] = calculateBoneWorldTransform(bone, bones, worldTransforms);
-        }
+    // Same clock as the editor preview: animation time, delayed samples wrap around the loop
+    m_proceduralChannels.evaluate(time, duration, [this](int bone, float sampleTime, Transform& local) {
+        return m_pose.sampleTrack(bone, sampleTime, local);
+    });
+    
+    for (int i = 0; i < m_pose.getBoneCount(); ++i) {
+        Transform local = m_pose.getLocalTransform(i);
+        m_proceduralChannels.applyOffsets(i, local);
+        m_pose.setLocalTransform(i, local);
     }
+}
+
+void PNGSequenceExporter::setupIKConstraints(const std::vector<ExportBone>& bones) {
+    m_ikJobs.clear();
+    
+    auto depth = [this](int bone) {
+        int levels = 0;
+        for (int parent = m_pose.getParent(bone); parent >= 0; parent = m_pose.getParent(parent)) ++levels;
+        return levels;
+    };
     
-    // Store calculated world transforms back to bones
-    for (auto& bone : bones) {
-        if (worldTransforms.find(bone.name) != worldTransforms.end()) {
-            bone.worldTransform = worldTransforms[bone.name];
+    for (size_t i = 0; i < bones.size(); ++i) {
+        for (const auto& constraint : bones[i].ikConstraints) {
+            if (!constraint.enabled) continue;
+            
+            // The constraint's own end effector first, then any extra ones
+            IKJob job;
+            std::vector<int> effectors(1, static_cast<int>(i));
+            job.targetBones.push_back(m_pose.findBone(constraint.targetBone));
+            job.targetPositions.push_back(constraint.targetPosition);
+            job.weights.push_back(1.0f);
+            bool resolved = constraint.targetBone.empty() || job.targetBones[0] >= 0;
+            for (const auto& extra : constraint.extraEffectors) {
+                int target = m_pose.findBone(extra.targetBone);
+                effectors.push_back(m_pose.findBone(extra.endEffector));
+                job.targetBones.push_back(target);
+                job.targetPositions.push_back(extra.targetPosition);
+                job.weights.push_back(extra.weight);
+                resolved = resolved && effectors.back() >= 0 && (extra.targetBone.empty() || target >= 0);
+            }
+            resolved = resolved && effectors.size() <= static_cast<size_t>(IKSolver::MaxDLSEffectors);
+            
+            // Each effector walks up chainLength bones; shared bones are kept once
+            for (size_t e = 0; e < effectors.size() && resolved; ++e) {
+                int length = 0;
+                for (int bone = effectors[e]; bone >= 0 && length < constraint.chainLength; bone = m_pose.getParent(bone)) {
+                    if (std::find(job.chain.begin(), job.chain.end(), bone) == job.chain.end()) job.chain.push_back(bone);
+                    ++length;
+                }
+                resolved = length == constraint.chainLength;
+            }
+            if (!resolved || job.chain.size() < 2 || job.chain.size() > static_cast<size_t>(IKSolver::MaxDLSJoints)) {
+                std::cout << "Skipping IK constraint on " << bones[i].name << ": chain or target not found" << std::endl;
+                continue;
+            }
+            
+            // Shallower bones first keeps every parent ahead of its children
+            std::stable_sort(job.chain.begin(), job.chain.end(), [&depth](int a, int b) { return depth(a) < depth(b); });
+            for (size_t j = 0; j < job.chain.size(); ++j) {
+                auto parent = std::find(job.chain.begin(), job.chain.end(), m_pose.getParent(job.chain[j]));
+                job.parents.push_back(parent == job.chain.end() ? -1 : static_cast<int>(parent - job.chain.begin()));
+                job.limits.push_back(bones[job.chain[j]].rotationLimits);
+            }
+            for (int effector : effectors) {
+                job.effectorJoints.push_back(static_cast<int>(std::find(job.chain.begin(), job.chain.end(), effector) - job.chain.begin()));
+            }
+            job.settings = constraint.settings;
+            m_ikJobs.push_back(job);
         }
     }
 }
 
-Transform PNGSequenceExporter::calculateBoneWorldTransform(const ExportBone& bone, 
-                                                          const std::vector<ExportBone>& bones,
-                                                          std::map<std::string, Transform>& worldTransforms) {
-    // If already calculated, return it
-    if (worldTransforms.find(bone.name) != worldTransforms.end()) {
-        return worldTransforms[bone.name];
+void PNGSequenceExporter::applyIKConstraints() {
+    for (const auto& job : m_ikJobs) {
+        // Each solve sees the result of the ones before it, same as the live rig
+        m_pose.updateWorldTransforms();
+        
+        m_ikLocals.clear();
+        m_ikParentWorlds.assign(job.chain.size(), Transform());
+        for (size_t j = 0; j < job.chain.size(); ++j) {
+            Transform local = m_pose.getLocalTransform(job.chain[j]);
+            local.length = m_pose.getBoneLength(job.chain[j]);
+            m_ikLocals.push_back(local);
+            
+            int parent = m_pose.getParent(job.chain[j]);
+            if (job.parents[j] < 0 && parent >= 0) m_ikParentWorlds[j] = m_pose.getWorldTransform(parent);
+        }
+        
+        m_ikTargets.clear();
+        for (size_t e = 0; e < job.effectorJoints.size(); ++e) {
+            int target = job.targetBones[e];
+            m_ikTargets.push_back(target >= 0 ? m_pose.getWorldTransform(target).position : job.targetPositions[e]);
+        }
+        
+        m_ikWorkspace.loadTransforms(job.parents, m_ikLocals, m_ikParentWorlds, job.limits);
+        if (job.effectorJoints.size() > 1) {
+            m_ikSolver.solveWorkspaceDLS(m_ikWorkspace, job.effectorJoints, m_ikTargets, job.weights, job.settings);
+        } else {
+            m_ikSolver.solveWorkspace(m_ikWorkspace, m_ikTargets[0], job.settings);
+        }
+        
+        for (size_t j = 0; j < job.chain.size(); ++j) {
+            Transform local = m_pose.getLocalTransform(job.chain[j]);
+            local.rotation = m_ikWorkspace.getLocalTransform(j).rotation;
+            m_pose.setLocalTransform(job.chain[j], local);
+        }
     }
+}
+
+void PNGSequenceExporter::setupConstraints(const std::vector<ExportBone>& bones) {
+    m_constraints.clear();
     
-    Transform worldTransform = bone.transform; // Start with local transform
+    // Bones come parent-first, matching the constraint system's flat setup
+    for (int i = 0; i < m_pose.getBoneCount(); ++i) {
+        m_constraints.addBone(m_pose.getParent(i));
+    }
     
-    // If bone has a parent, apply parent's world transform
-    if (!bone.parentName.empty()) {
-        const ExportBone* parent = findBone(bones, bone.parentName);
-        if (parent) {
-            // Recursively calculate parent's world transform
-            Transform parentWorldTransform = calculateBoneWorldTransform(*parent, bones, worldTransforms);
-            
-            // Apply parent transform to this bone's local transform
-            worldTransform = combineTransforms(parentWorldTransform, bone.transform);
+    for (size_t i = 0; i < bones.size(); ++i) {
+        for (const auto& constraint : bones[i].constraints) {
+            m_constraints.addConstraint(constraint, static_cast<int>(i), m_pose.findBone(constraint.targetName));
         }
     }
     
-    // Cache the result
-    worldTransforms[bone.name] = worldTransform;
-    return worldTransform;
+    m_constraints.finalize();
 }
 
-Transform PNGSequenceExporter::combineTransforms(const Transform& parent, const Transform& local) {
-    Transform result;
-    
-    // Rotate local position by parent rotation
-    float cosRot = std::cos(parent.rotation);
-    float sinRot = std::sin(parent.rotation);
+void PNGSequenceExporter::applyConstraints() {
+    if (m_constraints.getScheduledBoneCount() == 0) return;
     
-    Vector2 rotatedPos;
-    rotatedPos.x = local.position.x * cosRot - local.position.y * sinRot;
-    rotatedPos.y = local.position.x * sinRot + local.position.y * cosRot;
+    for (int i = 0; i < m_pose.getBoneCount(); ++i) {
+        Transform local = m_pose.getLocalTransform(i);
+        local.length = m_pose.getBoneLength(i);
+        m_constraints.setLocalTransform(i, local);
+    }
     
-    // Apply parent scale and position
-    result.position.x = parent.position.x + rotatedPos.x * parent.scale.x;
-    result.position.y = parent.position.y + rotatedPos.y * parent.scale.y;
-    result.rotation = parent.rotation + local.rotation;
-    result.scale.x = parent.scale.x * local.scale.x;
-    result.scale.y = parent.scale.y * local.scale.y;
-    result.length = local.length; // Length doesn't inherit
+    m_constraints.evaluate();
     
-    return result;
+    for (int i = 0; i < m_pose.getBoneCount(); ++i) {
+        if (m_constraints.isConstrained(i)) {
+            m_pose.setLocalTransform(i, m_constraints.getConstrainedTransform(i));
+        }
+    }
 }
 
-Transform PNGSequenceExporter::calculateSpriteWorldTransform(const ExportSprite& sprite, 
-                                                            const std::vector<ExportBone>& animatedBones) {
-    Transform spriteWorldTransform = sprite.transform; // Start with sprite's local transform
+void PNGSequenceExporter::setupSpringBones(const std::vector<ExportBone>& bones) {
+    m_springSolver.clear();
+    m_springBones.clear();
+    m_springAnchors.clear();
+    m_springTime = 0.0f;
     
-    // If sprite is bound to a bone, apply bone's world transform with binding
-    if (!sprite.boundBoneName.empty()) {
-        const ExportBone* boundBone = findBone(animatedBones, sprite.boundBoneName);
-        if (boundBone) {
-            // Get bone's world transform (should already be calculated)
-            Transform boneWorldTransform = boundBone->worldTransform;
-            
-            // Apply binding offset and rotation
-            float totalRotation = boneWorldTransform.rotation + sprite.bindRotation;
-            float cosRot = std::cos(totalRotation);
-            float sinRot = std::sin(totalRotation);
-            
-            // Rotate bind offset by bone's world rotation
-            Vector2 rotatedOffset;
-            rotatedOffset.x = sprite.bindOffset.x * std::cos(boneWorldTransform.rotation) - 
-                             sprite.bindOffset.y * std::sin(boneWorldTransform.rotation);
-            rotatedOffset.y = sprite.bindOffset.x * std::sin(boneWorldTransform.rotation) + 
-                             sprite.bindOffset.y * std::cos(boneWorldTransform.rotation);
-            
-            // Apply bone world transform with binding
-            spriteWorldTransform.position.x = boneWorldTransform.position.x + rotatedOffset.x * boneWorldTransform.scale.x;
-            spriteWorldTransform.position.y = boneWorldTransform.position.y + rotatedOffset.y * boneWorldTransform.scale.y;
-            spriteWorldTransform.rotation = totalRotation;
-            spriteWorldTransform.scale.x = sprite.transform.scale.x * boneWorldTransform.scale.x;
-            spriteWorldTransform.scale.y = sprite.transform.scale.y * boneWorldTransform.scale.y;
-        }
+    // Bones come parent-first, so chain parents are always added before children
+    std::vector<int> springIndex(bones.size(), -1);
+    for (size_t i = 0; i < bones.size(); ++i) {
+        const ExportBone& bone = bones[i];
+        if (!bone.spring.enabled) continue;
+        
+        int parentBone = m_pose.getParent(static_cast<int>(i));
+        int parent = parentBone >= 0 ? springIndex[parentBone] : -1;
+        springIndex[i] = m_springSolver.addBone(parent, bone.spring);
+        m_springBones.push_back(static_cast<int>(i));
+        m_springAnchors.push_back(parent < 0 ? parentBone : -1);
     }
     
-    return spriteWorldTransform;
+    m_springSolver.finalize();
 }
 
-Transform PNGSequenceExporter::interpolateTransform(const std::vector<ExportKeyframe>& keyframes, float time) {
-    if (keyframes.empty()) {
-        return Transform();
-    }
-
-    if (keyframes.size() == 1 || time <= keyframes.front().time) {
-        return keyframes.front().transform;
+void PNGSequenceExporter::applySpringBones(float time) {
+    for (size_t i = 0; i < m_springBones.size(); ++i) {
+        int bone = m_springBones[i];
+        Transform local = m_pose.getLocalTransform(bone);
+        local.length = m_pose.getBoneLength(bone);
+        m_springSolver.setAnimatedPose(static_cast<int>(i), local);
+        
+        int anchor = m_springAnchors[i];
+        m_springSolver.setAnchor(static_cast<int>(i), anchor >= 0 ? m_pose.getWorldTransform(anchor) : Transform());
     }
-
-    if (time >= keyframes.back().time) {
-        return keyframes.back().transform;
+    
+    m_springSolver.step(time - m_springTime);
+    m_springTime = time;
+    
+    for (size_t i = 0; i < m_springBones.size(); ++i) {
+        Transform local = m_pose.getLocalTransform(m_springBones[i]);
+        local.rotation = m_springSolver.getLocalRotation(static_cast<int>(i));
+        m_pose.setLocalTransform(m_springBones[i], local);
     }
+}
 
-    // Find surrounding keyframes
-    for (size_t i = 0; i < keyframes.size() - 1; ++i) {
-        if (time >= keyframes[i].time && time <= keyframes[i + 1].time) {
-            const auto& k1 = keyframes[i];
-            const auto& k2 = keyframes[i + 1];
-            
-            float t = (time - k1.time) / (k2.time - k1.time);
-            
-            Transform result;
-            result.position.x = k1.transform.position.x + t * (k2.transform.position.x - k1.transform.position.x);
-            result.position.y = k1.transform.position.y + t * (k2.transform.position.y - k1.transform.position.y);
-            
-            // Shortest path rotation interpolation (same as your BoneTrack::interpolateTransforms)
-            float angleDiff = k2.transform.rotation - k1.transform.rotation;
-            const float PI = 3.14159f;
-            
-            // Normalize angle difference to [-π, π]
-            while (angleDiff > PI) angleDiff -= 2.0f * PI;
-            while (angleDiff < -PI) angleDiff += 2.0f * PI;
-            
-            result.rotation = k1.transform.rotation + angleDiff * t;
-            
-            result.scale.x = k1.transform.scale.x + t * (k2.transform.scale.x - k1.transform.scale.x);
-            result.scale.y = k1.transform.scale.y + t * (k2.transform.scale.y - k1.transform.scale.y);
-            result.length = k1.transform.length + t * (k2.transform.length - k1.transform.length);
-            
-            return result;
+bool PNGSequenceExporter::deformSpriteMesh(const ExportSprite& sprite, int spriteIndex,
+                                           const Transform& spriteWorldTransform) {
+    const auto& mesh = sprite.mesh;
+    const size_t count = mesh.getVertexCount();
+    m_deformX.resize(count);
+    m_deformY.resize(count);
+    
+    auto skinIt = m_skinCache.find(sprite.name);
+    if (skinIt == m_skinCache.end()) {
+        // Rigid mesh follows the sprite transform
+        Affine2 world = Affine2::fromTRS(spriteWorldTransform);
+        for (size_t i = 0; i < count; ++i) {
+            Vector2 p = world.apply(mesh.vertices[i]);
+            m_deformX[i] = p.x;
+            m_deformY[i] = p.y;
         }
+        return true;
+    }
+    
+    const SkinData& skin = skinIt->second;
+    const std::vector<int>& skinBones = m_pose.getSpriteSkinBones(spriteIndex);
+    if (skinBones.size() != sprite.skinBoneNames.size()) return false;
+    
+    m_skinMatrices.resize(skinBones.size());
+    for (size_t j = 0; j < skinBones.size(); ++j) {
+        m_skinMatrices[j] = Affine2::fromTransform(m_pose.getWorldTransform(skinBones[j])) * skin.inverseBindMatrices[j];
     }
-
-    return keyframes.back().transform;
-}
-
-const ExportBone* PNGSequenceExporter::findBone(const std::vector<ExportBone>& bones, const std::string& name) {
-    auto it = std::find_if(bones.begin(), bones.end(),
-        [&name](const ExportBone& bone) {
-            return bone.name == name;
-        });
     
-    return (it != bones.end()) ? &(*it) : nullptr;
+    skinVertices(skin, m_skinMatrices, m_deformX.data(), m_deformY.data());
+    return true;
 }
 
 bool PNGSequenceExporter::createDirectory(const std::string& path) {
@@ -0,0 +1,317 @@
+#include "Editor/Export/SpriteSheetExporter.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+
+// Same single-header packer ImGui uses for its font atlas; imgui_draw.cpp keeps its copy static too
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "imstb_rectpack.h"
+
+namespace Riggle {
+
+namespace {
+
+// Per-frame record passed from the encoder threads to the writer:
+// trimmed x, y, width, height (int32), pixel hash (uint64), then the trimmed RGBA rows
+const size_t FrameHeaderSize = 4 * sizeof(std::int32_t) + sizeof(std::uint64_t);
+
+std::string escapeJson(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            escaped += ' ';
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+} // namespace
+
+bool SpriteSheetExporter::beginOutput(const std::string& outputPath, int /*frameCount*/) {
+    // The metadata is written last, but open it now so a bad path fails before rendering
+    if (!openOutputFile(outputPath, m_file)) return false;
+    m_metadataPath = outputPath;
+    m_images.clear();
+    m_frames.clear();
+    m_imagesByHash.clear();
+    return true;
+}
+
+bool SpriteSheetExporter::encodeFrame(FrameEncoder& /*encoder*/, const sf::Image& image, std::vector<std::uint8_t>& bytes) {
+    const int width = static_cast<int>(image.getSize().x);
+    const int height = static_cast<int>(image.getSize().y);
+    const std::uint8_t* pixels = image.getPixelsPtr();
+
+    // Bounds of every pixel with any coverage
+    int minX = width, minY = height, maxX = -1, maxY = -1;
+    for (int y = 0; y < height; ++y) {
+        const std::uint8_t* row = pixels + static_cast<size_t>(y) * width * 4;
+        int first = 0;
+        while (first < width && row[first * 4 + 3] == 0) ++first;
+        if (first == width) continue;
+        int last = width - 1;
+        while (row[last * 4 + 3] == 0) --last;
+
+        minX = std::min(minX, first);
+        maxX = std::max(maxX, last);
+        if (minY == height) minY = y;
+        maxY = y;
+    }
+
+    std::int32_t rect[4] = { 0, 0, 0, 0 };
+    if (maxY >= 0) {
+        rect[0] = minX;
+        rect[1] = minY;
+        rect[2] = maxX - minX + 1;
+        rect[3] = maxY - minY + 1;
+    }
+
+    const size_t rowBytes = static_cast<size_t>(rect[2]) * 4;
+    bytes.resize(FrameHeaderSize + rowBytes * rect[3]);
+    std::uint8_t* trimmed = bytes.data() + FrameHeaderSize;
+    for (int y = 0; y < rect[3]; ++y) {
+        const std::uint8_t* source = pixels + (static_cast<size_t>(rect[1] + y) * width + rect[0]) * 4;
+        std::memcpy(trimmed + y * rowBytes, source, rowBytes);
+    }
+
+    // A match is confirmed byte for byte before frames are merged
+    std::uint64_t hash = FrameCache::hash(rect + 2, 2 * sizeof(std::int32_t));
+    hash = FrameCache::hash(trimmed, rowBytes * rect[3], hash);
+
+    std::memcpy(bytes.data(), rect, sizeof(rect));
+    std::memcpy(bytes.data() + sizeof(rect), &hash, sizeof(hash));
+    return true;
+}
+
+bool SpriteSheetExporter::writeFrame(int frame, const std::vector<std::uint8_t>& bytes) {
+    if (bytes.size() < FrameHeaderSize) return false;
+
+    std::int32_t rect[4];
+    std::uint64_t hash;
+    std::memcpy(rect, bytes.data(), sizeof(rect));
+    std::memcpy(&hash, bytes.data() + sizeof(rect), sizeof(hash));
+    if (bytes.size() != FrameHeaderSize + static_cast<size_t>(rect[2]) * rect[3] * 4) return false;
+
+    int image = findOrAddImage(hash, rect[2], rect[3], bytes.data() + FrameHeaderSize);
+
+    // Held poses become one longer frame
+    if (!m_frames.empty()) {
+        SheetFrame& previous = m_frames.back();
+        if (previous.image == image && previous.offsetX == rect[0] && previous.offsetY == rect[1]) {
+            previous.lastFrame = frame;
+            return true;
+        }
+    }
+
+    SheetFrame entry;
+    entry.image = image;
+    entry.offsetX = rect[0];
+    entry.offsetY = rect[1];
+    entry.firstFrame = frame;
+    entry.lastFrame = frame;
+    m_frames.push_back(entry);
+    return true;
+}
+
+int SpriteSheetExporter::findOrAddImage(std::uint64_t hash, int width, int height, const std::uint8_t* pixels) {
+    const size_t size = static_cast<size_t>(width) * height * 4;
+    auto range = m_imagesByHash.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        const SheetImage& existing = m_images[it->second];
+        if (existing.width == width && existing.height == height &&
+            std::memcmp(existing.pixels.data(), pixels, size) == 0) {
+            return it->second;
+        }
+    }
+
+    SheetImage image;
+    image.width = width;
+    image.height = height;
+    image.pixels.assign(pixels, pixels + size);
+    m_images.push_back(std::move(image));
+
+    int index = static_cast<int>(m_images.size()) - 1;
+    m_imagesByHash.emplace(hash, index);
+    return index;
+}
+
+bool SpriteSheetExporter::endOutput(bool completed) {
+    if (!completed) {
+        m_file.close();
+        m_images.clear();
+        m_imagesByHash.clear();
+        return true;
+    }
+
+    std::vector<std::pair<int, int>> pageSizes;
+    std::vector<std::string> pageFiles;
+    bool written = packImages(pageSizes) &&
+                   writePages(pageSizes, pageFiles) &&
+                   writeMetadata(pageSizes, pageFiles);
+
+    if (written) {
+        std::cout << "Sprite sheet: " << m_frames.size() << " frames, " << m_images.size()
+                  << " unique images on " << pageSizes.size() << " page(s)" << std::endl;
+    }
+
+    m_images.clear();
+    m_imagesByHash.clear();
+    return written;
+}
+
+bool SpriteSheetExporter::packImages(std::vector<std::pair<int, int>>& pageSizes) {
+    const int padding = std::max(0, m_padding);
+
+    // Every image has to fit on an empty page, so grow the page for oversized frames
+    int pageSize = std::max(1, m_maxPageSize);
+    std::vector<stbrp_rect> pending;
+    for (size_t i = 0; i < m_images.size(); ++i) {
+        const SheetImage& image = m_images[i];
+        if (image.width == 0 || image.height == 0) continue;  // Fully transparent frame
+
+        stbrp_rect rect = {};
+        rect.id = static_cast<int>(i);
+        rect.w = image.width + padding;
+        rect.h = image.height + padding;
+        pending.push_back(rect);
+        pageSize = std::max(pageSize, std::max(rect.w, rect.h));
+    }
+
+    std::vector<stbrp_node> nodes(pageSize);
+    stbrp_context context;
+
+    // Fill a page, carry whatever didn't fit over to the next one
+    while (!pending.empty()) {
+        const int page = static_cast<int>(pageSizes.size());
+        stbrp_init_target(&context, pageSize, pageSize, nodes.data(), static_cast<int>(nodes.size()));
+        stbrp_setup_heuristic(&context, STBRP_HEURISTIC_Skyline_BF_sortHeight);
+        stbrp_pack_rects(&context, pending.data(), static_cast<int>(pending.size()));
+
+        int usedWidth = 0;
+        int usedHeight = 0;
+        std::vector<stbrp_rect> remaining;
+        for (const stbrp_rect& rect : pending) {
+            if (!rect.was_packed) {
+                remaining.push_back(rect);
+                continue;
+            }
+            SheetImage& image = m_images[rect.id];
+            image.page = page;
+            image.x = rect.x;
+            image.y = rect.y;
+            usedWidth = std::max(usedWidth, rect.x + image.width);
+            usedHeight = std::max(usedHeight, rect.y + image.height);
+        }
+
+        if (remaining.size() == pending.size()) {
+            m_lastError = "Failed to pack sprite sheet images";
+            return false;
+        }
+        pageSizes.emplace_back(usedWidth, usedHeight);
+        pending.swap(remaining);
+    }
+
+    // Keep one (tiny) page so the metadata always points at an image
+    if (pageSizes.empty()) {
+        pageSizes.emplace_back(1, 1);
+    }
+    return true;
+}
+
+bool SpriteSheetExporter::writePages(const std::vector<std::pair<int, int>>& pageSizes, std::vector<std::string>& pageFiles) {
+    // Atlas pages are always PNG; compression follows the export settings
+    FrameEncoderSettings settings = getEncoderSettings();
+    settings.format = FrameFormat::PNG;
+    FrameEncoder encoder(settings);
+
+    const std::filesystem::path metadataPath(m_metadataPath);
+    const std::string stem = metadataPath.stem().string();
+
+    std::vector<std::uint8_t> pixels;
+    std::vector<std::uint8_t> encoded;
+    for (size_t page = 0; page < pageSizes.size(); ++page) {
+        const int pageWidth = pageSizes[page].first;
+        const int pageHeight = pageSizes[page].second;
+        pixels.assign(static_cast<size_t>(pageWidth) * pageHeight * 4, 0);
+
+        for (const SheetImage& image : m_images) {
+            if (image.page != static_cast<int>(page) || image.width == 0 || image.height == 0) continue;
+            const size_t rowBytes = static_cast<size_t>(image.width) * 4;
+            for (int y = 0; y < image.height; ++y) {
+                std::memcpy(pixels.data() + (static_cast<size_t>(image.y + y) * pageWidth + image.x) * 4,
+                            image.pixels.data() + y * rowBytes, rowBytes);
+            }
+        }
+
+        if (!encoder.encode(pixels.data(), pageWidth, pageHeight, encoded)) {
+            m_lastError = "Failed to encode sprite sheet page " + std::to_string(page);
+            return false;
+        }
+
+        std::string fileName = stem + "_" + std::to_string(page) + ".png";
+        std::string path = (metadataPath.parent_path() / fileName).string();
+        if (!writeFile(path, encoded)) {
+            m_lastError = "Failed to write " + path;
+            return false;
+        }
+        pageFiles.push_back(fileName);
+    }
+    return true;
+}
+
+bool SpriteSheetExporter::writeMetadata(const std::vector<std::pair<int, int>>& pageSizes, const std::vector<std::string>& pageFiles) {
+    const int fps = getFrameRate();
+    auto frameStartMs = [fps](int frame) { return (frame * 1000 + fps / 2) / fps; };
+
+    std::ostringstream json;
+    json << "{\n";
+    json << "  \"name\": \"" << escapeJson(std::filesystem::path(m_metadataPath).stem().string()) << "\",\n";
+    json << "  \"frameRate\": " << fps << ",\n";
+    json << "  \"frameSize\": { \"w\": " << getWidth() << ", \"h\": " << getHeight() << " },\n";
+
+    json << "  \"pages\": [\n";
+    for (size_t i = 0; i < pageFiles.size(); ++i) {
+        json << "    { \"file\": \"" << escapeJson(pageFiles[i]) << "\", \"w\": " << pageSizes[i].first
+             << ", \"h\": " << pageSizes[i].second << " }" << (i + 1 < pageFiles.size() ? "," : "") << "\n";
+    }
+    json << "  ],\n";
+
+    // Atlas rects; a zero-size rect is a fully transparent frame
+    json << "  \"images\": [\n";
+    for (size_t i = 0; i < m_images.size(); ++i) {
+        const SheetImage& image = m_images[i];
+        json << "    { \"page\": " << image.page << ", \"x\": " << image.x << ", \"y\": " << image.y
+             << ", \"w\": " << image.width << ", \"h\": " << image.height << " }"
+             << (i + 1 < m_images.size() ? "," : "") << "\n";
+    }
+    json << "  ],\n";
+
+    // Draw 'image' at (x, y) inside the full frame for 'duration' milliseconds
+    json << "  \"frames\": [\n";
+    for (size_t i = 0; i < m_frames.size(); ++i) {
+        const SheetFrame& frame = m_frames[i];
+        json << "    { \"image\": " << frame.image << ", \"x\": " << frame.offsetX << ", \"y\": " << frame.offsetY
+             << ", \"duration\": " << frameStartMs(frame.lastFrame + 1) - frameStartMs(frame.firstFrame) << " }"
+             << (i + 1 < m_frames.size() ? "," : "") << "\n";
+    }
+    json << "  ]\n";
+    json << "}\n";
+
+    m_file << json.str();
+    m_file.close();
+    if (m_file.fail()) {
+        m_lastError = "Failed to write " + m_metadataPath;
+        return false;
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,36 @@
+#include "Editor/Export/Y4MExporter.h"
+
+namespace Riggle {
+
+bool Y4MExporter::beginOutput(const std::string& outputPath, int /*frameCount*/) {
+    if (!openOutputFile(outputPath, m_file)) return false;
+
+    // Progressive, square pixels, chroma sited like JPEG (centred between luma samples)
+    m_file << "YUV4MPEG2 W" << getWidth() << " H" << getHeight() << " F" << getFrameRate()
+           << ":1 Ip A1:1 C420jpeg\n";
+
+    if (!m_file) {
+        m_lastError = "Failed to write " + outputPath;
+        return false;
+    }
+    return true;
+}
+
+bool Y4MExporter::encodeFrame(FrameEncoder& encoder, const sf::Image& image, std::vector<std::uint8_t>& bytes) {
+    bytes.clear();
+    encoder.convertToYUV420(image.getPixelsPtr(), image.getSize().x, image.getSize().y, bytes);
+    return true;
+}
+
+bool Y4MExporter::writeFrame(int /*frame*/, const std::vector<std::uint8_t>& bytes) {
+    m_file.write("FRAME\n", 6);
+    m_file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return static_cast<bool>(m_file);
+}
+
+bool Y4MExporter::endOutput(bool /*completed*/) {
+    m_file.close();
+    return !m_file.fail();
+}
+
+}
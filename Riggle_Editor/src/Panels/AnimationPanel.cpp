@@ -153,6 +153,23 @@ void AnimationPanel::renderAnimationControls() {
         if (ImGui::IsItemHovered()) {
             ImGui::SetTooltip("Create keyframes for all bones at current time");
         }
+        
+        // Performance capture
+        ImGui::SameLine();
+        if (ImGui::Button(m_state.isCapturing ? "Stop Capture" : "Capture")) {
+            toggleMotionCapture();
+        }
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("Play the timeline and record bone drags, keyframes are created when capture stops");
+        }
+        if (!m_state.isCapturing) {
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth(100.0f);
+            ImGui::SliderFloat("Capture Error", &m_captureSettings.positionTolerance, 0.1f, 10.0f, "%.1f px");
+        } else {
+            ImGui::SameLine();
+            ImGui::Text("%zu samples", m_character->getMotionCapture().getSampleCount());
+        }
     }
     ImGui::EndGroup();
     
@@ -323,6 +340,41 @@ void AnimationPanel::toggleRecording() {
     }
 }
 
+void AnimationPanel::toggleMotionCapture() {
+    if (!m_character || !m_character->getRig()) return;
+    
+    auto* player = m_character->getAnimationPlayer();
+    auto* currentAnim = player->getAnimation();
+    MotionCapture& capture = m_character->getMotionCapture();
+    
+    if (!m_state.isCapturing) {
+        if (!currentAnim) {
+            std::cout << "Select an animation before capturing" << std::endl;
+            return;
+        }
+        
+        // Bones follow the mouse, not the animation, while the playhead runs
+        m_character->setManualBoneEditMode(true);
+        capture.begin(*m_character->getRig());
+        m_state.isCapturing = true;
+        m_state.isPlaying = true;
+        player->play();
+        std::cout << "Motion capture started" << std::endl;
+    } else {
+        m_state.isCapturing = false;
+        m_state.isPlaying = false;
+        player->pause();
+        capture.end();
+        if (currentAnim) {
+            capture.bakeInto(*currentAnim, m_captureSettings);
+        }
+        if (!m_state.isRecording) {
+            m_character->setManualBoneEditMode(false);
+        }
+        setCurrentTime(m_state.currentTime);
+    }
+}
+
 void AnimationPanel::keyAllBones() {
     if (!m_character) return;
     
@@ -1,6 +1,9 @@
 #include "Editor/Panels/PropertyPanel.h"
+#include "Editor/Utils/AssetManager.h"
 #include <imgui.h>
+#include <SFML/Graphics/Image.hpp>
 #include <iostream>
+#include <algorithm>
 
 namespace Riggle {
 
@@ -141,6 +144,9 @@ void PropertyPanel::renderSpriteProperties() {
     
     ImGui::Separator();
     renderSpriteBindings();
+    
+    ImGui::Separator();
+    renderSpriteMeshControls();
 }
 
 void PropertyPanel::renderBoundSpriteInfo() {
@@ -232,6 +238,42 @@ void PropertyPanel::renderBoneProperties() {
     
     ImGui::Separator();
     
+    // Spring bone secondary motion (simulated on top of the animation)
+    ImGui::Text("Secondary Motion");
+    SpringBoneParams spring = m_selectedBone->getSpringParams();
+    bool springChanged = ImGui::Checkbox("Spring Bone", &spring.enabled);
+    if (spring.enabled) {
+        springChanged |= ImGui::SliderFloat("Stiffness", &spring.stiffness, 0.0f, 1.0f, "%.2f");
+        springChanged |= ImGui::SliderFloat("Damping", &spring.damping, 0.0f, 1.0f, "%.2f");
+        springChanged |= ImGui::DragFloat("Gravity", &spring.gravity, 5.0f, -2000.0f, 2000.0f, "%.0f px/s^2");
+    }
+    if (springChanged) {
+        m_selectedBone->setSpringParams(spring);
+    }
+    
+    ImGui::Separator();
+    
+    // Joint limits respected by the IK solvers
+    ImGui::Text("IK Limits");
+    BoneRotationLimits limits = m_selectedBone->getRotationLimits();
+    bool limitsChanged = ImGui::Checkbox("Limit IK Rotation", &limits.enabled);
+    if (limits.enabled) {
+        limitsChanged |= ImGui::SliderAngle("Min Rotation", &limits.minRotation, -180.0f, 180.0f);
+        limitsChanged |= ImGui::SliderAngle("Max Rotation", &limits.maxRotation, -180.0f, 180.0f);
+        limits.maxRotation = std::max(limits.minRotation, limits.maxRotation);
+    }
+    if (limitsChanged) {
+        m_selectedBone->setRotationLimits(limits);
+    }
+    
+    ImGui::Separator();
+    renderBoneIKConstraints();
+    ImGui::Separator();
+    renderBoneConstraints();
+    ImGui::Separator();
+    renderBoneProceduralChannels();
+    ImGui::Separator();
+    
     // Hierarchy info
     ImGui::Text("Hierarchy");
     if (auto parent = m_selectedBone->getParent()) {
@@ -251,6 +293,334 @@ void PropertyPanel::renderBoneProperties() {
     ImGui::Text("Hierarchy Depth: %d", depth);
 }
 
+void PropertyPanel::renderBoneConstraints() {
+    ImGui::Text("Constraints");
+    
+    Rig* rig = m_character ? m_character->getRig() : nullptr;
+    if (!rig) return;
+    
+    static const char* typeNames[] = { "Copy Rotation", "Look At", "Limit Rotation", "Parent Space" };
+    auto allBones = rig->getAllBones();
+    const std::string& boneName = m_selectedBone->getName();
+    
+    // Copy the list - edits below may reorder it
+    auto constraints = rig->getConstraints();
+    for (int i = 0; i < static_cast<int>(constraints.size()); ++i) {
+        BoneConstraint constraint = constraints[i];
+        if (constraint.boneName != boneName) continue;
+        
+        ImGui::PushID(i);
+        bool changed = ImGui::Checkbox("##Enabled", &constraint.enabled);
+        ImGui::SameLine();
+        ImGui::Text("%s", typeNames[static_cast<int>(constraint.type)]);
+        ImGui::SameLine();
+        if (ImGui::SmallButton("Remove")) {
+            rig->removeConstraint(i);
+            ImGui::PopID();
+            break;
+        }
+        
+        if (constraint.type != ConstraintType::LimitRotation) {
+            const char* preview = constraint.targetName.empty() ? "(none)" : constraint.targetName.c_str();
+            if (ImGui::BeginCombo("Target", preview)) {
+                for (const auto& bone : allBones) {
+                    if (bone == m_selectedBone) continue;
+                    if (ImGui::Selectable(bone->getName().c_str(), bone->getName() == constraint.targetName)) {
+                        constraint.targetName = bone->getName();
+                        if (constraint.type == ConstraintType::ParentSpace) {
+                            constraint.targetOffset = ConstraintSystem::captureParentSpaceOffset(*m_selectedBone, *bone);
+                        }
+                        changed = true;
+                    }
+                }
+                ImGui::EndCombo();
+            }
+        }
+        
+        changed |= ImGui::SliderFloat("Influence", &constraint.influence, 0.0f, 1.0f, "%.2f");
+        
+        if (constraint.type == ConstraintType::CopyRotation || constraint.type == ConstraintType::LookAt) {
+            changed |= ImGui::SliderAngle("Offset", &constraint.rotationOffset, -180.0f, 180.0f);
+        } else if (constraint.type == ConstraintType::LimitRotation) {
+            changed |= ImGui::SliderAngle("Min", &constraint.minRotation, -180.0f, 180.0f);
+            changed |= ImGui::SliderAngle("Max", &constraint.maxRotation, -180.0f, 180.0f);
+        } else if (constraint.type == ConstraintType::ParentSpace) {
+            auto target = rig->findBone(constraint.targetName);
+            if (target && ImGui::SmallButton("Capture Current Offset")) {
+                constraint.targetOffset = ConstraintSystem::captureParentSpaceOffset(*m_selectedBone, *target);
+                changed = true;
+            }
+        }
+        
+        if (changed) {
+            rig->setConstraint(i, constraint);
+        }
+        ImGui::PopID();
+    }
+    
+    static int newType = 0;
+    ImGui::Combo("##NewConstraintType", &newType, typeNames, IM_ARRAYSIZE(typeNames));
+    ImGui::SameLine();
+    if (ImGui::Button("Add Constraint")) {
+        BoneConstraint constraint;
+        constraint.type = static_cast<ConstraintType>(newType);
+        constraint.boneName = boneName;
+        rig->addConstraint(constraint);
+    }
+    
+    const auto& system = m_character->getConstraintSystem();
+    if (system.getDroppedConstraintCount() > 0) {
+        ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.5f, 1.0f), "%s", system.getLastError().c_str());
+    }
+}
+
+void PropertyPanel::renderBoneProceduralChannels() {
+    ImGui::Text("Procedural Channels");
+    
+    Rig* rig = m_character ? m_character->getRig() : nullptr;
+    if (!rig) return;
+    
+    static const char* generatorNames[] = { "Sine", "Noise", "Follow Through" };
+    static const char* targetNames[] = { "Position X", "Position Y", "Rotation", "Scale X", "Scale Y" };
+    auto allBones = rig->getAllBones();
+    const std::string& boneName = m_selectedBone->getName();
+    
+    // Copy the list - edits below may reorder it
+    auto channels = rig->getProceduralChannels();
+    for (int i = 0; i < static_cast<int>(channels.size()); ++i) {
+        ProceduralChannel channel = channels[i];
+        if (channel.boneName != boneName) continue;
+        
+        ImGui::PushID(2000 + i);
+        bool changed = ImGui::Checkbox("##Enabled", &channel.enabled);
+        ImGui::SameLine();
+        ImGui::Text("%s", generatorNames[static_cast<int>(channel.generator)]);
+        ImGui::SameLine();
+        if (ImGui::SmallButton("Remove")) {
+            rig->removeProceduralChannel(i);
+            ImGui::PopID();
+            break;
+        }
+        
+        int target = static_cast<int>(channel.target);
+        if (ImGui::Combo("Channel", &target, targetNames, IM_ARRAYSIZE(targetNames))) {
+            channel.target = static_cast<ProceduralTarget>(target);
+            changed = true;
+        }
+        
+        // Rotation is edited in degrees, the other channels in their own units
+        bool isRotation = channel.target == ProceduralTarget::Rotation;
+        if (channel.generator == ProceduralGenerator::FollowThrough) {
+            const char* preview = channel.sourceName.empty() ? "(parent)" : channel.sourceName.c_str();
+            if (ImGui::BeginCombo("Follow", preview)) {
+                if (ImGui::Selectable("(parent)", channel.sourceName.empty())) {
+                    channel.sourceName.clear();
+                    changed = true;
+                }
+                for (const auto& bone : allBones) {
+                    if (bone == m_selectedBone) continue;
+                    if (ImGui::Selectable(bone->getName().c_str(), bone->getName() == channel.sourceName)) {
+                        channel.sourceName = bone->getName();
+                        changed = true;
+                    }
+                }
+                ImGui::EndCombo();
+            }
+            changed |= ImGui::SliderFloat("Gain", &channel.amplitude, 0.0f, 2.0f, "%.2f");
+            changed |= ImGui::SliderFloat("Delay", &channel.delay, 0.0f, 1.0f, "%.2f s");
+        } else {
+            if (isRotation) {
+                changed |= ImGui::SliderAngle("Amplitude", &channel.amplitude, 0.0f, 90.0f);
+            } else {
+                changed |= ImGui::DragFloat("Amplitude", &channel.amplitude, 0.1f, 0.0f, 1000.0f, "%.2f");
+            }
+            changed |= ImGui::SliderFloat("Frequency", &channel.frequency, 0.01f, 10.0f, "%.2f Hz", ImGuiSliderFlags_Logarithmic);
+        }
+        
+        if (channel.generator == ProceduralGenerator::Sine) {
+            changed |= ImGui::SliderAngle("Phase", &channel.phase, -180.0f, 180.0f);
+        } else if (channel.generator == ProceduralGenerator::Noise) {
+            int seed = static_cast<int>(channel.seed);
+            if (ImGui::InputInt("Seed", &seed)) {
+                channel.seed = static_cast<unsigned int>(std::max(seed, 0));
+                changed = true;
+            }
+            changed |= ImGui::SliderInt("Octaves", &channel.octaves, 1, 8);
+        }
+        
+        if (changed) {
+            rig->setProceduralChannel(i, channel);
+        }
+        ImGui::PopID();
+    }
+    
+    static int newGenerator = 0;
+    ImGui::Combo("##NewChannelGenerator", &newGenerator, generatorNames, IM_ARRAYSIZE(generatorNames));
+    ImGui::SameLine();
+    if (ImGui::Button("Add Channel")) {
+        ProceduralChannel channel;
+        channel.generator = static_cast<ProceduralGenerator>(newGenerator);
+        channel.boneName = boneName;
+        if (channel.generator == ProceduralGenerator::FollowThrough) {
+            channel.amplitude = 1.0f;
+        }
+        rig->addProceduralChannel(channel);
+    }
+}
+
+void PropertyPanel::renderBoneIKConstraints() {
+    ImGui::Text("IK Constraints");
+    
+    Rig* rig = m_character ? m_character->getRig() : nullptr;
+    if (!rig) return;
+    
+    static const char* solverNames[] = { "CCD", "FABRIK", "DLS" };
+    static const IKSolverType solverTypes[] = { IKSolverType::CCD, IKSolverType::FABRIK, IKSolverType::DLS };
+    auto allBones = rig->getAllBones();
+    const std::string& boneName = m_selectedBone->getName();
+    
+    // Copy the list - edits below may reorder it
+    auto constraints = rig->getIKConstraints();
+    for (int i = 0; i < static_cast<int>(constraints.size()); ++i) {
+        IKConstraint constraint = constraints[i];
+        if (constraint.endEffector != boneName) continue;
+        
+        ImGui::PushID(1000 + i);
+        bool changed = ImGui::Checkbox("##Enabled", &constraint.enabled);
+        ImGui::SameLine();
+        ImGui::Text("IK (%d bones)", constraint.chainLength);
+        ImGui::SameLine();
+        if (ImGui::SmallButton("Remove")) {
+            rig->removeIKConstraint(i);
+            ImGui::PopID();
+            break;
+        }
+        
+        const char* preview = constraint.targetBone.empty() ? "(fixed point)" : constraint.targetBone.c_str();
+        if (ImGui::BeginCombo("Target", preview)) {
+            if (ImGui::Selectable("(fixed point)", constraint.targetBone.empty())) {
+                constraint.targetBone.clear();
+                changed = true;
+            }
+            for (const auto& bone : allBones) {
+                if (bone == m_selectedBone) continue;
+                if (ImGui::Selectable(bone->getName().c_str(), bone->getName() == constraint.targetBone)) {
+                    constraint.targetBone = bone->getName();
+                    changed = true;
+                }
+            }
+            ImGui::EndCombo();
+        }
+        if (constraint.targetBone.empty()) {
+            changed |= ImGui::DragFloat2("Target Point", &constraint.targetPosition.x, 1.0f, -10000.0f, 10000.0f, "%.1f");
+        }
+        
+        changed |= ImGui::SliderInt("Chain Length", &constraint.chainLength, 2, 16);
+        if (!constraint.extraEffectors.empty()) {
+            // Several effectors are always solved together with DLS
+            ImGui::TextDisabled("Solver: DLS (%zu effectors)", constraint.extraEffectors.size() + 1);
+            changed |= ImGui::SliderInt("Max Iterations", &constraint.settings.maxIterations, 1, 200);
+        } else if (constraint.chainLength == 2) {
+            static const char* bendNames[] = { "Keep Current", "Positive", "Negative" };
+            int bendIndex = constraint.settings.bendDirection > 0 ? 1 : (constraint.settings.bendDirection < 0 ? 2 : 0);
+            if (ImGui::Combo("Bend Direction", &bendIndex, bendNames, IM_ARRAYSIZE(bendNames))) {
+                constraint.settings.bendDirection = bendIndex == 1 ? 1 : (bendIndex == 2 ? -1 : 0);
+                changed = true;
+            }
+        } else {
+            int solverIndex = 0;
+            for (int s = 0; s < IM_ARRAYSIZE(solverTypes); ++s) {
+                if (solverTypes[s] == constraint.settings.type) solverIndex = s;
+            }
+            if (ImGui::Combo("Solver", &solverIndex, solverNames, IM_ARRAYSIZE(solverNames))) {
+                constraint.settings.type = solverTypes[solverIndex];
+                changed = true;
+            }
+            changed |= ImGui::SliderInt("Max Iterations", &constraint.settings.maxIterations, 1, 200);
+        }
+        
+        // Other bones pulled by the same solve, each walking up Chain Length bones
+        for (size_t e = 0; e < constraint.extraEffectors.size(); ++e) {
+            IKExtraEffector& extra = constraint.extraEffectors[e];
+            ImGui::PushID(static_cast<int>(e));
+            ImGui::Separator();
+            if (ImGui::BeginCombo("Effector", extra.endEffector.c_str())) {
+                for (const auto& bone : allBones) {
+                    if (bone == m_selectedBone) continue;
+                    if (ImGui::Selectable(bone->getName().c_str(), bone->getName() == extra.endEffector)) {
+                        extra.endEffector = bone->getName();
+                        changed = true;
+                    }
+                }
+                ImGui::EndCombo();
+            }
+            ImGui::SameLine();
+            if (ImGui::SmallButton("Remove")) {
+                constraint.extraEffectors.erase(constraint.extraEffectors.begin() + e);
+                changed = true;
+                ImGui::PopID();
+                break;
+            }
+            
+            const char* extraPreview = extra.targetBone.empty() ? "(fixed point)" : extra.targetBone.c_str();
+            if (ImGui::BeginCombo("Target", extraPreview)) {
+                if (ImGui::Selectable("(fixed point)", extra.targetBone.empty())) {
+                    extra.targetBone.clear();
+                    changed = true;
+                }
+                for (const auto& bone : allBones) {
+                    if (bone->getName() == extra.endEffector) continue;
+                    if (ImGui::Selectable(bone->getName().c_str(), bone->getName() == extra.targetBone)) {
+                        extra.targetBone = bone->getName();
+                        changed = true;
+                    }
+                }
+                ImGui::EndCombo();
+            }
+            if (extra.targetBone.empty()) {
+                changed |= ImGui::DragFloat2("Target Point", &extra.targetPosition.x, 1.0f, -10000.0f, 10000.0f, "%.1f");
+            }
+            changed |= ImGui::SliderFloat("Weight", &extra.weight, 0.0f, 2.0f, "%.2f");
+            ImGui::PopID();
+        }
+        if (constraint.extraEffectors.size() + 1 < static_cast<size_t>(IKSolver::MaxDLSEffectors) &&
+            ImGui::SmallButton("Add Effector")) {
+            // Starts on the first other bone, held where its tip is now
+            for (const auto& bone : allBones) {
+                if (bone == m_selectedBone) continue;
+                IKExtraEffector extra;
+                extra.endEffector = bone->getName();
+                float startX, startY, endX, endY;
+                bone->getWorldEndpoints(startX, startY, endX, endY);
+                extra.targetPosition = Vector2(endX, endY);
+                constraint.extraEffectors.push_back(extra);
+                changed = true;
+                break;
+            }
+        }
+        
+        if (changed) {
+            rig->setIKConstraint(i, constraint);
+        }
+        ImGui::PopID();
+    }
+    
+    if (ImGui::Button("Add IK Constraint")) {
+        IKConstraint constraint;
+        constraint.endEffector = boneName;
+        float startX, startY, endX, endY;
+        m_selectedBone->getWorldEndpoints(startX, startY, endX, endY);
+        constraint.targetPosition = Vector2(endX, endY);
+        rig->addIKConstraint(constraint);
+    }
+    
+    const auto& system = m_character->getIKConstraintSystem();
+    if (system.getActiveConstraintCount() > 0) {
+        ImGui::Text("%zu active in %d wave(s), %.3f ms", system.getActiveConstraintCount(),
+                    system.getWaveCount(), system.getLastSolveMilliseconds());
+    }
+}
+
 void PropertyPanel::renderTransformControls() {
     ImGui::Text("Transform");
     
@@ -454,6 +824,104 @@ void PropertyPanel::renderSpriteBindings() {
     ImGui::EndChild();
 }
 
+void PropertyPanel::renderSpriteMeshControls() {
+    ImGui::Text("Mesh Skinning");
+    
+    if (!m_selectedSprite) return;
+    
+    const SpriteMesh& mesh = m_selectedSprite->getMesh();
+    if (m_selectedSprite->hasMesh()) {
+        ImGui::Text("Mesh: %zu vertices, %zu triangles", mesh.getVertexCount(), mesh.getTriangleCount());
+    } else {
+        ImGui::Text("Mesh: none (drawn as quad)");
+    }
+    
+    ImGui::SetNextItemWidth(120.0f);
+    ImGui::SliderInt("Vertex Budget", &m_meshVertexBudget, 4, 128);
+    
+    if (ImGui::Button("Generate Contour Mesh")) {
+        MeshGeneratorSettings settings;
+        settings.maxVertices = m_meshVertexBudget;
+        AssetManager::generateContourMesh(m_selectedSprite, settings);
+    }
+    
+    ImGui::SetNextItemWidth(120.0f);
+    ImGui::SliderInt("Columns", &m_meshColumns, 1, 16);
+    ImGui::SetNextItemWidth(120.0f);
+    ImGui::SliderInt("Rows", &m_meshRows, 1, 16);
+    
+    if (ImGui::Button("Create Grid Mesh")) {
+        sf::Image image;
+        if (image.loadFromFile(m_selectedSprite->getTexturePath())) {
+            sf::Vector2u size = image.getSize();
+            m_selectedSprite->setMesh(SpriteMesh::createGrid(static_cast<float>(size.x), static_cast<float>(size.y),
+                                                             m_meshColumns, m_meshRows));
+            std::cout << "Created " << m_meshColumns << "x" << m_meshRows << " mesh for sprite: " << m_selectedSprite->getName() << std::endl;
+        } else {
+            std::cout << "Failed to read texture size for mesh: " << m_selectedSprite->getTexturePath() << std::endl;
+        }
+    }
+    
+    if (!m_selectedSprite->hasMesh()) return;
+    
+    ImGui::SameLine();
+    if (ImGui::Button("Remove Mesh")) {
+        m_selectedSprite->clearMesh();
+        return;
+    }
+    
+    ImGui::Spacing();
+    if (m_selectedSprite->isSkinned()) {
+        ImGui::Text("Skinned to %zu bones (%d influences per vertex)",
+                    m_selectedSprite->getSkinBones().size(), m_selectedSprite->getSkinData().influenceCount);
+        for (const auto& bone : m_selectedSprite->getSkinBones()) {
+            ImGui::BulletText("%s", bone->getName().c_str());
+        }
+        if (ImGui::Button("Clear Skin")) {
+            m_selectedSprite->clearSkin();
+        }
+        return;
+    }
+    
+    if (!m_character || !m_character->getRig()) {
+        ImGui::Text("No rig available");
+        return;
+    }
+    
+    // Pick the bones that influence this mesh
+    ImGui::Text("Skin bones:");
+    const auto& bones = m_character->getRig()->getAllBones();
+    if (ImGui::BeginChild("SkinBoneList", ImVec2(0, 120), true)) {
+        for (const auto& bone : bones) {
+            if (!bone) continue;
+            bool selected = m_skinBoneSelection.count(bone->getName()) > 0;
+            if (ImGui::Checkbox(bone->getName().c_str(), &selected)) {
+                if (selected) m_skinBoneSelection.insert(bone->getName());
+                else m_skinBoneSelection.erase(bone->getName());
+            }
+        }
+    }
+    ImGui::EndChild();
+    
+    ImGui::SetNextItemWidth(120.0f);
+    ImGui::SliderFloat("Falloff", &m_skinFalloff, 0.5f, 4.0f, "%.1f");
+    
+    if (ImGui::Button("Bind Skin (Auto Weights)")) {
+        std::vector<std::shared_ptr<Bone>> skinBones;
+        for (const auto& bone : bones) {
+            if (bone && m_skinBoneSelection.count(bone->getName())) {
+                skinBones.push_back(bone);
+            }
+        }
+        
+        if (m_selectedSprite->bindSkinAutoWeights(skinBones, m_skinFalloff)) {
+            std::cout << "Skinned sprite '" << m_selectedSprite->getName() << "' to " << skinBones.size() << " bones" << std::endl;
+        } else {
+            std::cout << "Select at least one bone to skin to" << std::endl;
+        }
+    }
+}
+
 void PropertyPanel::renderHelpDialog() {
     if (!m_showHelp) return;
     
@@ -491,6 +959,8 @@ void PropertyPanel::renderHelpDialog() {
             
             ImGui::Text("Bone Controls:");
             ImGui::BulletText("Length: Adjust the bone's length");
+            ImGui::BulletText("Spring Bone: Let the bone lag and swing behind its parent");
+            ImGui::BulletText("Constraints: Copy rotation, look at, limit rotation or follow another bone");
             ImGui::BulletText("View hierarchy and sprite bindings");
             
             ImGui::Spacing();
@@ -759,6 +1229,62 @@ void PropertyPanel::renderIKProperties() {
         
         ImGui::Spacing();
         
+        // Solver selection (two-bone chains always use the exact closed-form solver)
+        IKSolveSettings settings = m_ikTool->getSolverSettings();
+        static const char* solverNames[] = { "CCD", "FABRIK", "DLS" };
+        static const IKSolverType solverTypes[] = { IKSolverType::CCD, IKSolverType::FABRIK, IKSolverType::DLS };
+        int solverIndex = 0;
+        for (int i = 0; i < IM_ARRAYSIZE(solverTypes); ++i) {
+            if (solverTypes[i] == settings.type) solverIndex = i;
+        }
+        bool settingsChanged = false;
+        if (chainLength == 2) {
+            static const char* bendNames[] = { "Keep Current", "Positive", "Negative" };
+            int bendIndex = settings.bendDirection > 0 ? 1 : (settings.bendDirection < 0 ? 2 : 0);
+            ImGui::Text("Solver: Two-Bone (exact)");
+            if (ImGui::Combo("Bend Direction", &bendIndex, bendNames, IM_ARRAYSIZE(bendNames))) {
+                settings.bendDirection = bendIndex == 1 ? 1 : (bendIndex == 2 ? -1 : 0);
+                settingsChanged = true;
+            }
+        } else {
+            settingsChanged |= ImGui::Combo("Solver", &solverIndex, solverNames, IM_ARRAYSIZE(solverNames));
+            settingsChanged |= ImGui::SliderInt("Max Iterations", &settings.maxIterations, 1, 200);
+            settingsChanged |= ImGui::SliderFloat("Tolerance", &settings.tolerance, 0.1f, 10.0f, "%.1f px");
+            if (solverTypes[solverIndex] == IKSolverType::DLS) {
+                settingsChanged |= ImGui::SliderFloat("Damping", &settings.damping, 0.1f, 50.0f, "%.1f");
+            }
+        }
+        if (settingsChanged) {
+            if (chainLength != 2) settings.type = solverTypes[solverIndex];
+            m_ikTool->setSolverSettings(settings);
+        }
+        
+        // Drag solves stop after this long and continue on the next frame
+        float frameBudget = m_ikTool->getFrameBudget();
+        if (ImGui::SliderFloat("Frame Budget", &frameBudget, 0.5f, 16.0f, "%.1f ms")) {
+            m_ikTool->setFrameBudget(frameBudget);
+        }
+        
+        // Last solve stats, for comparing solvers on this chain
+        const IKSolveStats& stats = m_character->getIKSolver().getLastStats();
+        if (stats.chainLength > 0) {
+            ImGui::Text("Last solve (%s): %d iterations, %.3f ms, error %.2f px",
+                        IKSolver::getSolverName(stats.type), stats.iterations, stats.milliseconds, stats.error);
+        }
+        
+        // Keep this chain solved during playback
+        if (validation.isValid && m_character->getRig() && ImGui::Button("Save as IK Constraint")) {
+            IKConstraint constraint;
+            constraint.endEffector = endEffector->getName();
+            constraint.chainLength = chainLength;
+            constraint.settings = m_ikTool->getSolverSettings();
+            constraint.targetPosition = m_ikTool->isSolving() ? m_ikTool->getTargetPosition()
+                                                              : m_character->getIKSolver().getBoneWorldEndPosition(endEffector);
+            m_character->getRig()->addIKConstraint(constraint);
+        }
+        
+        ImGui::Spacing();
+        
         // Target position (when solving)
         if (m_ikTool->isSolving()) {
             auto target = m_ikTool->getTargetPosition();
@@ -45,6 +45,9 @@ void ViewportPanel::render() {
         ImGui::SameLine();
         ImGui::Checkbox("Sprites", &m_showSprites);
         
+        // Skeleton LOD preview
+        renderLODControls();
+        
         ImGui::Separator();
         
         // Calculate available space for viewport (subtract fixed UI elements)
@@ -68,6 +71,11 @@ void ViewportPanel::render() {
                 }
 
                 if (m_viewportInitialized) {
+                    // At most one IK drag solve per frame, however many mouse moves arrived
+                    if (auto* ikTool = getIKTool()) {
+                        ikTool->update();
+                    }
+                    
                     renderViewport();
 
                     // Handle interactions
@@ -146,6 +154,45 @@ void ViewportPanel::renderToolButtons() {
     }
 }
 
+void ViewportPanel::renderLODControls() {
+    if (!m_character || !m_character->getRig()) return;
+    
+    Rig* rig = m_character->getRig();
+    
+    ImGui::SameLine();
+    if (ImGui::Button("Generate LODs")) {
+        int levels = rig->generateLODLevels();
+        std::cout << "Generated " << levels << " skeleton LOD levels" << std::endl;
+    }
+    
+    if (rig->getLODLevels().empty()) return;
+    
+    ImGui::SameLine();
+    ImGui::Checkbox("Auto LOD", &m_autoLOD);
+    
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(90.0f);
+    int activeLOD = rig->getActiveLOD();
+    std::string preview = activeLOD == 0 ? "Full" : rig->getLODLevels()[activeLOD - 1].name;
+    if (m_autoLOD) ImGui::BeginDisabled();
+    if (ImGui::BeginCombo("##SkeletonLOD", preview.c_str())) {
+        if (ImGui::Selectable("Full", activeLOD == 0)) {
+            m_character->setLODLevel(0);
+        }
+        for (int i = 0; i < static_cast<int>(rig->getLODLevels().size()); ++i) {
+            if (ImGui::Selectable(rig->getLODLevels()[i].name.c_str(), activeLOD == i + 1)) {
+                m_character->setLODLevel(i + 1);
+            }
+        }
+        ImGui::EndCombo();
+    }
+    if (m_autoLOD) ImGui::EndDisabled();
+    
+    if (ImGui::IsItemHovered(ImGuiHoveredFlags_AllowWhenDisabled)) {
+        ImGui::SetTooltip("Evaluated bones: %zu", rig->getEvaluatedBoneCount());
+    }
+}
+
 void ViewportPanel::drawBoneToolOverlay() {
     // We will draw directly into the current window (the Viewport),
     // but we'll set the cursor position to create an overlay effect.
@@ -322,6 +369,11 @@ void ViewportPanel::renderScene(sf::RenderTarget& target) {
 
     // Get current zoom level
     float zoomLevel = getZoomLevel();
+    
+    // Pick the skeleton LOD for this frame from the on-screen scale
+    if (m_autoLOD) {
+        m_character->updateLODForScreenScale(zoomLevel);
+    }
 
     if (m_showSprites && m_spriteRenderer) {
         m_spriteRenderer->render(target);
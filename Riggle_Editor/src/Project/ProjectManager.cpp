@@ -290,6 +290,13 @@ bool ProjectManager::parseProjectJson(const std::string& jsonData, std::unique_p
             }
         }
         
+        // Reconstruct skeleton LOD levels
+        if (projectJson.contains("lodLevels") && projectJson["lodLevels"].is_array()) {
+            if (!reconstructLODLevels(projectJson["lodLevels"], character.get())) {
+                std::cout << "Warning: Failed to reconstruct LOD levels" << std::endl;
+            }
+        }
+        
         std::cout << "Project reconstruction completed!" << std::endl;
         return true;
         
@@ -322,6 +329,25 @@ bool ProjectManager::reconstructRig(const json& bonesJson, Character* character)
                 bone->setLocalTransform(transform);
             }
             
+            if (boneJson.contains("spring") && boneJson["spring"].is_object()) {
+                const json& springJson = boneJson["spring"];
+                SpringBoneParams spring;
+                spring.enabled = springJson.value("enabled", false);
+                spring.stiffness = springJson.value("stiffness", spring.stiffness);
+                spring.damping = springJson.value("damping", spring.damping);
+                spring.gravity = springJson.value("gravity", spring.gravity);
+                bone->setSpringParams(spring);
+            }
+            
+            if (boneJson.contains("rotationLimits") && boneJson["rotationLimits"].is_object()) {
+                const json& limitsJson = boneJson["rotationLimits"];
+                BoneRotationLimits limits;
+                limits.enabled = limitsJson.value("enabled", false);
+                limits.minRotation = limitsJson.value("min", limits.minRotation);
+                limits.maxRotation = limitsJson.value("max", limits.maxRotation);
+                bone->setRotationLimits(limits);
+            }
+            
             boneMap[name] = bone;
             std::cout << "Created bone instance: " << name << std::endl;
         }
@@ -347,6 +373,8 @@ bool ProjectManager::reconstructRig(const json& bonesJson, Character* character)
             }
         }
         
+        reconstructConstraints(bonesJson, rig.get());
+        
         character->setRig(std::move(rig));
         
         std::cout << "Rig reconstruction completed!" << std::endl;
@@ -433,6 +461,9 @@ bool ProjectManager::reconstructSprites(const json& spritesJson, Character* char
                     }
                 }
 
+                // Mesh and skin weights (optional)
+                reconstructSpriteMesh(spriteJson, sprite.get(), rig);
+
                 successCount++;
                 std::cout << "Successfully processed sprite: " << name << std::endl;
 
@@ -451,6 +482,77 @@ bool ProjectManager::reconstructSprites(const json& spritesJson, Character* char
     }
 }
 
+void ProjectManager::reconstructSpriteMesh(const json& spriteJson, Sprite* sprite, Rig* rig) {
+    if (!spriteJson.contains("mesh") || !spriteJson["mesh"].is_object()) return;
+
+    const json& meshJson = spriteJson["mesh"];
+    std::vector<float> vertices = meshJson.value("vertices", std::vector<float>());
+    std::vector<float> uvs = meshJson.value("uvs", std::vector<float>());
+
+    SpriteMesh mesh;
+    mesh.indices = meshJson.value("indices", std::vector<unsigned int>());
+    for (size_t i = 0; i + 1 < vertices.size(); i += 2) {
+        mesh.vertices.emplace_back(vertices[i], vertices[i + 1]);
+    }
+    for (size_t i = 0; i + 1 < uvs.size(); i += 2) {
+        mesh.uvs.emplace_back(uvs[i], uvs[i + 1]);
+    }
+
+    if (mesh.isEmpty() || mesh.uvs.size() != mesh.vertices.size()) return;
+    for (unsigned int index : mesh.indices) {
+        if (index >= mesh.vertices.size()) {
+            std::cout << "Warning: Invalid mesh index for sprite " << sprite->getName() << std::endl;
+            return;
+        }
+    }
+    sprite->setMesh(mesh);
+
+    if (!spriteJson.contains("skin") || !spriteJson["skin"].is_object()) return;
+
+    const json& skinJson = spriteJson["skin"];
+    std::vector<std::shared_ptr<Bone>> bones;
+    for (const auto& boneName : skinJson.value("bones", std::vector<std::string>())) {
+        auto bone = rig->findBone(boneName);
+        if (!bone) {
+            std::cout << "Warning: Skin bone not found: " << boneName << std::endl;
+            return;
+        }
+        bones.push_back(bone);
+    }
+    if (bones.empty()) return;
+
+    std::vector<Transform> bindPoses;
+    if (skinJson.contains("bindPoses") && skinJson["bindPoses"].is_array()) {
+        for (const auto& poseJson : skinJson["bindPoses"]) {
+            bindPoses.push_back(jsonToTransform(poseJson));
+        }
+    }
+
+    std::vector<Vector2> bindVertices;
+    std::vector<float> bindFlat = skinJson.value("bindVertices", std::vector<float>());
+    for (size_t i = 0; i + 1 < bindFlat.size(); i += 2) {
+        bindVertices.emplace_back(bindFlat[i], bindFlat[i + 1]);
+    }
+
+    std::vector<VertexWeights> weights;
+    std::vector<float> weightFlat = skinJson.value("weights", std::vector<float>());
+    const size_t stride = MAX_BONE_INFLUENCES * 2;
+    for (size_t i = 0; i + stride <= weightFlat.size(); i += stride) {
+        VertexWeights vw;
+        for (int k = 0; k < MAX_BONE_INFLUENCES; ++k) {
+            vw.boneIndices[k] = static_cast<int>(weightFlat[i + k * 2]);
+            vw.weights[k] = weightFlat[i + k * 2 + 1];
+        }
+        weights.push_back(vw);
+    }
+
+    if (sprite->restoreSkin(bones, bindPoses, bindVertices, weights)) {
+        std::cout << "Restored skin for sprite '" << sprite->getName() << "' (" << bones.size() << " bones)" << std::endl;
+    } else {
+        std::cout << "Warning: Invalid skin data for sprite " << sprite->getName() << std::endl;
+    }
+}
+
 bool ProjectManager::reconstructAnimations(const json& animationsJson, Character* character) {
     try {
         std::cout << "Reconstructing " << animationsJson.size() << " animations..." << std::endl;
@@ -495,6 +597,123 @@ bool ProjectManager::reconstructAnimations(const json& animationsJson, Character
     }
 }
 
+void ProjectManager::reconstructConstraints(const json& bonesJson, Rig* rig) {
+    for (const auto& boneJson : bonesJson) {
+        if (!boneJson.contains("constraints") || !boneJson["constraints"].is_array()) continue;
+        
+        for (const auto& constraintJson : boneJson["constraints"]) {
+            BoneConstraint constraint;
+            if (!constraintTypeFromString(constraintJson.value("type", ""), constraint.type)) {
+                std::cout << "Warning: Skipping unknown constraint type on bone " << boneJson.value("name", "") << std::endl;
+                continue;
+            }
+            
+            constraint.boneName = boneJson.value("name", "");
+            constraint.targetName = constraintJson.value("target", "");
+            constraint.enabled = constraintJson.value("enabled", true);
+            constraint.influence = constraintJson.value("influence", 1.0f);
+            constraint.rotationOffset = constraintJson.value("rotationOffset", 0.0f);
+            constraint.minRotation = constraintJson.value("minRotation", constraint.minRotation);
+            constraint.maxRotation = constraintJson.value("maxRotation", constraint.maxRotation);
+            if (constraintJson.contains("targetOffset")) {
+                constraint.targetOffset = jsonToTransform(constraintJson["targetOffset"]);
+            }
+            
+            rig->addConstraint(constraint);
+        }
+    }
+    
+    for (const auto& boneJson : bonesJson) {
+        if (!boneJson.contains("ikConstraints") || !boneJson["ikConstraints"].is_array()) continue;
+        
+        for (const auto& constraintJson : boneJson["ikConstraints"]) {
+            IKConstraint constraint;
+            constraint.endEffector = boneJson.value("name", "");
+            constraint.targetBone = constraintJson.value("target", "");
+            if (constraintJson.contains("targetPosition")) {
+                const auto& position = constraintJson["targetPosition"];
+                constraint.targetPosition = Vector2(position.value("x", 0.0f), position.value("y", 0.0f));
+            }
+            constraint.chainLength = constraintJson.value("chainLength", 2);
+            constraint.enabled = constraintJson.value("enabled", true);
+            if (!IKSolver::getSolverType(constraintJson.value("solver", "CCD"), constraint.settings.type)) {
+                std::cout << "Warning: Unknown IK solver on bone " << constraint.endEffector << ", using CCD" << std::endl;
+            }
+            constraint.settings.maxIterations = constraintJson.value("maxIterations", constraint.settings.maxIterations);
+            constraint.settings.tolerance = constraintJson.value("tolerance", constraint.settings.tolerance);
+            constraint.settings.bendDirection = constraintJson.value("bendDirection", constraint.settings.bendDirection);
+            constraint.settings.damping = constraintJson.value("damping", constraint.settings.damping);
+            if (constraintJson.contains("extraEffectors") && constraintJson["extraEffectors"].is_array()) {
+                for (const auto& extraJson : constraintJson["extraEffectors"]) {
+                    IKExtraEffector extra;
+                    extra.endEffector = extraJson.value("bone", "");
+                    extra.targetBone = extraJson.value("target", "");
+                    if (extraJson.contains("targetPosition")) {
+                        extra.targetPosition = jsonToVector2(extraJson["targetPosition"]);
+                    }
+                    extra.weight = extraJson.value("weight", 1.0f);
+                    constraint.extraEffectors.push_back(extra);
+                }
+            }
+            
+            rig->addIKConstraint(constraint);
+        }
+    }
+    
+    for (const auto& boneJson : bonesJson) {
+        if (!boneJson.contains("proceduralChannels") || !boneJson["proceduralChannels"].is_array()) continue;
+        
+        for (const auto& channelJson : boneJson["proceduralChannels"]) {
+            ProceduralChannel channel;
+            channel.boneName = boneJson.value("name", "");
+            if (!proceduralGeneratorFromString(channelJson.value("generator", ""), channel.generator) ||
+                !proceduralTargetFromString(channelJson.value("channel", ""), channel.target)) {
+                std::cout << "Warning: Skipping unknown procedural channel on bone " << channel.boneName << std::endl;
+                continue;
+            }
+            
+            channel.sourceName = channelJson.value("source", "");
+            channel.enabled = channelJson.value("enabled", true);
+            channel.amplitude = channelJson.value("amplitude", channel.amplitude);
+            channel.frequency = channelJson.value("frequency", channel.frequency);
+            channel.phase = channelJson.value("phase", channel.phase);
+            channel.seed = channelJson.value("seed", channel.seed);
+            channel.octaves = channelJson.value("octaves", channel.octaves);
+            channel.delay = channelJson.value("delay", channel.delay);
+            
+            rig->addProceduralChannel(channel);
+        }
+    }
+}
+
+bool ProjectManager::reconstructLODLevels(const json& lodLevelsJson, Character* character) {
+    try {
+        Rig* rig = character->getRig();
+        if (!rig) return lodLevelsJson.empty();
+        
+        for (const auto& lodJson : lodLevelsJson) {
+            SkeletonLOD lod;
+            lod.name = lodJson.value("name", "LOD");
+            lod.screenScaleThreshold = lodJson.value("screenScaleThreshold", 0.5f);
+            
+            if (lodJson.contains("collapsedBones") && lodJson["collapsedBones"].is_array()) {
+                for (const auto& boneName : lodJson["collapsedBones"]) {
+                    lod.collapsedBones.push_back(boneName.get<std::string>());
+                }
+            }
+            
+            rig->addLODLevel(lod);
+        }
+        
+        std::cout << "Reconstructed " << rig->getLODLevels().size() << " LOD levels" << std::endl;
+        return true;
+        
+    } catch (const std::exception& e) {
+        std::cout << "Error reconstructing LOD levels: " << e.what() << std::endl;
+        return false;
+    }
+}
+
 std::shared_ptr<Bone> ProjectManager::findBoneByName(Rig* rig, const std::string& name) {
     return rig ? rig->findBone(name) : nullptr;
 }
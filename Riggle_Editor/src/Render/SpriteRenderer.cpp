@@ -29,6 +29,16 @@ void SpriteRenderer::renderSprite(sf::RenderTarget& target, Sprite* sprite) {
         texture = &m_defaultTexture; // Use default if texture not found
     }
     
+    // Mesh sprites (skinned or rigid) draw through their vertex array
+    if (sprite->hasMesh()) {
+        if (sf::VertexArray* vertices = buildMeshVertices(sprite, sf::Color::White)) {
+            sf::RenderStates states;
+            states.texture = texture;
+            target.draw(*vertices, states);
+        }
+        return;
+    }
+    
     // Create sprite
     sf::Sprite sfSprite(*texture);
     
@@ -57,6 +67,28 @@ void SpriteRenderer::renderSpriteHighlight(sf::RenderTarget& target, Sprite* spr
         texture = &m_defaultTexture;
     }
     
+    // Mesh sprites: tinted mesh plus wireframe
+    if (sprite->hasMesh()) {
+        sf::VertexArray* vertices = buildMeshVertices(sprite, sf::Color(255, 100, 100, 200));
+        if (!vertices) return;
+        
+        sf::RenderStates states;
+        states.texture = texture;
+        target.draw(*vertices, states);
+        
+        sf::VertexArray wireframe(sf::PrimitiveType::Lines, vertices->getVertexCount() * 2);
+        for (size_t i = 0; i + 2 < vertices->getVertexCount(); i += 3) {
+            for (size_t e = 0; e < 3; ++e) {
+                wireframe[i * 2 + e * 2].position = (*vertices)[i + e].position;
+                wireframe[i * 2 + e * 2 + 1].position = (*vertices)[i + (e + 1) % 3].position;
+                wireframe[i * 2 + e * 2].color = sf::Color::Red;
+                wireframe[i * 2 + e * 2 + 1].color = sf::Color::Red;
+            }
+        }
+        target.draw(wireframe);
+        return;
+    }
+    
     // Create highlighted sprite
     sf::Sprite sfSprite(*texture);
     
@@ -91,6 +123,27 @@ void SpriteRenderer::renderSpriteHighlight(sf::RenderTarget& target, Sprite* spr
     target.draw(outline);
 }
 
+sf::VertexArray* SpriteRenderer::buildMeshVertices(Sprite* sprite, const sf::Color& color) {
+    if (!sprite->computeDeformedVertices(m_deformX, m_deformY)) {
+        return nullptr;
+    }
+    
+    const SpriteMesh& mesh = sprite->getMesh();
+    sf::VertexArray& vertices = m_meshArrays[sprite];
+    vertices.setPrimitiveType(sf::PrimitiveType::Triangles);
+    vertices.resize(mesh.indices.size());
+    
+    for (size_t i = 0; i < mesh.indices.size(); ++i) {
+        unsigned int index = mesh.indices[i];
+        sf::Vertex& vertex = vertices[i];
+        vertex.position = sf::Vector2f(m_deformX[index], m_deformY[index]);
+        vertex.texCoords = sf::Vector2f(mesh.uvs[index].x, mesh.uvs[index].y);
+        vertex.color = color;
+    }
+    
+    return &vertices;
+}
+
 sf::Texture* SpriteRenderer::getTexture(const std::string& path) {
     if (path.empty()) return &m_defaultTexture;
     
@@ -11,6 +11,8 @@ IKSolverTool::IKSolverTool()
     , m_chainLength(3)
     , m_targetPosition(0, 0)
     , m_isDragging(false)
+    , m_solvePending(false)
+    , m_frameBudgetMs(4.0f)
     , m_chainColor(0, 255, 255, 180)      // Cyan
     , m_endEffectorColor(255, 255, 0, 255) // Yellow
     , m_targetColor(255, 0, 0, 255)        // Red
@@ -22,6 +24,7 @@ void IKSolverTool::setActive(bool active) {
     if (!active) {
         clearEndEffector();
         m_isDragging = false;
+        endDrag();
     }
 }
 
@@ -45,6 +48,7 @@ void IKSolverTool::handleMousePressed(const sf::Vector2f& worldPos) {
         m_lastMousePos = worldPos;
         m_targetPosition = Vector2(worldPos.x, worldPos.y);
         m_state = IKToolState::Solving;
+        beginDrag();
     }
 }
 
@@ -53,8 +57,11 @@ void IKSolverTool::handleMouseMoved(const sf::Vector2f& worldPos) {
     if (!m_isActive || !m_character) return;
     
     if (m_state == IKToolState::Solving && m_isDragging) {
-        m_targetPosition = Vector2(worldPos.x, worldPos.y);
-        solveIK(m_targetPosition);
+        // Several moves can arrive per frame, update() solves once for the latest
+        if (worldPos != m_lastMousePos) {
+            m_targetPosition = Vector2(worldPos.x, worldPos.y);
+            m_solvePending = true;
+        }
         m_lastMousePos = worldPos;
     }
 }
@@ -63,9 +70,38 @@ void IKSolverTool::handleMouseReleased(const sf::Vector2f& worldPos) {
     if (!m_isActive || !m_character) return;
     
     if (m_state == IKToolState::Solving && m_isDragging) {
+        // Land on the final target before leaving the drag
+        if (m_solvePending) {
+            solveIK(m_targetPosition);
+        }
         m_isDragging = false;
         m_state = IKToolState::Configured; // Back to configured state
+        endDrag();
+    }
+}
+
+void IKSolverTool::update() {
+    if (!m_isActive || !m_character || !m_solvePending) return;
+    if (m_state != IKToolState::Solving || !m_isDragging) return;
+    
+    solveIK(m_targetPosition);
+}
+
+void IKSolverTool::beginDrag() {
+    auto validation = validateCurrentChain();
+    m_dragChain = validation.isValid ? validation.chain : std::vector<std::shared_ptr<Bone>>();
+    
+    m_warmRotations.clear();
+    for (const auto& bone : m_dragChain) {
+        m_warmRotations.push_back(bone->getLocalTransform().rotation);
     }
+    m_solvePending = true;
+}
+
+void IKSolverTool::endDrag() {
+    m_dragChain.clear();
+    m_warmRotations.clear();
+    m_solvePending = false;
 }
 
 void IKSolverTool::setEndEffector(std::shared_ptr<Bone> bone) {
@@ -132,8 +168,27 @@ std::string IKSolverTool::getStatusMessage() const {
 
 void IKSolverTool::solveIK(const Vector2& targetPos) {
     if (!m_character || !m_endEffector) return;
+    m_solvePending = false;
+    
+    if (m_dragChain.empty()) {
+        m_character->solveIK(m_endEffector, targetPos, m_chainLength, m_solverSettings);
+        return;
+    }
+    
+    // Start from the last solution rather than whatever playback left on the bones
+    IKSolveSettings settings = m_solverSettings;
+    settings.maxMilliseconds = m_frameBudgetMs;
+    bool reached = m_character->solveIKChain(m_dragChain, targetPos, settings, &m_warmRotations);
     
-    m_character->solveIK(m_endEffector, targetPos, m_chainLength);
+    for (size_t i = 0; i < m_dragChain.size(); ++i) {
+        m_warmRotations[i] = m_dragChain[i]->getLocalTransform().rotation;
+    }
+    
+    // Out of time before converging: keep refining on the next frames
+    const IKSolveStats& stats = m_character->getIKSolver().getLastStats();
+    if (!reached && m_frameBudgetMs > 0.0f && stats.milliseconds >= m_frameBudgetMs) {
+        m_solvePending = true;
+    }
 }
 
 std::shared_ptr<Bone> IKSolverTool::findBoneAtPosition(const sf::Vector2f& worldPos) {
@@ -1,4 +1,6 @@
 #include "Editor/Utils/AssetManager.h"
+#include <Riggle/Sprite.h>
+#include <SFML/Graphics/Image.hpp>
 #include <iostream>
 #include <algorithm>
 
@@ -56,4 +58,25 @@ void AssetManager::updateImageAssets() {
     }
 }
 
-} // namespace Riggle
\ No newline at end of file
+bool AssetManager::generateContourMesh(Sprite* sprite, const MeshGeneratorSettings& settings) {
+    if (!sprite) return false;
+    
+    sf::Image image;
+    if (!image.loadFromFile(sprite->getTexturePath())) {
+        std::cout << "Failed to load texture for mesh generation: " << sprite->getTexturePath() << std::endl;
+        return false;
+    }
+    
+    sf::Vector2u size = image.getSize();
+    SpriteMesh mesh = MeshGenerator::generateFromAlpha(image.getPixelsPtr(), size.x, size.y, settings);
+    if (mesh.isEmpty()) return false;
+    
+    sprite->setMesh(mesh);
+    
+    float coverage = MeshGenerator::computeCoverage(mesh, static_cast<float>(size.x), static_cast<float>(size.y));
+    std::cout << "Generated mesh for " << sprite->getName() << ": " << mesh.getVertexCount() << " vertices, "
+              << static_cast<int>(coverage * 100.0f) << "% of quad area" << std::endl;
+    return true;
+}
+
+} // namespace Riggle
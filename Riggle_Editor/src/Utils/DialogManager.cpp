@@ -343,7 +343,7 @@ void DialogManager::renderExportDialog() {
     ImGui::SetNextWindowSize(ImVec2(600, 400), ImGuiCond_FirstUseEver);
     
     if (ImGui::BeginPopupModal("Export", &m_showExportDialog, ImGuiWindowFlags_AlwaysAutoResize)) {
-        ImGui::Text("Export JSON data or PNG image sequence");
+        ImGui::Text("Export JSON data or rendered animation frames");
         ImGui::Separator();
         
         // Export type selection
@@ -351,7 +351,7 @@ void DialogManager::renderExportDialog() {
             m_exportProject = true;
         }
         ImGui::SameLine();
-        if (ImGui::RadioButton("Export PNG sequence", !m_exportProject)) {
+        if (ImGui::RadioButton("Export animation", !m_exportProject)) {
             m_exportProject = false;
         }
         
@@ -384,7 +384,7 @@ void DialogManager::renderExportDialog() {
             }
         } else {
             // Animation export options
-            ImGui::Text("PNG Sequence Export Settings:");
+            ImGui::Text("Animation Export Settings:");
             
             // Resolution presets
             static const char* resolutions[] = { "1280x720", "1920x1080", "2560x1440" };
@@ -393,8 +393,8 @@ void DialogManager::renderExportDialog() {
             if (ImGui::Combo("##Resolution", &resIdx, resolutions, IM_ARRAYSIZE(resolutions))) {
                 if (m_exportManager) {
                     auto animationExporters = m_exportManager->getAnimationExporters();
-                    if (m_selectedAnimationExporter < static_cast<int>(animationExporters.size())) {
-                        auto* pngExporter = dynamic_cast<PNGSequenceExporter*>(animationExporters[m_selectedAnimationExporter]);
+                    for (auto* exporter : animationExporters) {
+                        auto* pngExporter = dynamic_cast<PNGSequenceExporter*>(exporter);
                         if (pngExporter) pngExporter->setResolutionPreset(resIdx);
                     }
                 }
@@ -407,8 +407,8 @@ void DialogManager::renderExportDialog() {
             if (ImGui::Combo("##AspectRatio", &aspectIdx, aspectRatios, IM_ARRAYSIZE(aspectRatios))) {
                 if (m_exportManager) {
                     auto animationExporters = m_exportManager->getAnimationExporters();
-                    if (m_selectedAnimationExporter < static_cast<int>(animationExporters.size())) {
-                        auto* pngExporter = dynamic_cast<PNGSequenceExporter*>(animationExporters[m_selectedAnimationExporter]);
+                    for (auto* exporter : animationExporters) {
+                        auto* pngExporter = dynamic_cast<PNGSequenceExporter*>(exporter);
                         if (pngExporter) pngExporter->setAspectRatioIndex(aspectIdx);
                     }
                 }
@@ -424,8 +424,8 @@ void DialogManager::renderExportDialog() {
                 else if (fpsIdx == 2) fps = 60;
                 if (m_exportManager) {
                     auto animationExporters = m_exportManager->getAnimationExporters();
-                    if (m_selectedAnimationExporter < static_cast<int>(animationExporters.size())) {
-                        auto* pngExporter = dynamic_cast<PNGSequenceExporter*>(animationExporters[m_selectedAnimationExporter]);
+                    for (auto* exporter : animationExporters) {
+                        auto* pngExporter = dynamic_cast<PNGSequenceExporter*>(exporter);
                         if (pngExporter) pngExporter->setFrameRate(fps);
                     }
                 }
@@ -437,13 +437,52 @@ void DialogManager::renderExportDialog() {
             if (ImGui::SliderFloat("##Zoom", &zoom, 0.1f, 2.0f, "%.2fx")) {
                 if (m_exportManager) {
                     auto animationExporters = m_exportManager->getAnimationExporters();
-                    if (m_selectedAnimationExporter < static_cast<int>(animationExporters.size())) {
-                        auto* pngExporter = dynamic_cast<PNGSequenceExporter*>(animationExporters[m_selectedAnimationExporter]);
+                    for (auto* exporter : animationExporters) {
+                        auto* pngExporter = dynamic_cast<PNGSequenceExporter*>(exporter);
                         if (pngExporter) pngExporter->setZoom(zoom);
                     }
                 }
             }
 
+            // Crop to the animated character instead of the preset canvas
+            static bool autoCrop = false;
+            static int autoCropPadding = 8;
+            bool cropChanged = ImGui::Checkbox("Auto-Crop", &autoCrop);
+            if (autoCrop) {
+                cropChanged |= ImGui::SliderInt("Crop Padding", &autoCropPadding, 0, 64);
+            }
+            if (cropChanged && m_exportManager) {
+                auto animationExporters = m_exportManager->getAnimationExporters();
+                for (auto* exporter : animationExporters) {
+                    auto* pngExporter = dynamic_cast<PNGSequenceExporter*>(exporter);
+                    if (pngExporter) {
+                        pngExporter->setAutoCrop(autoCrop);
+                        pngExporter->setAutoCropPadding(autoCropPadding);
+                    }
+                }
+            }
+
+            // Extra sizes rendered in the same pass, each into its own folder
+            static bool outputScales[3] = { true, false, false };
+            static const float scaleValues[3] = { 1.0f, 0.5f, 0.25f };
+            ImGui::Text("Output Scales:");
+            bool scalesChanged = ImGui::Checkbox("1x", &outputScales[0]);
+            ImGui::SameLine();
+            scalesChanged |= ImGui::Checkbox("0.5x", &outputScales[1]);
+            ImGui::SameLine();
+            scalesChanged |= ImGui::Checkbox("0.25x", &outputScales[2]);
+            if (scalesChanged && m_exportManager) {
+                std::vector<float> scales;
+                for (int i = 0; i < 3; ++i) {
+                    if (outputScales[i]) scales.push_back(scaleValues[i]);
+                }
+                auto animationExporters = m_exportManager->getAnimationExporters();
+                for (auto* exporter : animationExporters) {
+                    auto* pngExporter = dynamic_cast<PNGSequenceExporter*>(exporter);
+                    if (pngExporter) pngExporter->setOutputScales(scales);
+                }
+            }
+
             // Background color picker
             static float bgColor[4] = { 1, 1, 1, 0 }; // Default transparent
             ImGui::Text("Background Color:");
@@ -456,13 +495,116 @@ void DialogManager::renderExportDialog() {
                 );
                 if (m_exportManager) {
                     auto animationExporters = m_exportManager->getAnimationExporters();
-                    if (m_selectedAnimationExporter < static_cast<int>(animationExporters.size())) {
-                        auto* pngExporter = dynamic_cast<PNGSequenceExporter*>(animationExporters[m_selectedAnimationExporter]);
+                    for (auto* exporter : animationExporters) {
+                        auto* pngExporter = dynamic_cast<PNGSequenceExporter*>(exporter);
                         if (pngExporter) pngExporter->setBackgroundColor(color);
                     }
                 }
             }
             
+            // CPU rendering works without a GPU context (build servers)
+            static const char* renderers[] = { "GPU (SFML)", "CPU (Software)" };
+            static int rendererIdx = 0;
+            static bool smoothTextures = false;
+            ImGui::Text("Renderer:");
+            bool rendererChanged = ImGui::Combo("##Renderer", &rendererIdx, renderers, IM_ARRAYSIZE(renderers));
+            rendererChanged |= ImGui::Checkbox("Smooth Textures", &smoothTextures);
+            if (rendererChanged && m_exportManager) {
+                auto animationExporters = m_exportManager->getAnimationExporters();
+                for (auto* exporter : animationExporters) {
+                    auto* pngExporter = dynamic_cast<PNGSequenceExporter*>(exporter);
+                    if (pngExporter) {
+                        pngExporter->setRenderBackend(rendererIdx == 1 ? PNGSequenceExporter::RenderBackend::Software
+                                                                       : PNGSequenceExporter::RenderBackend::SFML);
+                        pngExporter->setSmoothTextures(smoothTextures);
+                    }
+                }
+            }
+
+            // Both renderers on the first selected animation, to check they still agree
+            if (ImGui::Button("Compare Renderers") && m_exportManager && m_exportCharacter) {
+                const auto& animations = m_exportCharacter->getAnimations();
+                PNGSequenceExporter* pngExporter = nullptr;
+                for (auto* exporter : m_exportManager->getAnimationExporters()) {
+                    if (!pngExporter) pngExporter = dynamic_cast<PNGSequenceExporter*>(exporter);
+                }
+                const Animation* animation = nullptr;
+                for (size_t i = 0; i < animations.size() && i < m_exportAnimationSelections.size(); ++i) {
+                    if (m_exportAnimationSelections[i] && animations[i]) {
+                        animation = animations[i].get();
+                        break;
+                    }
+                }
+                PNGSequenceExporter::BackendComparison comparison;
+                if (!pngExporter || !animation) {
+                    m_backendComparison = "Select an animation to compare";
+                }
+                else if (m_exportManager->compareRenderBackends(*m_exportCharacter, animation->getName(), pngExporter, comparison)) {
+                    m_backendComparison = animation->getName() + ": max channel difference " +
+                        std::to_string(comparison.maxChannelDifference) + " (frame " + std::to_string(comparison.worstFrame) +
+                        "), " + std::to_string(comparison.pixelsOverTolerance) + " of " +
+                        std::to_string(comparison.totalPixels) + " pixels over " + std::to_string(comparison.tolerance);
+                }
+                else {
+                    m_backendComparison = m_exportManager->getLastError();
+                }
+            }
+            if (!m_backendComparison.empty()) {
+                ImGui::TextWrapped("%s", m_backendComparison.c_str());
+            }
+            
+            // Frame files: PNG for delivery, QOI/TGA when speed matters more than size
+            static const char* frameFormats[] = { "PNG", "QOI", "TGA" };
+            static const char* pngFilters[] = { "None", "Sub", "Up", "Paeth", "Adaptive" };
+            static int frameFormatIdx = 0;
+            static int compressionLevel = 6;
+            static int pngFilterIdx = 4;
+            ImGui::Text("Frame Format:");
+            bool encoderChanged = ImGui::Combo("##FrameFormat", &frameFormatIdx, frameFormats, IM_ARRAYSIZE(frameFormats));
+            if (frameFormatIdx == 0) {
+                encoderChanged |= ImGui::SliderInt("Compression Level", &compressionLevel, 0, 9);
+                encoderChanged |= ImGui::Combo("PNG Filter", &pngFilterIdx, pngFilters, IM_ARRAYSIZE(pngFilters));
+            }
+            if (encoderChanged && m_exportManager) {
+                auto animationExporters = m_exportManager->getAnimationExporters();
+                for (auto* exporter : animationExporters) {
+                    auto* pngExporter = dynamic_cast<PNGSequenceExporter*>(exporter);
+                    if (pngExporter) {
+                        FrameEncoderSettings settings;
+                        settings.format = static_cast<FrameFormat>(frameFormatIdx);
+                        settings.compressionLevel = compressionLevel;
+                        settings.filter = static_cast<PNGFilter>(pngFilterIdx);
+                        pngExporter->setEncoderSettings(settings);
+                    }
+                }
+            }
+            
+            // Encode on worker threads while later frames render
+            static bool pipelined = true;
+            if (ImGui::Checkbox("Parallel Encoding", &pipelined)) {
+                if (m_exportManager) {
+                    auto animationExporters = m_exportManager->getAnimationExporters();
+                    for (auto* exporter : animationExporters) {
+                        auto* pngExporter = dynamic_cast<PNGSequenceExporter*>(exporter);
+                        if (pngExporter) pngExporter->setPipelined(pipelined);
+                    }
+                }
+            }
+
+            // Frames whose pose didn't change since an earlier export come from disk
+            static bool frameCache = true;
+            if (ImGui::Checkbox("Reuse Cached Frames", &frameCache)) {
+                if (m_exportManager) {
+                    auto animationExporters = m_exportManager->getAnimationExporters();
+                    for (auto* exporter : animationExporters) {
+                        auto* pngExporter = dynamic_cast<PNGSequenceExporter*>(exporter);
+                        if (pngExporter) {
+                            pngExporter->setFrameCacheDirectory(frameCache ? PNGSequenceExporter::getDefaultFrameCacheDirectory() : "");
+                        }
+                    }
+                }
+            }
+            
             // Show animations to select
             if (m_exportCharacter) {
                 const auto& animations = m_exportCharacter->getAnimations();
@@ -549,15 +691,8 @@ void DialogManager::renderExportDialog() {
                     performExport();
                 }
             } else {
-                // PNG sequence: directory dialog logic
-                bool isDirectory = false;
-                if (m_exportManager) {
-                    auto animationExporters = m_exportManager->getAnimationExporters();
-                    if (m_selectedAnimationExporter < static_cast<int>(animationExporters.size())) {
-                        isDirectory = animationExporters[m_selectedAnimationExporter]->getFileExtension().empty();
-                    }
-                }
-                if (openFileDialog(selectedPath, isDirectory)) {
+                // Animations: pick the directory that receives one folder or file per animation
+                if (openFileDialog(selectedPath, true)) {
                     strncpy(m_outputPath, selectedPath.c_str(), sizeof(m_outputPath) - 1);
                     m_outputPath[sizeof(m_outputPath) - 1] = '\0';
                 }
@@ -689,10 +824,11 @@ void DialogManager::performExport() {
                 for (size_t i = 0; i < m_exportAnimationSelections.size(); ++i) {
                     if (m_exportAnimationSelections[i] && animations[i]) {
                         std::string animName = animations[i]->getName();
-                        std::string animationFolder = std::string(m_outputPath) + "/" + animName;
-                        bool ok = m_exportManager->exportAnimation(*m_exportCharacter, animName, exporter, animationFolder);
+                        // A folder per animation for sequences, a file per animation otherwise
+                        std::string animationPath = std::string(m_outputPath) + "/" + animName + exporter->getFileExtension();
+                        bool ok = m_exportManager->exportAnimation(*m_exportCharacter, animName, exporter, animationPath);
                         if (ok) {
-                            std::cout << "Animation exported successfully to: " << animationFolder << std::endl;
+                            std::cout << "Animation exported successfully to: " << animationPath << std::endl;
                             anyExported = true;
                         } else {
                             m_lastExportError += m_exportManager->getLastError() + "\n";